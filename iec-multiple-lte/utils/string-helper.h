@@ -1,12 +0,0 @@
-#ifndef STRING_HELPER_H_
-#define STRING_HELPER_H_
-
-#include <string>
-#include <sstream>
-
-class StringHelper {
-public:
-     static std::string toString(double const& value);
-};
-
-#endif /* STRING_HELPER_H_ */
@@ -0,0 +1,701 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**  Brief All models for the usage of IEC61850 in one program.
++    The topology (P2P, star, tree, LTE variants or template) is selected at
++    runtime, setup, tracing, config and the installation of the DCE
++    applications are shared by all topologies.
++
++    @author David Mittelstädt
+*/
+
+#include "ns3/core-module.h"
+#include "ns3/dce-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/netanim-module.h"
+#include "scenario/scenario.h"
+#include "utils/string-helper.h"
+#include "utils/stack-helper.h"
+#include "utils/activation-helper.h"
+#include "utils/accounting-helper.h"
+#include "utils/output-helper.h"
+#include "utils/goose-helper.h"
+#include "utils/sv-helper.h"
+#include "utils/report-helper.h"
+#include "utils/arrival-helper.h"
+#include "utils/poll-probe.h"
+#include "utils/file-transfer-helper.h"
+#include "utils/background-helper.h"
+#include "ns3/config-store.h"
+
+#include <string>
+#include <sstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+// ===========================================================================
+//
+// Topologies : simple-p2p, simple-star, generic-star, simple-tree, template,
+//              simple-lte, generic-lte, multiple-lte, mixed-lte, cellular-lte,
+//              file, scd, prp, hsr
+//
+// Usage : dce-iec-scenarios --Topology=generic-star --nSpokes=20
+//
+// Note : Tested with libIEC61850, simple_iec_server and simple_iec_client.
+//        The libIEC61850 applications are written by David Mittelstaedt.
+// ===========================================================================
+
+NS_LOG_COMPONENT_DEFINE ("Scenarios");
+
+/**
+* Function to get the topology from the arguments before they are parsed,
+* the scenario sets the defaults of the other arguments.
+* @param argc Number of arguments
+* @param argv Content of the arguments
+* @return Name of the topology
+*/
+static string findTopology (int argc, char *argv[])
+{
+     string topology = "generic-star";
+     string option = "--Topology=";
+     for (int i = 1; i < argc; ++i) {
+          string argument = argv[i];
+          if (argument.compare (0, option.size (), option) == 0) {
+               topology = argument.substr (option.size ());
+          }
+     }
+     return topology;
+}
+
+/**
+* Main function.
+* Starts the simulation.
+* @param argc Number of arguments
+* @param argv Content of the arguments
+* @return Exit status of the application
+*/
+int main (int argc, char *argv[])
+{
+     // selecting the scenario
+     string topology = findTopology (argc, argv);
+     Scenario* scenario = Scenario::create (topology);
+     if (scenario == 0) {
+          cerr << "Unknown topology " << topology << ", available:" << endl;
+          vector<string> names = Scenario::getNames ();
+          for (size_t i = 0; i < names.size (); ++i) {
+               Scenario* known = Scenario::create (names[i]);
+               cerr << "  " << names[i] << " - " << known->getDescription () << endl;
+               delete known;
+          }
+          return 1;
+     }
+
+     // variables for the simulation parameters
+     ScenarioConfig config;
+     scenario->setDefaults (config);
+     string protocol = "iec61850";
+     string configFileIn = "";
+     string configFileOut = "";
+     bool lazyServers = false;
+     bool accounting = false;
+     string accountingCsv = "";
+     string outputMode = "files";
+     uint32_t outputRingSize = 4096;
+     double outputTrimInterval = 10.0;
+     string outputLog = "";
+     bool outputDump = false;
+     string stackMode = "fixed";
+     string stackProfile = "";
+     bool goose = false;
+     string gooseTransport = "udp";
+     double gooseEventRate = 1.0;
+     double gooseMinTime = 2.0;
+     double gooseMaxTime = 1000.0;
+     uint32_t gooseSize = 160;
+     string gooseCsv = "";
+     bool sampledValues = false;
+     uint32_t svStreams = 0;
+     uint32_t svRate = 4000;
+     uint32_t svAsdus = 1;
+     string svTransport = "udp";
+     string svCsv = "";
+     bool polling = true;
+     bool reports = false;
+     double reportChangeRate = 1.0;
+     uint32_t reportDataPoints = 50;
+     double reportBufferTime = 100.0;
+     double reportIntegrity = 10.0;
+     bool reportBuffered = true;
+     double reportDisturbanceStart = 0.0;
+     double reportDisturbanceDuration = 0.0;
+     double reportDisturbanceFactor = 100.0;
+     string reportCsv = "";
+     bool fileTransfer = false;
+     uint32_t fileTransferSize = 1000000;
+     double fileTransferInterval = 10.0;
+     string background = "";
+     uint32_t backgroundAggregate = 64000;
+     double backgroundOnTime = 100.0;
+     double backgroundOffTime = 100.0;
+     string serverArrival = "fixed";
+     double serverArrivalWindow = 0.0;
+     string clientArrival = "fixed";
+     double clientArrivalWindow = 0.0;
+     double reconnectTime = 0.0;
+     double reconnectOutage = 1.0;
+     string reconnectArrival = "fixed";
+     double reconnectWindow = 0.0;
+     bool pollProbe = false;
+     double pollCycle = 1.0;
+     uint32_t pollRequestSize = 100;
+     uint32_t pollResponseSize = 1000;
+     string kpiFile = "";
+
+     // parsing arguments given from the command line
+     CommandLine cmd;
+     cmd.AddValue ("Topology", "Topology of the scenario", topology);
+     cmd.AddValue ("ScenarioFile", "Scenario file of the file topology", config.scenarioFile);
+     cmd.AddValue ("SclFile", "SCL/SCD file of the scd topology", config.sclFile);
+     cmd.AddValue ("SclClient", "IED of the SCL file running the client, default is an extra node", config.sclClient);
+     cmd.AddValue ("ConfigFileIn", "Input config file", configFileIn);
+     cmd.AddValue ("ConfigFileOut", "Output config file", configFileOut);
+     cmd.AddValue ("Server", "Binary of the IEC61850 server", config.server);
+     cmd.AddValue ("Client", "Binary of the IEC61850 client", config.client);
+     cmd.AddValue ("DataRate", "Datarate of the connection", config.dataRate);
+     cmd.AddValue ("Delay", "Delay of the connection", config.delay);
+     cmd.AddValue ("PcapTracing", "Tracing with pcap files", config.pcapTracing);
+     cmd.AddValue ("AsciiTracing", "Tracing with ASCII files", config.asciiTracing);
+     cmd.AddValue ("AnimTracing", "Tracing with anim files", config.animTracing);
+     cmd.AddValue ("LteTracing", "Tracing with LTE files", config.lteTracing);
+     cmd.AddValue ("Duration", "Duration of the simulation in sec", config.duration);
+     cmd.AddValue ("FilePrefix", "Prefix of the trace files", config.filePrefix);
+     cmd.AddValue ("nSpokes", "Number of nodes to place in the star", config.nSpokes);
+     cmd.AddValue ("StarHub", "Hub of the star topologies (router, switch)", config.starHub);
+     cmd.AddValue ("SwitchPortRate", "Data rate of the station ports of the switch, default is DataRate", config.switchPortRate);
+     cmd.AddValue ("SwitchUplinkRate", "Data rate of the switch port of the client, default is SwitchPortRate", config.switchUplinkRate);
+     cmd.AddValue ("SwitchQueueSize", "Frames of each priority queue of a switch port", config.switchQueueSize);
+     cmd.AddValue ("nUEs", "Number of UEs", config.nUes);
+     cmd.AddValue ("nEnbs", "Number of eNBs of the cellular LTE topology", config.nEnbs);
+     cmd.AddValue ("LteGateways", "Regional gateway links of the LTE topologies, each with its own control center host", config.lteGateways);
+     cmd.AddValue ("LteLayout", "Site layout of the eNBs (hex, grid)", config.lteLayout);
+     cmd.AddValue ("LteSiteDistance", "Distance between neighbouring eNB sites in m", config.lteSiteDistance);
+     cmd.AddValue ("UePlacement", "Placement of the UEs (cell, uniform, file)", config.uePlacement);
+     cmd.AddValue ("UePositions", "File with \"x y\" UE positions in m for the file placement", config.uePositions);
+     cmd.AddValue ("LteBandwidth", "Bandwidth of the LTE cells in resource blocks (6, 15, 25, 50, 75, 100)", config.lteBandwidth);
+     cmd.AddValue ("LteScheduler", "MAC scheduler of the LTE cells (pf, rr, pss, tdmt, cqa, deadline or a TypeId)", config.lteScheduler);
+     cmd.AddValue ("LteDeadlines", "Uplink deadlines of the deadline scheduler as \"qci=ms,...\"", config.lteDeadlines);
+     cmd.AddValue ("LteSpsPeriod", "Period in ms of the semi-persistent uplink grants of the deadline scheduler, 0 disables", config.lteSpsPeriod);
+     cmd.AddValue ("LteSpsRbs", "RBs of a semi-persistent uplink grant", config.lteSpsRbs);
+     cmd.AddValue ("LteGrantFile", "Write the uplink grant counters of the deadline scheduler as name=value lines", config.lteGrantFile);
+     cmd.AddValue ("LtePathloss", "Pathloss model of the LTE cells (TypeId)", config.ltePathloss);
+     cmd.AddValue ("LteInterferenceCutoff", "Distance in m beyond which LTE signals are ignored, 0 disables", config.lteCutoff);
+     cmd.AddValue ("LteModel", "LTE model of the LTE topologies (full, trace)", config.lteModel);
+     cmd.AddValue ("LteTrace", "Delay, rate and loss samples of the trace LTE model", config.lteTrace);
+     cmd.AddValue ("LteDelayCsv", "Write the UE to PGW delays of the full LTE model as CSV", config.lteDelayCsv);
+     cmd.AddValue ("LteBearers", "Dedicated bearers of the traffic classes as \"class=qci[:kbps],...\" (mms, reports, goose, file)", config.lteBearers);
+     cmd.AddValue ("LteBearerKpiFile", "Write the delay, loss and throughput per traffic class as name=value lines", config.lteBearerKpiFile);
+     cmd.AddValue ("LinkQueue", "Queue discs of the star, tree and mixed links marking the traffic classes (fifo, prio, wrr), empty keeps the defaults", config.linkQueue);
+     cmd.AddValue ("LinkDscp", "DSCP of the traffic classes as \"class=dscp,...\" (mms, reports, goose, file, other)", config.linkDscp);
+     cmd.AddValue ("LinkWeights", "Weights of the four bands of the wrr link queues", config.linkWeights);
+     cmd.AddValue ("LinkQueueKpiFile", "Write the queueing delay and drops per traffic class as name=value lines", config.linkQueueKpiFile);
+     cmd.AddValue ("Redundancy", "Send every frame over both ports of the PRP and HSR nodes, otherwise only over port A", config.redundancy);
+     cmd.AddValue ("LinkFailures", "Link failures of the PRP and HSR topologies as \"link:start:duration,...\" in s (links a<i>, b<i>, r<i>)", config.linkFailures);
+     cmd.AddValue ("RedundancyKpiFile", "Write the loss and latency without and during link failures as name=value lines", config.redundancyKpiFile);
+     cmd.AddValue ("LazyServers", "Launch a server on the first connection request", lazyServers);
+     cmd.AddValue ("Accounting", "Print CPU time and events per node and core", accounting);
+     cmd.AddValue ("AccountingCsv", "Export the accounting as CSV file", accountingCsv);
+     cmd.AddValue ("OutputMode", "Output of the DCE processes (files, ring, log)", outputMode);
+     cmd.AddValue ("OutputRingSize", "Bytes kept per process output in ring mode, older output is released every trim interval", outputRingSize);
+     cmd.AddValue ("OutputTrimInterval", "Simulated time in s between two releases of older output in ring mode, 0 keeps all output until the end", outputTrimInterval);
+     cmd.AddValue ("OutputLog", "Consolidated log file in log mode", outputLog);
+     cmd.AddValue ("OutputDump", "Print the outputs of all processes in ring mode", outputDump);
+     cmd.AddValue ("StackMode", "Stack sizing of the DCE processes (fixed, measure, profile)", stackMode);
+     cmd.AddValue ("StackProfile", "Stack profile, read in profile mode and written in measure mode", stackProfile);
+     cmd.AddValue ("Goose", "GOOSE publishers and subscribers on the server nodes", goose);
+     cmd.AddValue ("GooseTransport", "Transport of GOOSE (udp, ethernet)", gooseTransport);
+     cmd.AddValue ("GooseEventRate", "Mean GOOSE state changes per second and publisher", gooseEventRate);
+     cmd.AddValue ("GooseMinTime", "First GOOSE repetition after a state change in ms", gooseMinTime);
+     cmd.AddValue ("GooseMaxTime", "GOOSE heartbeat interval in ms", gooseMaxTime);
+     cmd.AddValue ("GooseSize", "Size of the GOOSE PDU in bytes", gooseSize);
+     cmd.AddValue ("GooseCsv", "Export the GOOSE transfer time histograms as CSV file", gooseCsv);
+     cmd.AddValue ("SampledValues", "Sampled values streams from the server to the client nodes", sampledValues);
+     cmd.AddValue ("SvStreams", "Number of sampled values streams, 0 is one per server node", svStreams);
+     cmd.AddValue ("SvRate", "Samples per second and stream", svRate);
+     cmd.AddValue ("SvAsdus", "Samples (ASDUs) per sampled values frame", svAsdus);
+     cmd.AddValue ("SvTransport", "Transport of sampled values (udp, ethernet)", svTransport);
+     cmd.AddValue ("SvCsv", "Export the sampled values latency histograms as CSV file", svCsv);
+     cmd.AddValue ("Polling", "Launch the clients polling the servers", polling);
+     cmd.AddValue ("Reports", "Report-driven traffic from the server to the client nodes", reports);
+     cmd.AddValue ("ReportChangeRate", "Mean data changes per second and server", reportChangeRate);
+     cmd.AddValue ("ReportDataPoints", "Data points in the data set of a server", reportDataPoints);
+     cmd.AddValue ("ReportBufferTime", "Buffer time of the report control blocks in ms", reportBufferTime);
+     cmd.AddValue ("ReportIntegrity", "Integrity period in sec, 0 disables integrity reports", reportIntegrity);
+     cmd.AddValue ("ReportBuffered", "Buffered (BRCB) or unbuffered (URCB) reports", reportBuffered);
+     cmd.AddValue ("ReportDisturbanceStart", "Start of the disturbance in sec", reportDisturbanceStart);
+     cmd.AddValue ("ReportDisturbanceDuration", "Duration of the disturbance in sec, 0 disables it", reportDisturbanceDuration);
+     cmd.AddValue ("ReportDisturbanceFactor", "Change rate multiplier during the disturbance", reportDisturbanceFactor);
+     cmd.AddValue ("ReportCsv", "Export the report delay histograms as CSV file", reportCsv);
+     cmd.AddValue ("FileTransfer", "Bulk file transfers from the server nodes to the first client node", fileTransfer);
+     cmd.AddValue ("FileTransferSize", "Bytes of a file, 0 sends continuously", fileTransferSize);
+     cmd.AddValue ("FileTransferInterval", "Interval of the files of a server in sec, 0 sends one file", fileTransferInterval);
+     cmd.AddValue ("Background", "Background traffic as \"target:model:value,...\" (links, link<a>-<b>, ues, ue<i>; onoff, pareto, video with a rate, bulk with flows)", background);
+     cmd.AddValue ("BackgroundAggregate", "Bytes of background traffic handed to a device per source event, sent as packets of its MTU", backgroundAggregate);
+     cmd.AddValue ("BackgroundOnTime", "Mean burst duration of the background traffic in ms", backgroundOnTime);
+     cmd.AddValue ("BackgroundOffTime", "Mean pause between the background bursts in ms", backgroundOffTime);
+     cmd.AddValue ("ServerArrival", "Start pattern of the servers (fixed, staggered, uniform, poisson, ramp)", serverArrival);
+     cmd.AddValue ("ServerArrivalWindow", "Window of the server start pattern in sec", serverArrivalWindow);
+     cmd.AddValue ("ClientArrival", "Start pattern of the clients (fixed, staggered, uniform, poisson, ramp)", clientArrival);
+     cmd.AddValue ("ClientArrivalWindow", "Window of the client start pattern in sec", clientArrivalWindow);
+     cmd.AddValue ("ReconnectTime", "Time of an outage killing all clients in sec, 0 disables it", reconnectTime);
+     cmd.AddValue ("ReconnectOutage", "Duration of the outage in sec", reconnectOutage);
+     cmd.AddValue ("ReconnectArrival", "Restart pattern of the clients after the outage, fixed is a reconnection storm", reconnectArrival);
+     cmd.AddValue ("ReconnectWindow", "Window of the restart pattern in sec", reconnectWindow);
+     cmd.AddValue ("PollProbe", "Measure the completion times of polls from the client to the server nodes", pollProbe);
+     cmd.AddValue ("PollCycle", "Poll cycle of the probe in sec, also the deadline of a poll", pollCycle);
+     cmd.AddValue ("PollRequestSize", "Bytes of a probe request", pollRequestSize);
+     cmd.AddValue ("PollResponseSize", "Bytes of a probe response", pollResponseSize);
+     cmd.AddValue ("KpiFile", "Write the KPIs of the poll probe as name=value lines", kpiFile);
+     cmd.Parse (argc, argv);
+     if (outputLog.empty()) {
+          outputLog = config.filePrefix + "-output.log";
+     }
+
+     NS_LOG_INFO ("Reading Input.");
+
+     // enabling input config
+     if (! configFileIn.empty()) {
+          Config::SetDefault ("ns3::ConfigStore::Filename", StringValue (configFileIn));
+          Config::SetDefault ("ns3::ConfigStore::Mode", StringValue ("Load"));
+          Config::SetDefault ("ns3::ConfigStore::FileFormat", StringValue ("RawText"));
+          ConfigStore inputConfig;
+          inputConfig.ConfigureDefaults ();
+     }
+
+     // logging simulation parameters
+     NS_LOG_INFO ("Topology: " + topology);
+     NS_LOG_INFO ("ScenarioFile: " + config.scenarioFile);
+     NS_LOG_INFO ("SclFile: " + config.sclFile);
+     NS_LOG_INFO ("SclClient: " + config.sclClient);
+     NS_LOG_INFO ("ConfigFileIn: " + configFileIn);
+     NS_LOG_INFO ("ConfigFileOut: " + configFileOut);
+     NS_LOG_INFO ("Protocol: " + protocol);
+     NS_LOG_INFO ("Server: " + config.server);
+     NS_LOG_INFO ("Client: " + config.client);
+     NS_LOG_INFO ("DataRate: " + config.dataRate);
+     NS_LOG_INFO ("Delay: " + config.delay);
+     if (config.pcapTracing) {
+          NS_LOG_INFO ("PcapTracing: true");
+     } else {
+          NS_LOG_INFO ("PcapTracing: false");
+     }
+     if (config.asciiTracing) {
+          NS_LOG_INFO ("AsciiTracing: true");
+     } else {
+          NS_LOG_INFO ("AsciiTracing: false");
+     }
+     if (config.animTracing) {
+          NS_LOG_INFO ("AnimTracing: true");
+     } else {
+          NS_LOG_INFO ("AnimTracing: false");
+     }
+     if (config.lteTracing) {
+          NS_LOG_INFO ("LteTracing: true");
+     } else {
+          NS_LOG_INFO ("LteTracing: false");
+     }
+     NS_LOG_INFO ("Duration: " + StringHelper::toString(config.duration) + " sec");
+     NS_LOG_INFO ("nSpokes: " + StringHelper::toString(config.nSpokes));
+     NS_LOG_INFO ("StarHub: " + config.starHub);
+     NS_LOG_INFO ("SwitchPortRate: " + config.switchPortRate);
+     NS_LOG_INFO ("SwitchUplinkRate: " + config.switchUplinkRate);
+     NS_LOG_INFO ("SwitchQueueSize: " + StringHelper::toString(config.switchQueueSize));
+     NS_LOG_INFO ("nUEs: " + StringHelper::toString(config.nUes));
+     NS_LOG_INFO ("nEnbs: " + StringHelper::toString(config.nEnbs));
+     NS_LOG_INFO ("LteGateways: " + StringHelper::toString(config.lteGateways));
+     NS_LOG_INFO ("LteLayout: " + config.lteLayout);
+     NS_LOG_INFO ("LteSiteDistance: " + StringHelper::toString(config.lteSiteDistance));
+     NS_LOG_INFO ("UePlacement: " + config.uePlacement);
+     NS_LOG_INFO ("UePositions: " + config.uePositions);
+     NS_LOG_INFO ("LteBandwidth: " + StringHelper::toString(config.lteBandwidth));
+     NS_LOG_INFO ("LteScheduler: " + config.lteScheduler);
+     NS_LOG_INFO ("LteDeadlines: " + config.lteDeadlines);
+     NS_LOG_INFO ("LteSpsPeriod: " + StringHelper::toString(config.lteSpsPeriod));
+     NS_LOG_INFO ("LteSpsRbs: " + StringHelper::toString(config.lteSpsRbs));
+     NS_LOG_INFO ("LteGrantFile: " + config.lteGrantFile);
+     NS_LOG_INFO ("LtePathloss: " + config.ltePathloss);
+     NS_LOG_INFO ("LteInterferenceCutoff: " + StringHelper::toString(config.lteCutoff));
+     NS_LOG_INFO ("LteModel: " + config.lteModel);
+     NS_LOG_INFO ("LteTrace: " + config.lteTrace);
+     NS_LOG_INFO ("LteDelayCsv: " + config.lteDelayCsv);
+     NS_LOG_INFO ("LteBearers: " + config.lteBearers);
+     NS_LOG_INFO ("LteBearerKpiFile: " + config.lteBearerKpiFile);
+     NS_LOG_INFO ("LinkQueue: " + config.linkQueue);
+     NS_LOG_INFO ("LinkDscp: " + config.linkDscp);
+     NS_LOG_INFO ("LinkWeights: " + config.linkWeights);
+     NS_LOG_INFO ("LinkQueueKpiFile: " + config.linkQueueKpiFile);
+     if (config.redundancy) {
+          NS_LOG_INFO ("Redundancy: true");
+     } else {
+          NS_LOG_INFO ("Redundancy: false");
+     }
+     NS_LOG_INFO ("LinkFailures: " + config.linkFailures);
+     NS_LOG_INFO ("RedundancyKpiFile: " + config.redundancyKpiFile);
+     if (lazyServers) {
+          NS_LOG_INFO ("LazyServers: true");
+     } else {
+          NS_LOG_INFO ("LazyServers: false");
+     }
+     if (accounting) {
+          NS_LOG_INFO ("Accounting: true");
+     } else {
+          NS_LOG_INFO ("Accounting: false");
+     }
+     NS_LOG_INFO ("AccountingCsv: " + accountingCsv);
+     NS_LOG_INFO ("OutputMode: " + outputMode);
+     NS_LOG_INFO ("OutputTrimInterval: " + StringHelper::toString(outputTrimInterval) + " s");
+     NS_LOG_INFO ("StackMode: " + stackMode);
+     NS_LOG_INFO ("StackProfile: " + stackProfile);
+     if (goose) {
+          NS_LOG_INFO ("Goose: true");
+     } else {
+          NS_LOG_INFO ("Goose: false");
+     }
+     NS_LOG_INFO ("GooseTransport: " + gooseTransport);
+     NS_LOG_INFO ("GooseEventRate: " + StringHelper::toString(gooseEventRate));
+     NS_LOG_INFO ("GooseMinTime: " + StringHelper::toString(gooseMinTime) + " ms");
+     NS_LOG_INFO ("GooseMaxTime: " + StringHelper::toString(gooseMaxTime) + " ms");
+     NS_LOG_INFO ("GooseSize: " + StringHelper::toString(gooseSize));
+     if (sampledValues) {
+          NS_LOG_INFO ("SampledValues: true");
+     } else {
+          NS_LOG_INFO ("SampledValues: false");
+     }
+     NS_LOG_INFO ("SvStreams: " + StringHelper::toString(svStreams));
+     NS_LOG_INFO ("SvRate: " + StringHelper::toString(svRate));
+     NS_LOG_INFO ("SvAsdus: " + StringHelper::toString(svAsdus));
+     NS_LOG_INFO ("SvTransport: " + svTransport);
+     if (polling) {
+          NS_LOG_INFO ("Polling: true");
+     } else {
+          NS_LOG_INFO ("Polling: false");
+     }
+     if (reports) {
+          NS_LOG_INFO ("Reports: true");
+     } else {
+          NS_LOG_INFO ("Reports: false");
+     }
+     NS_LOG_INFO ("ReportChangeRate: " + StringHelper::toString(reportChangeRate));
+     NS_LOG_INFO ("ReportDataPoints: " + StringHelper::toString(reportDataPoints));
+     NS_LOG_INFO ("ReportBufferTime: " + StringHelper::toString(reportBufferTime) + " ms");
+     NS_LOG_INFO ("ReportIntegrity: " + StringHelper::toString(reportIntegrity) + " s");
+     if (reportBuffered) {
+          NS_LOG_INFO ("ReportBuffered: true");
+     } else {
+          NS_LOG_INFO ("ReportBuffered: false");
+     }
+     NS_LOG_INFO ("ReportDisturbanceStart: " + StringHelper::toString(reportDisturbanceStart) + " s");
+     NS_LOG_INFO ("ReportDisturbanceDuration: " + StringHelper::toString(reportDisturbanceDuration) + " s");
+     NS_LOG_INFO ("ReportDisturbanceFactor: " + StringHelper::toString(reportDisturbanceFactor));
+     if (fileTransfer) {
+          NS_LOG_INFO ("FileTransfer: true");
+     } else {
+          NS_LOG_INFO ("FileTransfer: false");
+     }
+     NS_LOG_INFO ("FileTransferSize: " + StringHelper::toString(fileTransferSize));
+     NS_LOG_INFO ("FileTransferInterval: " + StringHelper::toString(fileTransferInterval) + " s");
+     NS_LOG_INFO ("Background: " + background);
+     NS_LOG_INFO ("BackgroundAggregate: " + StringHelper::toString(backgroundAggregate));
+     NS_LOG_INFO ("BackgroundOnTime: " + StringHelper::toString(backgroundOnTime) + " ms");
+     NS_LOG_INFO ("BackgroundOffTime: " + StringHelper::toString(backgroundOffTime) + " ms");
+     NS_LOG_INFO ("ServerArrival: " + serverArrival);
+     NS_LOG_INFO ("ServerArrivalWindow: " + StringHelper::toString(serverArrivalWindow) + " s");
+     NS_LOG_INFO ("ClientArrival: " + clientArrival);
+     NS_LOG_INFO ("ClientArrivalWindow: " + StringHelper::toString(clientArrivalWindow) + " s");
+     NS_LOG_INFO ("ReconnectTime: " + StringHelper::toString(reconnectTime) + " s");
+     NS_LOG_INFO ("ReconnectOutage: " + StringHelper::toString(reconnectOutage) + " s");
+     NS_LOG_INFO ("ReconnectArrival: " + reconnectArrival);
+     NS_LOG_INFO ("ReconnectWindow: " + StringHelper::toString(reconnectWindow) + " s");
+     if (pollProbe) {
+          NS_LOG_INFO ("PollProbe: true");
+     } else {
+          NS_LOG_INFO ("PollProbe: false");
+     }
+     NS_LOG_INFO ("PollCycle: " + StringHelper::toString(pollCycle) + " s");
+     NS_LOG_INFO ("PollRequestSize: " + StringHelper::toString(pollRequestSize));
+     NS_LOG_INFO ("PollResponseSize: " + StringHelper::toString(pollResponseSize));
+     NS_LOG_INFO ("KpiFile: " + kpiFile);
+
+     // accounting CPU time and events per node and simulator core
+     AccountingHelper accountingHelper;
+     if (accounting || ! accountingCsv.empty()) {
+          accountingHelper.enable ();
+     }
+
+     // building the topology
+     scenario->build (config);
+
+     // naming the nodes in the accounting
+     map<uint32_t, string> const& labels = scenario->getLabels ();
+     for (map<uint32_t, string>::const_iterator it = labels.begin (); it != labels.end (); ++it) {
+          accountingHelper.setLabel (NodeList::GetNode (it->first), it->second);
+     }
+
+     // installing the applications on the nodes
+     NS_LOG_INFO ("Installing applications.");
+     DceManagerHelper dceManager;
+     DceApplicationHelper dce;
+     ApplicationContainer apps;
+     dceManager.Install (scenario->getDceNodes ());
+
+     // servers launched on the first connection request
+     ActivationHelper activation (10102);
+
+     // sizing the stacks of the DCE processes per binary
+     StackHelper stackHelper;
+     stackHelper.setMode (stackMode);
+     if (stackMode == "profile") {
+          stackHelper.loadProfile (stackProfile);
+     }
+
+     // spreading the start times of the servers and clients
+     ArrivalHelper serverArrivals;
+     serverArrivals.setPattern (serverArrival);
+     serverArrivals.setWindow (Seconds (serverArrivalWindow));
+     ArrivalHelper clientArrivals;
+     clientArrivals.setPattern (clientArrival);
+     clientArrivals.setWindow (Seconds (clientArrivalWindow));
+     ArrivalHelper reconnectArrivals;
+     reconnectArrivals.setPattern (reconnectArrival);
+     reconnectArrivals.setWindow (Seconds (reconnectWindow));
+     vector<ScenarioApp> const& scenarioApps = scenario->getApps ();
+     uint32_t nServers = 0;
+     uint32_t nClients = 0;
+     for (size_t i = 0; i < scenarioApps.size (); ++i) {
+          if (scenarioApps[i].server) {
+               ++nServers;
+          } else if (polling) {
+               ++nClients;
+          }
+     }
+     vector<Time> serverOffsets = serverArrivals.schedule (nServers);
+     vector<Time> clientOffsets = clientArrivals.schedule (nClients);
+     vector<Time> reconnectOffsets = reconnectArrivals.schedule (nClients);
+     uint32_t serverIndex = 0;
+     uint32_t clientIndex = 0;
+
+     // launching the servers and clients of the scenario
+     for (size_t i = 0; i < scenarioApps.size (); ++i) {
+          ScenarioApp const& app = scenarioApps[i];
+          if (! app.server && ! polling) {
+               continue;
+          }
+          Time start = app.start + (app.server ? serverOffsets[serverIndex++] : clientOffsets[clientIndex]);
+          Time stop = app.stop;
+          string binary = app.server ? config.server : config.client;
+          dce.SetBinary (binary);
+          stackHelper.apply (dce, binary);
+          dce.ResetArguments ();
+          dce.ResetEnvironment ();
+          for (size_t j = 0; j < app.arguments.size (); ++j) {
+               dce.AddArgument (app.arguments[j]);
+          }
+          if (app.server && lazyServers) {
+               apps = activation.install (dce, app.node, stop);
+          } else {
+               apps = dce.Install (app.node);
+          }
+          // a client running at the outage is killed and launched again after it
+          bool relaunch = ! app.server && reconnectTime > 0.0 && start < Seconds (reconnectTime)
+                          && (stop.IsZero () || stop > Seconds (reconnectTime));
+          apps.Start (start);
+          if (relaunch) {
+               apps.Stop (Seconds (reconnectTime));
+               apps = dce.Install (app.node);
+               apps.Start (Seconds (reconnectTime + reconnectOutage) + reconnectOffsets[clientIndex]);
+          }
+          if (! stop.IsZero ()) {
+               apps.Stop (stop);
+          }
+          if (! app.server) {
+               ++clientIndex;
+          }
+     }
+
+     // protection traffic between the servers
+     GooseHelper gooseHelper;
+     if (goose) {
+          NS_LOG_INFO ("Installing GOOSE.");
+          gooseHelper.setTransport (gooseTransport);
+          gooseHelper.setAttribute ("EventRate", DoubleValue (gooseEventRate));
+          gooseHelper.setAttribute ("MinTime", TimeValue (MicroSeconds (gooseMinTime * 1000)));
+          gooseHelper.setAttribute ("MaxTime", TimeValue (MicroSeconds (gooseMaxTime * 1000)));
+          gooseHelper.setAttribute ("Size", UintegerValue (gooseSize));
+          gooseHelper.install (scenario->getGoosePublishers (), scenario->getGooseSubscribers (),
+                               Seconds (1.0), Seconds (config.duration));
+     }
+
+     // measuring the poll completion times for the capacity search
+     PollProbeHelper pollProbeHelper;
+     if (pollProbe) {
+          NS_LOG_INFO ("Installing poll probe.");
+          pollProbeHelper.setAttribute ("Cycle", TimeValue (Seconds (pollCycle)));
+          pollProbeHelper.setAttribute ("RequestSize", UintegerValue (pollRequestSize));
+          pollProbeHelper.setAttribute ("ResponseSize", UintegerValue (pollResponseSize));
+          pollProbeHelper.install (scenario->getAppNodes (true), scenario->getAppNodes (false),
+                                   Seconds (1.0), Seconds (config.duration));
+     }
+
+     // event-driven SCADA traffic of the report control blocks
+     ReportHelper reportHelper;
+     if (reports) {
+          NS_LOG_INFO ("Installing reports.");
+          reportHelper.setAttribute ("ChangeRate", DoubleValue (reportChangeRate));
+          reportHelper.setAttribute ("DataPoints", UintegerValue (reportDataPoints));
+          reportHelper.setAttribute ("BufferTime", TimeValue (MicroSeconds (reportBufferTime * 1000)));
+          reportHelper.setAttribute ("IntegrityPeriod", TimeValue (Seconds (reportIntegrity)));
+          reportHelper.setAttribute ("Buffered", BooleanValue (reportBuffered));
+          reportHelper.setAttribute ("DisturbanceStart", TimeValue (Seconds (reportDisturbanceStart)));
+          reportHelper.setAttribute ("DisturbanceDuration", TimeValue (Seconds (reportDisturbanceDuration)));
+          reportHelper.setAttribute ("DisturbanceFactor", DoubleValue (reportDisturbanceFactor));
+          reportHelper.install (scenario->getAppNodes (true), scenario->getAppNodes (false),
+                                Seconds (1.0), Seconds (config.duration));
+     }
+
+     // bulk traffic next to the IEC 61850 traffic
+     FileTransferHelper fileTransferHelper;
+     if (fileTransfer) {
+          NS_LOG_INFO ("Installing file transfers.");
+          fileTransferHelper.setSize (fileTransferSize);
+          fileTransferHelper.setInterval (Seconds (fileTransferInterval));
+          fileTransferHelper.install (scenario->getAppNodes (true), scenario->getAppNodes (false),
+                                      Seconds (1.0), Seconds (config.duration));
+     }
+
+     // cross traffic sharing the links and the UEs with the IEC 61850 traffic
+     BackgroundHelper backgroundHelper;
+     if (! background.empty()) {
+          NS_LOG_INFO ("Installing background traffic.");
+          backgroundHelper.setAttribute ("Aggregate", UintegerValue (backgroundAggregate));
+          backgroundHelper.setAttribute ("OnTime", TimeValue (MicroSeconds (backgroundOnTime * 1000)));
+          backgroundHelper.setAttribute ("OffTime", TimeValue (MicroSeconds (backgroundOffTime * 1000)));
+          backgroundHelper.install (background, Seconds (1.0), Seconds (config.duration));
+     }
+
+     // process bus traffic from the merging units
+     SvHelper svHelper;
+     if (sampledValues) {
+          NS_LOG_INFO ("Installing sampled values.");
+          svHelper.setTransport (svTransport);
+          svHelper.setSampleRate (svRate);
+          svHelper.setAttribute ("Asdus", UintegerValue (svAsdus));
+          svHelper.install (scenario->getSvPublishers (), scenario->getSvSubscribers (), svStreams,
+                            Seconds (1.0), Seconds (config.duration));
+     }
+
+     // enabling pcap, ASCII and LTE tracing
+     scenario->enableTracing (config);
+
+     // enabling anim tracing, the interface has to live during the run
+     AnimationInterface* anim = 0;
+     if (config.animTracing) {
+          NS_LOG_INFO ("Enabling anim tracing.");
+          anim = new AnimationInterface (config.filePrefix + "-anim.xml");
+          anim->EnablePacketMetadata (true);
+     }
+
+     // sampling the stack usage in measure mode
+     stackHelper.scheduleSampling (Seconds (1.0), Seconds (config.duration));
+
+     Simulator::Stop (Seconds(config.duration));
+
+     // enabling output config
+     if (! configFileOut.empty()) {
+          Config::SetDefault ("ns3::ConfigStore::Filename", StringValue (configFileOut));
+          Config::SetDefault ("ns3::ConfigStore::FileFormat", StringValue ("RawText"));
+          Config::SetDefault ("ns3::ConfigStore::Mode", StringValue ("Save"));
+          ConfigStore outputConfig;
+          outputConfig.ConfigureDefaults ();
+          outputConfig.ConfigureAttributes ();
+     }
+
+     // capturing the output of the DCE processes
+     OutputHelper outputHelper;
+     outputHelper.setMode (outputMode);
+     outputHelper.setRingSize (outputRingSize);
+     outputHelper.setTrimInterval (Seconds (outputTrimInterval));
+     outputHelper.setLogFile (outputLog);
+     outputHelper.prepare (NodeContainer::GetGlobal ());
+
+     // running simulation
+     NS_LOG_INFO ("Running Simulation.");
+     Simulator::Run ();
+     accountingHelper.stop ();
+
+     // writing the results of the scenario
+     scenario->finish (config);
+
+     if (lazyServers) {
+          activation.report ();
+     }
+
+     if (goose) {
+          gooseHelper.report ();
+     }
+     if (goose && ! gooseCsv.empty()) {
+          gooseHelper.writeCsv (gooseCsv);
+     }
+
+     if (sampledValues) {
+          svHelper.report ();
+     }
+     if (sampledValues && ! svCsv.empty()) {
+          svHelper.writeCsv (svCsv);
+     }
+
+     if (pollProbe) {
+          pollProbeHelper.report ();
+     }
+     if (pollProbe && ! kpiFile.empty()) {
+          pollProbeHelper.writeKpi (kpiFile);
+     }
+
+     if (reports) {
+          reportHelper.report ();
+     }
+     if (reports && ! reportCsv.empty()) {
+          reportHelper.writeCsv (reportCsv);
+     }
+
+     if (fileTransfer) {
+          fileTransferHelper.report ();
+     }
+
+     if (! background.empty()) {
+          backgroundHelper.report ();
+     }
+
+     // reporting the accounting of the run
+     if (accounting) {
+          accountingHelper.report ();
+     }
+     if (! accountingCsv.empty()) {
+          accountingHelper.writeCsv (accountingCsv);
+     }
+
+     // reporting the stack usage of the DCE processes
+     stackHelper.report ();
+     if (stackMode == "measure" && ! stackProfile.empty()) {
+          stackHelper.saveProfile (stackProfile);
+     }
+
+     delete anim;
+     Simulator::Destroy ();
+     outputHelper.collect (outputDump);
+     delete scenario;
+     NS_LOG_INFO ("Simulation done.");
+
+     return 0;
+}
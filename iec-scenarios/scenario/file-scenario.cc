@@ -0,0 +1,227 @@
+#include "scenarios.h"
+#include "../utils/ip-helper.h"
+#include "../utils/string-helper.h"
+
+#include <set>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("FileScenario");
+
+string FileScenario::getName() const {
+     return "file";
+}
+
+string FileScenario::getDescription() const {
+     return "topology and applications read from --ScenarioFile";
+}
+
+void FileScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+}
+
+// Function to enable the P2P tracing and the LTE traces if cells are declared
+void FileScenario::enableTracing(ScenarioConfig const& config) {
+     if (m_lteHelper) {
+          LteScenario::enableTracing(config);
+     } else {
+          Scenario::enableTracing(config);
+     }
+}
+
+// Function to get the node of a reference, a single node is used for every index
+Ptr<Node> FileScenario::getNode(NodeRef const& ref, uint32_t index) const {
+     if (ref.size() == 1) {
+          index = 0;
+     }
+     return m_groups[ref.group].Get (ref.first + index);
+}
+
+void FileScenario::build(ScenarioConfig const& config) {
+     NS_ABORT_MSG_IF (config.scenarioFile.empty(), "The file topology needs --ScenarioFile");
+     NS_LOG_INFO ("Reading scenario file " + config.scenarioFile + ".");
+
+     ScenarioDescription description;
+     vector<string> errors;
+     if (! ScenarioFile::parse(config.scenarioFile, description, errors)) {
+          for (size_t i = 0; i < errors.size(); ++i) {
+               cerr << errors[i] << endl;
+          }
+          NS_ABORT_MSG ("Invalid scenario file " + config.scenarioFile);
+     }
+
+     NS_LOG_INFO ("Building file topology.");
+     uint32_t nNodes = 0;
+     m_groups.resize(description.groupNames.size());
+     for (size_t i = 0; i < m_groups.size(); ++i) {
+          m_groups[i].Create (description.groupSizes[i]);
+          nNodes += description.groupSizes[i];
+     }
+
+     // the EPC installs the internet stack on the eNBs itself
+     set<uint32_t> enbNodes;
+     for (size_t i = 0; i < description.enbs.size(); ++i) {
+          for (uint32_t j = 0; j < description.enbs[i].size(); ++j) {
+               enbNodes.insert(getNode(description.enbs[i], j)->GetId ());
+          }
+     }
+     for (size_t i = 0; i < m_groups.size(); ++i) {
+          for (uint32_t j = 0; j < m_groups[i].GetN (); ++j) {
+               Ptr<Node> node = m_groups[i].Get (j);
+               if (! enbNodes.count(node->GetId ())) {
+                    m_internet.Install (node);
+               }
+               setLabel(node, description.groupNames[i]);
+          }
+     }
+     NS_LOG_INFO ("Nodes: " + StringHelper::toString(nNodes));
+
+     buildLinks(description);
+     if (description.epc) {
+          buildLte(description, config);
+     }
+     if (! description.links.empty() || description.epc) {
+          Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+     }
+
+     for (size_t i = 0; i < description.labels.size(); ++i) {
+          NodeRef const& ref = description.labels[i].first;
+          for (uint32_t j = 0; j < ref.size(); ++j) {
+               setLabel(getNode(ref, j), description.labels[i].second);
+          }
+     }
+     buildApps(description);
+}
+
+// Function to create the P2P links, every link gets its own /30 network
+void FileScenario::buildLinks(ScenarioDescription const& description) {
+     map<string, PointToPointHelper> helpers;
+     for (map<string, LinkClass>::const_iterator it = description.classes.begin (); it != description.classes.end (); ++it) {
+          helpers[it->first].SetDeviceAttribute ("DataRate", StringValue (it->second.dataRate));
+          helpers[it->first].SetChannelAttribute ("Delay", StringValue (it->second.delay));
+     }
+
+     Ipv4AddressHelper address;
+     address.SetBase ("10.1.0.0", "255.255.255.252");
+     uint32_t nLinks = 0;
+     for (size_t i = 0; i < description.links.size(); ++i) {
+          LinkDecl const& link = description.links[i];
+          uint32_t pairs = 0;
+          ScenarioFile::pairRefs(link.a, link.b, pairs);
+          PointToPointHelper& helper = helpers[link.linkClass];
+          for (uint32_t j = 0; j < pairs; ++j) {
+               address.Assign (helper.Install (getNode(link.a, j), getNode(link.b, j)));
+               address.NewNetwork ();
+          }
+          nLinks += pairs;
+     }
+     NS_LOG_INFO ("Links: " + StringHelper::toString(nLinks));
+}
+
+// Function to create the EPC with the remote host, the eNBs and the attached UEs
+void FileScenario::buildLte(ScenarioDescription const& description, ScenarioConfig const& config) {
+     NS_LOG_INFO ("Creating EPC.");
+     configureLte(config);
+     m_epcHelper = CreateObject<PointToPointEpcHelper> ();
+     m_lteHelper->SetEpcHelper (m_epcHelper);
+
+     // the remote link uses its class or the DataRate and Delay of the command line
+     PointToPointHelper remoteLink;
+     LinkClass linkClass;
+     linkClass.dataRate = config.dataRate;
+     linkClass.delay = config.delay;
+     if (! description.remoteClass.empty()) {
+          linkClass = description.classes.find(description.remoteClass)->second;
+     }
+     remoteLink.SetDeviceAttribute ("DataRate", StringValue (linkClass.dataRate));
+     remoteLink.SetChannelAttribute ("Delay", StringValue (linkClass.delay));
+     Ptr<Node> remote = getNode(description.remote, 0);
+     NetDeviceContainer internetDevices = remoteLink.Install (m_epcHelper->GetPgwNode (), remote);
+     Ipv4AddressHelper ipv4h;
+     ipv4h.SetBase ("1.0.0.0", "255.255.255.252");
+     ipv4h.Assign (internetDevices);
+
+     // routing the UE network over the PGW, announced to the P2P nodes behind the remote host
+     Ptr<Ipv4> remoteIpv4 = remote->GetObject<Ipv4> ();
+     Ptr<Ipv4StaticRouting> remoteHostStaticRouting = m_routingHelper.GetStaticRouting (remoteIpv4);
+     remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"),
+                                                 remoteIpv4->GetInterfaceForDevice (internetDevices.Get (1)));
+     Ptr<GlobalRouter> globalRouter = remote->GetObject<GlobalRouter> ();
+     if (globalRouter) {
+          globalRouter->InjectRoute (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"));
+     }
+     setLabel(m_epcHelper->GetPgwNode (), "pgw");
+
+     // every node of an enb statement gets one eNB device
+     MobilityHelper mobility;
+     mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+     map<uint32_t, Ptr<NetDevice> > enbDevices;
+     for (size_t i = 0; i < description.enbs.size(); ++i) {
+          for (uint32_t j = 0; j < description.enbs[i].size(); ++j) {
+               Ptr<Node> node = getNode(description.enbs[i], j);
+               if (enbDevices.count(node->GetId ())) {
+                    continue;
+               }
+               mobility.Install (node);
+               NetDeviceContainer devices = m_lteHelper->InstallEnbDevice (NodeContainer (node));
+               enbDevices[node->GetId ()] = devices.Get (0);
+               m_enbNodes.Add (node);
+               m_enbDevs.Add (devices);
+          }
+     }
+
+     // UEs of a statement are attached round robin to the eNBs of the statement
+     for (size_t i = 0; i < description.ues.size(); ++i) {
+          NodeRef const& ueRef = description.ues[i].first;
+          NodeRef const& enbRef = description.ues[i].second;
+          for (uint32_t j = 0; j < ueRef.size(); ++j) {
+               Ptr<Node> node = getNode(ueRef, j);
+               mobility.Install (node);
+               NetDeviceContainer devices = m_lteHelper->InstallUeDevice (NodeContainer (node));
+               m_epcHelper->AssignUeIpv4Address (devices);
+               Ptr<Ipv4StaticRouting> ueStaticRouting = m_routingHelper.GetStaticRouting (node->GetObject<Ipv4> ());
+               ueStaticRouting->SetDefaultRoute (m_epcHelper->GetUeDefaultGatewayAddress (), 1);
+               Ptr<Node> enb = enbRef.size() == 1 ? getNode(enbRef, 0) : getNode(enbRef, j % enbRef.size());
+               m_lteHelper->Attach (devices.Get (0), enbDevices[enb->GetId ()]);
+               m_ueNodes.Add (node);
+               m_ueDevs.Add (devices);
+          }
+     }
+     NS_LOG_INFO ("eNBs: " + StringHelper::toString(m_enbNodes.GetN ()));
+     NS_LOG_INFO ("UEs: " + StringHelper::toString(m_ueNodes.GetN ()));
+}
+
+// Function to add the servers and clients, the client gets the address of its target
+void FileScenario::buildApps(ScenarioDescription const& description) {
+     set<uint32_t> dceNodes;
+     for (size_t i = 0; i < description.apps.size(); ++i) {
+          AppDecl const& app = description.apps[i];
+          uint32_t pairs = 0;
+          ScenarioFile::pairRefs(app.node, app.target, pairs);
+          Time start = Seconds (app.start);
+          Time stop = app.stop > 0.0 ? Seconds (app.stop) : Time ();
+          for (uint32_t j = 0; j < pairs; ++j) {
+               Ptr<Node> node = getNode(app.node, j);
+               if (dceNodes.insert(node->GetId ()).second) {
+                    m_dceNodes.Add (node);
+               }
+               if (app.server && app.defaultArguments) {
+                    addServer(node, start);
+               } else if (app.server) {
+                    addApp(node, true, app.arguments, start, stop);
+               } else if (app.defaultArguments) {
+                    addClient(node, getNode(app.target, j), start);
+               } else {
+                    vector<string> arguments = app.arguments;
+                    arguments.push_back(IpHelper::getIp(getNode(app.target, j)));
+                    addApp(node, false, arguments, start, stop);
+               }
+               if (app.defaultArguments && ! stop.IsZero ()) {
+                    m_apps.back().stop = stop;
+               }
+          }
+     }
+     NS_LOG_INFO ("Applications: " + StringHelper::toString((uint32_t) m_apps.size()));
+}
@@ -0,0 +1,446 @@
+#include "scenarios.h"
+#include "../utils/ip-helper.h"
+#include "../utils/position-helper.h"
+#include "../utils/string-helper.h"
+
+#include <cmath>
+#include <fstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("LteScenarios");
+
+LteScenario::LteScenario() :
+     m_traceLinks(false),
+     m_recordDelays(false) {
+}
+
+void LteScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.server = "simple-iec-server";
+     config.client = "simple-iec-client";
+     config.dataRate = "100Mbps";
+     config.duration = 30.0;
+}
+
+// Function to enable the P2P tracing and the LTE traces
+void LteScenario::enableTracing(ScenarioConfig const& config) {
+     Scenario::enableTracing(config);
+     if (config.lteTracing && m_lteHelper) {
+          NS_LOG_INFO ("Enabling LTE tracing.");
+          m_lteHelper->EnablePhyTraces ();
+          m_lteHelper->EnableMacTraces ();
+          m_lteHelper->EnableRlcTraces ();
+          m_lteHelper->EnablePdcpTraces ();
+     }
+}
+
+// Function to write the recorded delays between the UEs and the PGW
+void LteScenario::finish(ScenarioConfig const& config) {
+     Scenario::finish(config);
+     if (m_recordDelays) {
+          m_delayRecorder.report ();
+     }
+     if (m_recordDelays && ! config.lteDelayCsv.empty()) {
+          NS_LOG_INFO ("Writing LTE delays to " << config.lteDelayCsv);
+          m_delayRecorder.writeCsv (config.lteDelayCsv);
+     }
+     if (m_recordDelays && ! config.lteBearerKpiFile.empty()) {
+          NS_LOG_INFO ("Writing LTE bearer KPIs to " << config.lteBearerKpiFile);
+          m_delayRecorder.writeKpi (config.lteBearerKpiFile);
+     }
+     if (m_cutoffHelper.isEnabled()) {
+          m_cutoffHelper.report (m_enbDevs, m_ueDevs, config.lteBandwidth);
+     }
+     m_gatewayLoad.report ();
+     if (config.lteScheduler == "deadline" && ! m_traceLinks) {
+          reportGrants (config.lteGrantFile);
+     }
+}
+
+// Function to print the uplink grants of the deadline schedulers of all cells and to write them as
+// name=value lines if a file is given
+void LteScenario::reportGrants(string const& fileName) const {
+     DeadlineFfMacScheduler::Grants grants;
+     for (uint32_t i = 0; i < m_enbDevs.GetN (); ++i) {
+          PointerValue scheduler;
+          m_enbDevs.Get (i)->GetAttribute ("FfMacScheduler", scheduler);
+          Ptr<DeadlineFfMacScheduler> deadline = DynamicCast<DeadlineFfMacScheduler> (scheduler.Get<FfMacScheduler> ());
+          if (! deadline) {
+               continue;
+          }
+          DeadlineFfMacScheduler::Grants const& cell = deadline->getGrants();
+          grants.spsGrants += cell.spsGrants;
+          grants.spsEmpty += cell.spsEmpty;
+          grants.dynamicGrants += cell.dynamicGrants;
+          grants.rbs += cell.rbs;
+          grants.bytes += cell.bytes;
+     }
+     NS_LOG_INFO ("Uplink grants: " << grants.spsGrants << " semi-persistent (" << grants.spsEmpty << " empty), "
+                  << grants.dynamicGrants << " dynamic, " << grants.rbs << " RBs, " << grants.bytes << " bytes");
+     if (! fileName.empty()) {
+          ofstream out(fileName.c_str());
+          if (!out.is_open()) {
+               NS_LOG_WARN ("Cannot write grant file " << fileName);
+               return;
+          }
+          out << "sps_grants=" << grants.spsGrants << endl;
+          out << "sps_empty=" << grants.spsEmpty << endl;
+          out << "dynamic_grants=" << grants.dynamicGrants << endl;
+          out << "rbs=" << grants.rbs << endl;
+          out << "bytes=" << grants.bytes << endl;
+     }
+}
+
+// Function to create the LTE helper with the bandwidth (in RBs), the MAC scheduler and the pathloss
+// model of the cells, optionally with the interference cutoff
+void LteScenario::configureLte(ScenarioConfig const& config) {
+     m_lteHelper = CreateObject<LteHelper> ();
+     map<string, string> schedulers;
+     schedulers["pf"] = "ns3::PfFfMacScheduler";
+     schedulers["rr"] = "ns3::RrFfMacScheduler";
+     schedulers["pss"] = "ns3::PssFfMacScheduler";
+     schedulers["tdmt"] = "ns3::TdMtFfMacScheduler";
+     schedulers["cqa"] = "ns3::CqaFfMacScheduler";
+     schedulers["deadline"] = "DeadlineFfMacScheduler";
+     map<string, string>::const_iterator scheduler = schedulers.find(config.lteScheduler);
+     m_lteHelper->SetSchedulerType (scheduler != schedulers.end() ? scheduler->second : config.lteScheduler);
+     if (config.lteScheduler == "deadline") {
+          m_lteHelper->SetSchedulerAttribute ("Deadlines", StringValue (config.lteDeadlines));
+          m_lteHelper->SetSchedulerAttribute ("SpsPeriod", TimeValue (MilliSeconds (config.lteSpsPeriod)));
+          m_lteHelper->SetSchedulerAttribute ("SpsRbs", UintegerValue (config.lteSpsRbs));
+     } else {
+          NS_ABORT_MSG_IF (config.lteSpsPeriod > 0, "Semi-persistent grants need the deadline scheduler");
+     }
+     m_lteHelper->SetEnbDeviceAttribute ("DlBandwidth", UintegerValue (config.lteBandwidth));
+     m_lteHelper->SetEnbDeviceAttribute ("UlBandwidth", UintegerValue (config.lteBandwidth));
+     if (config.lteCutoff > 0.0) {
+          NS_LOG_INFO ("Cutting off the interference beyond " << config.lteCutoff << " m.");
+          m_cutoffHelper.configure (m_lteHelper, config.lteCutoff, config.ltePathloss);
+     } else {
+          m_lteHelper->SetAttribute ("PathlossModel", StringValue (config.ltePathloss));
+     }
+}
+
+// Function to create the EPC (or the gateway of the trace links) and the remote host connected to it
+void LteScenario::buildEpc(ScenarioConfig const& config) {
+     NS_ABORT_MSG_UNLESS (config.lteModel == "full" || config.lteModel == "trace",
+          "Unknown LTE model " << config.lteModel);
+     m_traceLinks = config.lteModel == "trace";
+     m_traceFile = config.lteTrace;
+     m_recordDelays = ! config.lteDelayCsv.empty() || ! config.lteBearerKpiFile.empty();
+     if (m_traceLinks && m_recordDelays) {
+          NS_LOG_WARN ("LTE delays are only recorded with the full LTE model.");
+          m_recordDelays = false;
+     }
+     m_qosHelper.configure (config.lteBearers);
+     if (m_traceLinks && m_qosHelper.isEnabled()) {
+          NS_LOG_WARN ("Dedicated bearers are only activated with the full LTE model.");
+     }
+     if (m_traceLinks) {
+          NS_LOG_INFO ("Creating gateway of the trace driven LTE links.");
+          m_gateway = CreateObject<Node> ();
+          m_internet.Install (m_gateway);
+     } else {
+          NS_LOG_INFO ("Creating EPC.");
+          configureLte(config);
+          m_epcHelper = CreateObject<PointToPointEpcHelper> ();
+          m_lteHelper->SetEpcHelper (m_epcHelper);
+          m_gateway = m_epcHelper->GetPgwNode ();
+     }
+
+     // the EPC has a single PGW, the regions get their own links to their control centers instead
+     NS_ABORT_MSG_UNLESS (config.lteGateways > 0, "At least one LTE gateway needed");
+     NS_LOG_INFO ("Creating " << config.lteGateways << " remote nodes.");
+     m_remoteHosts.Create (config.lteGateways);
+     m_internet.Install (m_remoteHosts);
+
+     setPointToPoint(config);
+     Ipv4AddressHelper ipv4h;
+     for (uint32_t i = 0; i < m_remoteHosts.GetN (); ++i) {
+          NetDeviceContainer internetDevices = m_pointToPoint.Install (m_gateway, m_remoteHosts.Get (i));
+          // the first link keeps the network of the single remote host
+          string network = i == 0 ? "10.1.1.0" : "10.100." + StringHelper::toString(i) + ".0";
+          ipv4h.SetBase (network.c_str(), "255.255.255.0");
+          ipv4h.Assign (internetDevices);
+          m_gatewayLoad.add ("gateway" + StringHelper::toString(i), internetDevices.Get (0));
+
+          // routing the UE network over the PGW
+          Ptr<Ipv4StaticRouting> remoteHostStaticRouting = m_routingHelper.GetStaticRouting (m_remoteHosts.Get (i)->GetObject<Ipv4> ());
+          remoteHostStaticRouting->AddNetworkRouteTo (Ipv4Address ("7.0.0.0"), Ipv4Mask ("255.0.0.0"), 1);
+          setLabel(m_remoteHosts.Get (i), "remote");
+     }
+
+     setLabel(m_gateway, "pgw");
+     m_dceNodes.Add (m_remoteHosts);
+}
+
+// Function to get the control center of the region of a UE
+Ptr<Node> LteScenario::getControlCenter(uint32_t ue) const {
+     return m_remoteHosts.Get (ue < m_ueRegions.size() ? m_ueRegions[ue] : 0);
+}
+
+// Function to create eNBs and UEs with addresses and default routes, only UEs with trace links
+void LteScenario::buildRadio(uint32_t nEnbs, uint32_t nUes) {
+     // consecutive UEs share a region unless the topology places them
+     m_ueRegions.resize(nUes);
+     for (uint32_t i = 0; i < nUes; ++i) {
+          m_ueRegions[i] = (uint64_t) i * m_remoteHosts.GetN () / nUes;
+     }
+     if (m_traceLinks) {
+          // the samples of the trace depend on the load of a cell
+          if (! m_traceFile.empty()) {
+               double cellLoad = (double) nUes / max(nEnbs, (uint32_t) 1);
+               NS_ABORT_MSG_UNLESS (m_traceLinkHelper.load (m_traceFile, cellLoad), "Cannot read LTE trace " << m_traceFile);
+          }
+          NS_LOG_INFO ("Creating UE nodes.");
+          m_ueNodes.Create (nUes);
+          m_internet.Install (m_ueNodes);
+          m_dceNodes.Add (m_ueNodes);
+          return;
+     }
+
+     NS_LOG_INFO ("Creating LTE nodes.");
+     m_enbNodes.Create (nEnbs);
+     m_ueNodes.Create (nUes);
+
+     MobilityHelper mobility;
+     mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+     mobility.Install (m_enbNodes);
+     mobility.Install (m_ueNodes);
+
+     m_enbDevs = m_lteHelper->InstallEnbDevice (m_enbNodes);
+     m_ueDevs = m_lteHelper->InstallUeDevice (m_ueNodes);
+
+     m_internet.Install (m_ueNodes);
+
+     NS_LOG_INFO ("Assigning IP addresses to the ue nodes.");
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          m_epcHelper->AssignUeIpv4Address (NetDeviceContainer (m_ueDevs.Get (i)));
+          Ptr<Ipv4StaticRouting> ueStaticRouting = m_routingHelper.GetStaticRouting (m_ueNodes.Get (i)->GetObject<Ipv4> ());
+          ueStaticRouting->SetDefaultRoute (m_epcHelper->GetUeDefaultGatewayAddress (), 1);
+     }
+
+     for (uint32_t i = 0; i < m_enbNodes.GetN (); ++i) {
+          setLabel(m_enbNodes.Get (i), "enb");
+     }
+     m_dceNodes.Add (m_ueNodes);
+}
+
+// Function to attach the UEs round robin or to the strongest eNB, or to connect them to the gateway
+// with trace links
+void LteScenario::attachUes(bool strongestCell) {
+     vector<uint32_t> regionUes(m_remoteHosts.GetN (), 0);
+     for (size_t i = 0; i < m_ueRegions.size(); ++i) {
+          ++regionUes[m_ueRegions[i]];
+     }
+     for (size_t i = 0; i < regionUes.size(); ++i) {
+          NS_LOG_INFO ("Gateway " << i << ": " << regionUes[i] << " UEs.");
+     }
+     if (m_traceLinks) {
+          NS_LOG_INFO ("Connecting UEs with trace driven links.");
+          // the UE addresses stay in 7.0.0.0/8 like those of the EPC
+          Ipv4AddressHelper address;
+          address.SetBase ("7.0.0.0", "255.255.255.252");
+          for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+               NetDeviceContainer devices = m_traceLinkHelper.install (m_ueNodes.Get (i), m_gateway);
+               Ipv4InterfaceContainer interfaces = address.Assign (devices);
+               address.NewNetwork ();
+               Ptr<Ipv4StaticRouting> ueStaticRouting = m_routingHelper.GetStaticRouting (m_ueNodes.Get (i)->GetObject<Ipv4> ());
+               ueStaticRouting->SetDefaultRoute (interfaces.GetAddress (1), 1);
+          }
+          return;
+     }
+     if (strongestCell) {
+          // initial cell selection of the UEs by the RSRP
+          m_lteHelper->Attach (m_ueDevs);
+     } else {
+          for (uint32_t i = 0; i < m_ueDevs.GetN (); ++i) {
+               m_lteHelper->Attach (m_ueDevs.Get (i), m_enbDevs.Get (i % m_enbDevs.GetN ()));
+          }
+     }
+     if (m_qosHelper.isEnabled()) {
+          m_qosHelper.activate (m_lteHelper, m_ueDevs);
+     }
+     if (m_recordDelays) {
+          vector<QosHelper::TrafficClass> classes = QosHelper::getClasses();
+          for (size_t i = 0; i < classes.size(); ++i) {
+               m_delayRecorder.addClass (classes[i].name, classes[i].ports);
+          }
+          m_delayRecorder.install (m_gateway, m_ueNodes);
+     }
+}
+
+string SimpleLteScenario::getName() const {
+     return "simple-lte";
+}
+
+string SimpleLteScenario::getDescription() const {
+     return "one UE server, client on the remote host";
+}
+
+void SimpleLteScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building simple LTE topology.");
+     buildEpc(config);
+     buildRadio(1, 1);
+     attachUes();
+
+     addApp(m_ueNodes.Get (0), true, vector<string>(), Seconds (1.0), Time ());
+     vector<string> arguments(1, IpHelper::getIp(m_ueNodes.Get (0)));
+     addApp(m_remoteHosts.Get (0), false, arguments, Seconds (3.0), Seconds (config.duration));
+}
+
+string GenericLteScenario::getName() const {
+     return "generic-lte";
+}
+
+string GenericLteScenario::getDescription() const {
+     return "nUEs servers in one cell, clients on the remote hosts of their regions";
+}
+
+void GenericLteScenario::setDefaults(ScenarioConfig& config) const {
+     LteScenario::setDefaults(config);
+     config.server = "simple-iec61850-server";
+     config.client = "simple-iec61850-client";
+     config.dataRate = "5Mbps";
+     config.duration = 15.0;
+}
+
+void GenericLteScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building generic LTE topology.");
+     buildEpc(config);
+     buildRadio(1, config.nUes);
+     attachUes();
+
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          addServer(m_ueNodes.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          addClient(getControlCenter(i), m_ueNodes.Get (i), Seconds (5.0));
+     }
+}
+
+string MultipleLteScenario::getName() const {
+     return "multiple-lte";
+}
+
+string MultipleLteScenario::getDescription() const {
+     return "two cells with one UE server each, client on the remote host";
+}
+
+void MultipleLteScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building multiple LTE topology.");
+     buildEpc(config);
+     buildRadio(2, 2);
+     attachUes();
+
+     addApp(m_ueNodes.Get (0), true, vector<string>(), Seconds (1.0), Time ());
+     addApp(m_ueNodes.Get (1), true, vector<string>(), Seconds (1.0), Time ());
+     vector<string> arguments(1, IpHelper::getIp(m_ueNodes.Get (1)));
+     addApp(m_remoteHosts.Get (0), false, arguments, Seconds (3.0), Seconds (config.duration));
+}
+
+string MixedLteScenario::getName() const {
+     return "mixed-lte";
+}
+
+string MixedLteScenario::getDescription() const {
+     return "one UE server and one P2P server behind the remote host";
+}
+
+void MixedLteScenario::setDefaults(ScenarioConfig& config) const {
+     LteScenario::setDefaults(config);
+     config.duration = 10.0;
+}
+
+void MixedLteScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building mixed LTE topology.");
+     buildEpc(config);
+
+     // server connected over P2P to the remote node
+     NodeContainer p2pNode;
+     p2pNode.Create (1);
+     m_internet.Install (p2pNode);
+     NetDeviceContainer devices = m_pointToPoint.Install (m_remoteHosts.Get (0), p2pNode.Get (0));
+     Ipv4AddressHelper address;
+     address.SetBase ("10.1.2.0", "255.255.255.252");
+     address.Assign (devices);
+     m_dceNodes.Add (p2pNode);
+     NodeContainer stationNodes (m_remoteHosts.Get (0));
+     stationNodes.Add (p2pNode);
+     installLinkQueues(config, stationNodes);
+
+     buildRadio(1, 1);
+     attachUes();
+
+     addApp(m_ueNodes.Get (0), true, vector<string>(), Seconds (1.0), Time ());
+     addApp(p2pNode.Get (0), true, vector<string>(), Seconds (3.0), Time ());
+     vector<string> arguments(1, IpHelper::getIp(m_ueNodes.Get (0)));
+     addApp(m_remoteHosts.Get (0), false, arguments, Seconds (4.0), Seconds (config.duration));
+     arguments[0] = IpHelper::getIp(p2pNode.Get (0));
+     addApp(m_remoteHosts.Get (0), false, arguments, Seconds (8.0), Seconds (config.duration));
+}
+
+string CellularLteScenario::getName() const {
+     return "cellular-lte";
+}
+
+string CellularLteScenario::getDescription() const {
+     return "nEnbs cells in a hex or grid layout, nUEs servers, clients on the remote hosts of their regions";
+}
+
+void CellularLteScenario::setDefaults(ScenarioConfig& config) const {
+     LteScenario::setDefaults(config);
+     config.server = "simple-iec61850-server";
+     config.client = "simple-iec61850-client";
+     config.dataRate = "100Mbps";
+     config.duration = 15.0;
+     config.nUes = 70;
+}
+
+// Function to place the eNBs on the sites of the layout and the UEs around them or from the file
+void CellularLteScenario::placeNodes(ScenarioConfig const& config) {
+     vector<Vector> sites = PositionHelper::getLayout(config.lteLayout, config.nEnbs, config.lteSiteDistance);
+     NS_ABORT_MSG_UNLESS (sites.size() == config.nEnbs, "Unknown LTE layout " << config.lteLayout);
+     if (m_traceLinks) {
+          return;
+     }
+     for (uint32_t i = 0; i < m_enbNodes.GetN (); ++i) {
+          PositionHelper::setPosition(m_enbNodes.Get (i), sites[i].x, sites[i].y);
+     }
+
+     vector<Vector> positions;
+     if (config.uePlacement == "file") {
+          NS_ABORT_MSG_UNLESS (PositionHelper::readPositions(config.uePositions, positions),
+               "Cannot read UE positions " << config.uePositions);
+          NS_ABORT_MSG_UNLESS (positions.size() >= m_ueNodes.GetN (),
+               positions.size() << " UE positions for " << m_ueNodes.GetN () << " UEs");
+     } else {
+          // radius of the area served by a site
+          double radius = config.lteSiteDistance / (config.lteLayout == "hex" ? sqrt(3.0) : sqrt(2.0));
+          positions = PositionHelper::getPlacement(config.uePlacement, m_ueNodes.GetN (), sites, radius);
+          NS_ABORT_MSG_UNLESS (positions.size() == m_ueNodes.GetN (), "Unknown UE placement " << config.uePlacement);
+     }
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          PositionHelper::setPosition(m_ueNodes.Get (i), positions[i].x, positions[i].y);
+     }
+     positions.resize(m_ueNodes.GetN ());
+     m_ueRegions = PositionHelper::getRegions(positions, sites, m_remoteHosts.GetN ());
+}
+
+void CellularLteScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building cellular LTE topology.");
+     NS_ABORT_MSG_UNLESS (config.nEnbs > 0, "At least one eNB needed");
+     buildEpc(config);
+     buildRadio(config.nEnbs, config.nUes);
+     placeNodes(config);
+     attachUes(true);
+
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          addServer(m_ueNodes.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 0; i < m_ueNodes.GetN (); ++i) {
+          addClient(getControlCenter(i), m_ueNodes.Get (i), Seconds (5.0));
+     }
+}
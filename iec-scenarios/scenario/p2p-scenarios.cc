@@ -0,0 +1,264 @@
+#include "scenarios.h"
+#include "../utils/ip-helper.h"
+#include "ns3/point-to-point-layout-module.h"
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("P2pScenarios");
+
+// Function to get the client arguments of the simple star and the tree
+static vector<string> countedClientArguments(Ptr<Node> server) {
+     vector<string> arguments;
+     arguments.push_back("-c 4");
+     arguments.push_back("-s 1");
+     arguments.push_back("-p 10102");
+     arguments.push_back(IpHelper::getIp(server));
+     return arguments;
+}
+
+string SimpleP2pScenario::getName() const {
+     return "simple-p2p";
+}
+
+string SimpleP2pScenario::getDescription() const {
+     return "client and server connected over P2P";
+}
+
+void SimpleP2pScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.dataRate = "1Mbps";
+     config.duration = 60.0;
+     config.pcapTracing = true;
+     config.asciiTracing = true;
+     config.animTracing = true;
+}
+
+void SimpleP2pScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building P2P topology.");
+
+     NodeContainer nodes;
+     nodes.Create (2);
+
+     // placing the nodes in a grid for the animation
+     MobilityHelper mobility;
+     mobility.SetPositionAllocator ("ns3::GridPositionAllocator",
+          "MinX", DoubleValue (0.0),
+          "MinY", DoubleValue (0.0),
+          "DeltaX", DoubleValue (30.0),
+          "DeltaY", DoubleValue (10.0),
+          "GridWidth", UintegerValue (3),
+          "LayoutType", StringValue ("RowFirst"));
+     mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+     mobility.Install (nodes);
+
+     setPointToPoint(config);
+     NetDeviceContainer devices = m_pointToPoint.Install (nodes);
+
+     InternetStackHelper stack;
+     stack.Install (nodes);
+
+     Ipv4AddressHelper address;
+     address.SetBase ("10.1.1.0", "255.255.255.252");
+     address.Assign (devices);
+
+     Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+     m_dceNodes.Add (nodes);
+     addServer(nodes.Get (0), Seconds (1.0));
+     addClient(nodes.Get (1), nodes.Get (0), Seconds (5.0));
+}
+
+string SimpleStarScenario::getName() const {
+     return "simple-star";
+}
+
+string SimpleStarScenario::getDescription() const {
+     return "three servers and one client connected over a router";
+}
+
+void SimpleStarScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.duration = 30.0;
+}
+
+void SimpleStarScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building star topology.");
+
+     // first node is always the router (or switch) and last node always the client
+     NodeContainer nodes;
+     nodes.Create (5);
+     NodeContainer stations;
+     for (uint32_t i = 1; i < nodes.GetN (); ++i) {
+          stations.Add (nodes.Get (i));
+     }
+
+     setPointToPoint(config);
+     if (useSwitch(config)) {
+          buildSwitch(config, nodes.Get (0), stations);
+          installLinkQueues(config, stations);
+          m_dceNodes.Add (stations);
+     } else {
+          vector<NetDeviceContainer> devices;
+          for (uint32_t i = 1; i < nodes.GetN (); ++i) {
+               devices.push_back(m_pointToPoint.Install (nodes.Get (0), nodes.Get (i)));
+          }
+
+          InternetStackHelper stack;
+          stack.Install (nodes);
+
+          Ipv4AddressHelper address;
+          for (uint32_t i = 0; i < devices.size(); ++i) {
+               address.SetBase (Ipv4Address ((10 << 24) | (1 << 16) | ((i + 1) << 8)), "255.255.255.252");
+               address.Assign (devices[i]);
+          }
+
+          Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+          installLinkQueues(config, nodes);
+
+          setLabel(nodes.Get (0), "router");
+          m_dceNodes.Add (nodes);
+     }
+     Ptr<Node> client = nodes.Get (nodes.GetN () - 1);
+     for (uint32_t i = 1; i < nodes.GetN () - 1; ++i) {
+          addServer(nodes.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 1; i < nodes.GetN () - 1; ++i) {
+          addApp(client, false, countedClientArguments(nodes.Get (i)), Seconds (5.0), Time ());
+     }
+}
+
+string GenericStarScenario::getName() const {
+     return "generic-star";
+}
+
+string GenericStarScenario::getDescription() const {
+     return "nSpokes-1 servers and one client around a hub";
+}
+
+void GenericStarScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.duration = 15.0;
+}
+
+void GenericStarScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building generic star topology.");
+
+     setPointToPoint(config);
+     NodeContainer spokes;
+     if (useSwitch(config)) {
+          NodeContainer hub;
+          hub.Create (1);
+          spokes.Create (config.nSpokes);
+          buildSwitch(config, hub.Get (0), spokes);
+          installLinkQueues(config, spokes);
+     } else {
+          PointToPointStarHelper star (config.nSpokes, m_pointToPoint);
+
+          InternetStackHelper internet;
+          star.InstallStack (internet);
+          star.AssignIpv4Addresses (Ipv4AddressHelper ("10.1.1.0", "255.255.255.0"));
+
+          Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+          for (uint32_t i = 0; i < star.SpokeCount (); ++i) {
+               spokes.Add (star.GetSpokeNode (i));
+          }
+          NodeContainer nodes (star.GetHub ());
+          nodes.Add (spokes);
+          installLinkQueues(config, nodes);
+
+          setLabel(star.GetHub (), "hub");
+     }
+
+     Ptr<Node> client = spokes.Get (spokes.GetN () - 1);
+     m_dceNodes.Add (spokes);
+     for (uint32_t i = 0; i < spokes.GetN () - 1; ++i) {
+          addServer(spokes.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 0; i < spokes.GetN () - 1; ++i) {
+          addClient(client, spokes.Get (i), Seconds (5.0));
+     }
+}
+
+string SimpleTreeScenario::getName() const {
+     return "simple-tree";
+}
+
+string SimpleTreeScenario::getDescription() const {
+     return "four servers and one client connected over three routers";
+}
+
+void SimpleTreeScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.duration = 30.0;
+}
+
+void SimpleTreeScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building tree topology.");
+
+     // first nodes are always routers and last node is always the client
+     NodeContainer nodes;
+     nodes.Create (8);
+
+     // r1-r2, r1-r3, r2-s1, r2-s2, r3-s3, r3-s4, r1-c
+     const uint32_t links[][2] = { {0, 1}, {0, 2}, {1, 3}, {1, 4}, {2, 5}, {2, 6}, {0, 7} };
+     setPointToPoint(config);
+     vector<NetDeviceContainer> devices;
+     for (uint32_t i = 0; i < 7; ++i) {
+          devices.push_back(m_pointToPoint.Install (nodes.Get (links[i][0]), nodes.Get (links[i][1])));
+     }
+
+     InternetStackHelper stack;
+     stack.Install (nodes);
+
+     Ipv4AddressHelper address;
+     for (uint32_t i = 0; i < devices.size(); ++i) {
+          address.SetBase (Ipv4Address ((10 << 24) | (1 << 16) | ((i + 1) << 8)), "255.255.255.252");
+          address.Assign (devices[i]);
+     }
+
+     Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+     installLinkQueues(config, nodes);
+
+     for (uint32_t i = 0; i < 3; ++i) {
+          setLabel(nodes.Get (i), "router");
+     }
+     m_dceNodes.Add (nodes);
+     Ptr<Node> client = nodes.Get (nodes.GetN () - 1);
+     for (uint32_t i = 3; i < nodes.GetN () - 1; ++i) {
+          addServer(nodes.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 3; i < nodes.GetN () - 1; ++i) {
+          addApp(client, false, countedClientArguments(nodes.Get (i)), Seconds (5.0), Time ());
+     }
+}
+
+string TemplateScenario::getName() const {
+     return "template";
+}
+
+string TemplateScenario::getDescription() const {
+     return "one node running the server";
+}
+
+void TemplateScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.server = "simple-iec-server";
+     config.client = "simple-iec-client";
+     config.duration = 30.0;
+}
+
+void TemplateScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building template topology.");
+
+     NodeContainer nodes;
+     nodes.Create (1);
+
+     setPointToPoint(config);
+
+     InternetStackHelper stack;
+     stack.Install (nodes);
+
+     m_dceNodes.Add (nodes);
+     addApp(nodes.Get (0), true, vector<string>(), Seconds (1.0), Time ());
+}
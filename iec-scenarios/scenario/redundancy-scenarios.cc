@@ -0,0 +1,139 @@
+#include "scenarios.h"
+
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("RedundancyScenarios");
+
+void RedundancyScenario::setDefaults(ScenarioConfig& config) const {
+     Scenario::setDefaults(config);
+     config.dataRate = "100Mbps";
+     config.delay = "10us";
+     config.duration = 20.0;
+}
+
+// Function to print the redundancy and switch results and to write the KPIs
+void RedundancyScenario::finish(ScenarioConfig const& config) {
+     Scenario::finish(config);
+     for (size_t i = 0; i < m_switches.size(); ++i) {
+          cout << "LAN " << (char) ('A' + i) << ": ";
+          m_switches[i]->report ();
+     }
+     m_redundancy.report ();
+     if (! config.redundancyKpiFile.empty()) {
+          NS_LOG_INFO ("Writing redundancy KPIs to " << config.redundancyKpiFile);
+          m_redundancy.writeKpi (config.redundancyKpiFile);
+     }
+}
+
+// Function to set the links, the mode of the doubly attached nodes and whether they send duplicates
+void RedundancyScenario::configureRedundancy(ScenarioConfig const& config, string const& mode) {
+     // the ports have no queue discs, the link queues of the star topologies do not apply
+     m_pointToPoint.SetDeviceAttribute ("DataRate", StringValue (config.dataRate));
+     m_pointToPoint.SetChannelAttribute ("Delay", StringValue (config.delay));
+     m_redundancy.setAttribute ("Mode", StringValue (mode));
+     m_redundancy.setAttribute ("Duplicate", BooleanValue (config.redundancy));
+}
+
+// Function to assign one subnet to the virtual devices of the stations and to schedule the link failures
+void RedundancyScenario::assignAddresses(ScenarioConfig const& config, NodeContainer const& stations) {
+     // only the virtual devices get addresses, the ports stay without IP
+     InternetStackHelper stack;
+     stack.Install (stations);
+     Ipv4AddressHelper address;
+     address.SetBase ("10.2.0.0", "255.255.0.0");
+     address.Assign (m_devices);
+     m_redundancy.setAddresses (Ipv4Mask ("255.255.0.0"));
+     if (! config.linkFailures.empty()) {
+          m_redundancy.scheduleFailures (config.linkFailures);
+     }
+}
+
+// Function to run a server on every station and the client on the last one
+void RedundancyScenario::addApps(NodeContainer const& stations) {
+     Ptr<Node> client = stations.Get (stations.GetN () - 1);
+     m_dceNodes.Add (stations);
+     for (uint32_t i = 0; i < stations.GetN () - 1; ++i) {
+          addServer(stations.Get (i), Seconds (1.0));
+     }
+     for (uint32_t i = 0; i < stations.GetN () - 1; ++i) {
+          addClient(client, stations.Get (i), Seconds (5.0));
+     }
+}
+
+string PrpScenario::getName() const {
+     return "prp";
+}
+
+string PrpScenario::getDescription() const {
+     return "nSpokes-1 servers and one client attached to two switched LANs (PRP)";
+}
+
+void PrpScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building PRP topology.");
+     NS_ABORT_MSG_IF (config.nSpokes < 2, "The PRP topology needs at least 2 stations");
+
+     configureRedundancy(config, "prp");
+     NodeContainer hubs;
+     hubs.Create (2);
+     NodeContainer stations;
+     stations.Create (config.nSpokes);
+     for (uint32_t lan = 0; lan < 2; ++lan) {
+          Ptr<EthernetSwitch> lanSwitch = CreateObject<EthernetSwitch> ();
+          lanSwitch->SetAttribute ("MaxPackets", UintegerValue (config.switchQueueSize));
+          hubs.Get (lan)->AggregateObject (lanSwitch);
+          m_switches.push_back(lanSwitch);
+     }
+     setLabel(hubs.Get (0), "lan-a");
+     setLabel(hubs.Get (1), "lan-b");
+
+     for (uint32_t i = 0; i < stations.GetN (); ++i) {
+          Ptr<NetDevice> ports[2];
+          for (uint32_t lan = 0; lan < 2; ++lan) {
+               NetDeviceContainer devices = m_pointToPoint.Install (hubs.Get (lan), stations.Get (i));
+               m_switches[lan]->addPort(devices.Get (0));
+               ports[lan] = devices.Get (1);
+               ostringstream name;
+               name << (lan == 0 ? "a" : "b") << i;
+               m_redundancy.addLink (name.str(), devices);
+          }
+          m_devices.Add (m_redundancy.install (stations.Get (i), ports[0], ports[1]));
+     }
+     assignAddresses(config, stations);
+     addApps(stations);
+}
+
+string HsrScenario::getName() const {
+     return "hsr";
+}
+
+string HsrScenario::getDescription() const {
+     return "nSpokes-1 servers and one client in a ring (HSR)";
+}
+
+void HsrScenario::build(ScenarioConfig const& config) {
+     NS_LOG_INFO ("Building HSR topology.");
+     NS_ABORT_MSG_IF (config.nSpokes < 3, "The HSR ring needs at least 3 stations");
+
+     configureRedundancy(config, "hsr");
+     NodeContainer stations;
+     stations.Create (config.nSpokes);
+     // link i connects port B of station i with port A of station i+1
+     vector<NetDeviceContainer> links;
+     for (uint32_t i = 0; i < stations.GetN (); ++i) {
+          links.push_back(m_pointToPoint.Install (stations.Get (i), stations.Get ((i + 1) % stations.GetN ())));
+          ostringstream name;
+          name << "r" << i;
+          m_redundancy.addLink (name.str(), links.back());
+     }
+     for (uint32_t i = 0; i < stations.GetN (); ++i) {
+          Ptr<NetDevice> portA = links[(i + stations.GetN () - 1) % stations.GetN ()].Get (1);
+          Ptr<NetDevice> portB = links[i].Get (0);
+          m_devices.Add (m_redundancy.install (stations.Get (i), portA, portB));
+     }
+     assignAddresses(config, stations);
+     addApps(stations);
+}
@@ -0,0 +1,395 @@
+#include "scenario-file.h"
+
+#include <cfloat>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+
+using namespace std;
+
+// errors after which the parsing is stopped
+static const size_t MAX_ERRORS = 20;
+
+// Function to report an error with the position in the file
+static void addError(vector<string>& errors, string const& fileName, uint32_t line, string const& message) {
+     ostringstream error;
+     error << fileName << ":" << line << ": " << message;
+     errors.push_back(error.str());
+}
+
+// Function to split a line into tokens, double quotes group spaces and commas
+static bool tokenize(char const* begin, char const* end, vector<string>& tokens) {
+     tokens.clear();
+     char const* p = begin;
+     while (p < end) {
+          while (p < end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+               ++p;
+          }
+          if (p == end || *p == '#') {
+               break;
+          }
+          string token;
+          while (p < end && *p != ' ' && *p != '\t' && *p != '\r') {
+               if (*p == '"') {
+                    char const* close = p + 1;
+                    while (close < end && *close != '"') {
+                         ++close;
+                    }
+                    if (close == end) {
+                         return false;
+                    }
+                    // quoted text is marked to keep its commas in argument lists
+                    token += '\x01';
+                    token.append(p + 1, close);
+                    token += '\x01';
+                    p = close + 1;
+               } else {
+                    token += *p++;
+               }
+          }
+          tokens.push_back(token);
+     }
+     return true;
+}
+
+// Function to parse an unsigned number, the whole text has to be a number
+static bool parseNumber(string const& text, uint32_t& value) {
+     if (text.empty() || text.size() > 9) {
+          return false;
+     }
+     value = 0;
+     for (size_t i = 0; i < text.size(); ++i) {
+          if (text[i] < '0' || text[i] > '9') {
+               return false;
+          }
+          value = value * 10 + (text[i] - '0');
+     }
+     return true;
+}
+
+// Function to parse a time in seconds, inf, nan and negative times are rejected
+static bool parseSeconds(string const& text, double& value) {
+     char* end = 0;
+     value = strtod(text.c_str(), &end);
+     return ! text.empty() && *end == '\0' && value >= 0.0 && value <= DBL_MAX;
+}
+
+// Function to resolve a node reference against the declared groups
+static bool parseRef(string const& text, ScenarioDescription const& description, NodeRef& ref, string& message) {
+     size_t bracket = text.find('[');
+     string name = text.substr(0, bracket);
+     map<string, uint32_t>::const_iterator it = description.groups.find(name);
+     if (it == description.groups.end()) {
+          message = "unknown node group " + name;
+          return false;
+     }
+     ref.group = it->second;
+     ref.first = 0;
+     ref.last = description.groupSizes[ref.group] - 1;
+     if (bracket == string::npos) {
+          return true;
+     }
+     if (text[text.size() - 1] != ']') {
+          message = "missing ] in " + text;
+          return false;
+     }
+     string range = text.substr(bracket + 1, text.size() - bracket - 2);
+     if (range == "*") {
+          return true;
+     }
+     size_t dash = range.find('-');
+     bool valid;
+     if (dash == string::npos) {
+          valid = parseNumber(range, ref.first);
+          ref.last = ref.first;
+     } else {
+          valid = parseNumber(range.substr(0, dash), ref.first) && parseNumber(range.substr(dash + 1), ref.last);
+     }
+     if (! valid || ref.first > ref.last) {
+          message = "invalid range in " + text;
+          return false;
+     }
+     if (ref.last >= description.groupSizes[ref.group]) {
+          message = "index out of range in " + text;
+          return false;
+     }
+     return true;
+}
+
+// Function to split an argument list at commas outside of quotes
+static vector<string> splitArguments(string const& text) {
+     vector<string> arguments;
+     string argument;
+     bool quoted = false;
+     for (size_t i = 0; i < text.size(); ++i) {
+          if (text[i] == '\x01') {
+               quoted = ! quoted;
+          } else if (text[i] == ',' && ! quoted) {
+               arguments.push_back(argument);
+               argument.clear();
+          } else {
+               argument += text[i];
+          }
+     }
+     arguments.push_back(argument);
+     return arguments;
+}
+
+// Function to remove the quote marks of a token
+static string unquote(string const& text) {
+     string result;
+     for (size_t i = 0; i < text.size(); ++i) {
+          if (text[i] != '\x01') {
+               result += text[i];
+          }
+     }
+     return result;
+}
+
+// Function to check whether two references can be paired, returns the number of pairs
+bool ScenarioFile::pairRefs(NodeRef const& a, NodeRef const& b, uint32_t& pairs) {
+     if (a.size() == b.size() || b.size() == 1) {
+          pairs = a.size();
+          return true;
+     }
+     if (a.size() == 1) {
+          pairs = b.size();
+          return true;
+     }
+     return false;
+}
+
+// Function to read and parse a scenario file
+bool ScenarioFile::parse(string const& fileName, ScenarioDescription& description, vector<string>& errors) {
+     FILE* file = fopen(fileName.c_str(), "rb");
+     if (file == 0) {
+          errors.push_back("cannot open scenario file " + fileName);
+          return false;
+     }
+     string text;
+     char buffer[65536];
+     size_t n;
+     while ((n = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+          text.append(buffer, n);
+     }
+     fclose(file);
+     return parseText(text, fileName, description, errors);
+}
+
+// Function to parse the statements of a scenario file, stops after MAX_ERRORS errors
+bool ScenarioFile::parseText(string const& text, string const& fileName, ScenarioDescription& description,
+                             vector<string>& errors) {
+     description.epc = false;
+     vector<string> tokens;
+     vector<string> positional;
+     map<string, string> options;
+     uint32_t line = 0;
+     size_t position = 0;
+     while (position < text.size() && errors.size() < MAX_ERRORS) {
+          size_t newline = text.find('\n', position);
+          if (newline == string::npos) {
+               newline = text.size();
+          }
+          ++line;
+          bool closed = tokenize(text.data() + position, text.data() + newline, tokens);
+          position = newline + 1;
+          if (! closed) {
+               addError(errors, fileName, line, "unterminated quote");
+               continue;
+          }
+          if (tokens.empty()) {
+               continue;
+          }
+
+          // separating the positional parameters from key=value options
+          positional.clear();
+          options.clear();
+          for (size_t i = 1; i < tokens.size(); ++i) {
+               size_t equal = tokens[i].find('=');
+               if (equal == string::npos || tokens[i][0] == '\x01') {
+                    positional.push_back(unquote(tokens[i]));
+               } else {
+                    options[tokens[i].substr(0, equal)] = tokens[i].substr(equal + 1);
+               }
+          }
+
+          string const& keyword = tokens[0];
+          string message;
+          if (keyword == "class") {
+               if (positional.size() != 1) {
+                    addError(errors, fileName, line, "usage: class <name> [DataRate=<rate>] [Delay=<delay>]");
+                    continue;
+               }
+               LinkClass linkClass;
+               linkClass.dataRate = options.count("DataRate") ? unquote(options["DataRate"]) : "5Mbps";
+               linkClass.delay = options.count("Delay") ? unquote(options["Delay"]) : "2ms";
+               options.erase("DataRate");
+               options.erase("Delay");
+               if (description.classes.count(positional[0])) {
+                    addError(errors, fileName, line, "duplicate link class " + positional[0]);
+                    continue;
+               }
+               description.classes[positional[0]] = linkClass;
+          } else if (keyword == "nodes") {
+               uint32_t count = 1;
+               if (positional.empty() || positional.size() > 2
+                   || (positional.size() == 2 && (! parseNumber(positional[1], count) || count == 0))) {
+                    addError(errors, fileName, line, "usage: nodes <group> [<count>]");
+                    continue;
+               }
+               if (positional[0].find('[') != string::npos || description.groups.count(positional[0])) {
+                    addError(errors, fileName, line, "invalid or duplicate node group " + positional[0]);
+                    continue;
+               }
+               description.groups[positional[0]] = description.groupNames.size();
+               description.groupNames.push_back(positional[0]);
+               description.groupSizes.push_back(count);
+          } else if (keyword == "link") {
+               LinkDecl link;
+               uint32_t pairs;
+               if (positional.size() != 3) {
+                    addError(errors, fileName, line, "usage: link <class> <ref> <ref>");
+                    continue;
+               }
+               if (! description.classes.count(positional[0])) {
+                    addError(errors, fileName, line, "unknown link class " + positional[0]);
+                    continue;
+               }
+               if (! parseRef(positional[1], description, link.a, message)
+                   || ! parseRef(positional[2], description, link.b, message)) {
+                    addError(errors, fileName, line, message);
+                    continue;
+               }
+               if (! pairRefs(link.a, link.b, pairs)) {
+                    addError(errors, fileName, line, "references of the link differ in size");
+                    continue;
+               }
+               link.linkClass = positional[0];
+               description.links.push_back(link);
+          } else if (keyword == "epc") {
+               if (positional.size() != 1) {
+                    addError(errors, fileName, line, "usage: epc <remote-ref> [class=<class>]");
+                    continue;
+               }
+               if (description.epc) {
+                    addError(errors, fileName, line, "duplicate epc");
+                    continue;
+               }
+               if (! parseRef(positional[0], description, description.remote, message)) {
+                    addError(errors, fileName, line, message);
+                    continue;
+               }
+               if (description.remote.size() != 1) {
+                    addError(errors, fileName, line, "the remote host has to be a single node");
+                    continue;
+               }
+               description.remoteClass = options.count("class") ? unquote(options["class"]) : "";
+               options.erase("class");
+               if (! description.remoteClass.empty() && ! description.classes.count(description.remoteClass)) {
+                    addError(errors, fileName, line, "unknown link class " + description.remoteClass);
+                    continue;
+               }
+               description.epc = true;
+          } else if (keyword == "enb") {
+               NodeRef enb;
+               if (positional.size() != 1 || ! parseRef(positional[0], description, enb, message)) {
+                    addError(errors, fileName, line, message.empty() ? "usage: enb <ref>" : message);
+                    continue;
+               }
+               description.enbs.push_back(enb);
+          } else if (keyword == "ue") {
+               NodeRef ue;
+               NodeRef enb;
+               if (positional.size() != 2) {
+                    addError(errors, fileName, line, "usage: ue <ue-ref> <enb-ref>");
+                    continue;
+               }
+               if (! parseRef(positional[0], description, ue, message)
+                   || ! parseRef(positional[1], description, enb, message)) {
+                    addError(errors, fileName, line, message);
+                    continue;
+               }
+               bool declared = false;
+               for (size_t i = 0; i < description.enbs.size(); ++i) {
+                    declared = declared || description.enbs[i].group == enb.group;
+               }
+               if (! declared) {
+                    addError(errors, fileName, line, "no enb statement for " + positional[1]);
+                    continue;
+               }
+               description.ues.push_back(make_pair(ue, enb));
+          } else if (keyword == "label") {
+               NodeRef ref;
+               if (positional.size() != 2) {
+                    addError(errors, fileName, line, "usage: label <ref> <label>");
+                    continue;
+               }
+               if (! parseRef(positional[0], description, ref, message)) {
+                    addError(errors, fileName, line, message);
+                    continue;
+               }
+               description.labels.push_back(make_pair(ref, positional[1]));
+          } else if (keyword == "server" || keyword == "client") {
+               AppDecl app;
+               uint32_t pairs;
+               app.server = keyword == "server";
+               size_t expected = app.server ? 1 : 2;
+               if (positional.size() != expected) {
+                    addError(errors, fileName, line, app.server
+                             ? "usage: server <ref> [start=<sec>] [stop=<sec>] [args=<arg>,...]"
+                             : "usage: client <ref> <target-ref> [start=<sec>] [stop=<sec>] [args=<arg>,...]");
+                    continue;
+               }
+               if (! parseRef(positional[0], description, app.node, message)
+                   || (! app.server && ! parseRef(positional[1], description, app.target, message))) {
+                    addError(errors, fileName, line, message);
+                    continue;
+               }
+               if (! app.server && ! pairRefs(app.node, app.target, pairs)) {
+                    addError(errors, fileName, line, "references of the client differ in size");
+                    continue;
+               }
+               if (app.server) {
+                    app.target = app.node;
+               }
+               app.start = app.server ? 1.0 : 5.0;
+               app.stop = 0.0;
+               if (options.count("start") && ! parseSeconds(unquote(options["start"]), app.start)) {
+                    addError(errors, fileName, line, "invalid start time " + unquote(options["start"]) + ", expected seconds >= 0");
+                    continue;
+               }
+               if (options.count("stop") && ! parseSeconds(unquote(options["stop"]), app.stop)) {
+                    addError(errors, fileName, line, "invalid stop time " + unquote(options["stop"]) + ", expected seconds >= 0");
+                    continue;
+               }
+               if (app.stop != 0.0 && app.stop <= app.start) {
+                    addError(errors, fileName, line, "stop time has to be after the start time");
+                    continue;
+               }
+               app.defaultArguments = ! options.count("args");
+               if (! app.defaultArguments) {
+                    app.arguments = splitArguments(options["args"]);
+               }
+               options.erase("start");
+               options.erase("stop");
+               options.erase("args");
+               description.apps.push_back(app);
+          } else {
+               addError(errors, fileName, line, "unknown statement " + keyword);
+               continue;
+          }
+
+          // every option has been consumed by its statement
+          if (! options.empty()) {
+               addError(errors, fileName, line, "unknown option " + options.begin()->first);
+               continue;
+          }
+     }
+     if (errors.size() >= MAX_ERRORS) {
+          errors.push_back("too many errors, stopping");
+     }
+     if (errors.empty() && (! description.enbs.empty() || ! description.ues.empty()) && ! description.epc) {
+          errors.push_back(fileName + ": eNBs and UEs need an epc statement");
+     }
+     return errors.empty();
+}
@@ -0,0 +1,86 @@
+#ifndef SCENARIO_FILE_H_
+#define SCENARIO_FILE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Reference to nodes of a group: "name", "name[*]", "name[i]" or "name[i-j]".
+*/
+struct NodeRef {
+     uint32_t group;
+     uint32_t first;
+     uint32_t last;
+
+     uint32_t size() const { return last - first + 1; }
+};
+
+struct LinkClass {
+     std::string dataRate;
+     std::string delay;
+};
+
+struct LinkDecl {
+     std::string linkClass;
+     NodeRef a;
+     NodeRef b;
+};
+
+struct AppDecl {
+     bool server;
+     NodeRef node;
+     NodeRef target;
+     double start;
+     double stop;
+     bool defaultArguments;
+     std::vector<std::string> arguments;
+};
+
+/**
+* Topology and applications read from a scenario file.
+*/
+struct ScenarioDescription {
+     std::vector<std::string> groupNames;
+     std::vector<uint32_t> groupSizes;
+     std::map<std::string, uint32_t> groups;
+     std::map<std::string, LinkClass> classes;
+     std::vector<LinkDecl> links;
+     bool epc;
+     NodeRef remote;
+     std::string remoteClass;
+     std::vector<NodeRef> enbs;
+     std::vector<std::pair<NodeRef, NodeRef> > ues;
+     std::vector<std::pair<NodeRef, std::string> > labels;
+     std::vector<AppDecl> apps;
+};
+
+/**
+* Reads scenario files. One statement per line, '#' starts a comment:
+*
+*   class <name> [DataRate=<rate>] [Delay=<delay>]
+*   nodes <group> [<count>]
+*   link <class> <ref> <ref>
+*   epc <remote-ref> [class=<class>]
+*   enb <ref>
+*   ue <ue-ref> <enb-ref>
+*   label <ref> <label>
+*   server <ref> [start=<sec>] [stop=<sec>] [args=<arg>,<arg>,...]
+*   client <ref> <target-ref> [start=<sec>] [stop=<sec>] [args=<arg>,...]
+*
+* Groups and classes have to be declared before they are used. Two
+* references of a link or client are paired by index if they have the same
+* size, a single node is paired with every node of the other reference.
+* Arguments containing spaces or commas are quoted with double quotes.
+*/
+class ScenarioFile {
+public:
+     static bool parse(std::string const& fileName, ScenarioDescription& description,
+                       std::vector<std::string>& errors);
+     static bool parseText(std::string const& text, std::string const& fileName,
+                           ScenarioDescription& description, std::vector<std::string>& errors);
+     static bool pairRefs(NodeRef const& a, NodeRef const& b, uint32_t& pairs);
+};
+
+#endif /* SCENARIO_FILE_H_ */
@@ -0,0 +1,279 @@
+#include "scenario.h"
+#include "scenarios.h"
+#include "../utils/ip-helper.h"
+
+#include <algorithm>
+#include <set>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("Scenario");
+
+ScenarioConfig::ScenarioConfig() :
+     server("simple-iec61850-server"),
+     client("simple-iec61850-client"),
+     dataRate("5Mbps"),
+     delay("2ms"),
+     duration(15.0),
+     nSpokes(4),
+     starHub("router"),
+     switchPortRate(""),
+     switchUplinkRate(""),
+     switchQueueSize(100),
+     nUes(2),
+     nEnbs(7),
+     lteGateways(1),
+     lteLayout("hex"),
+     lteSiteDistance(500.0),
+     uePlacement("cell"),
+     uePositions(""),
+     lteBandwidth(25),
+     lteScheduler("pf"),
+     lteDeadlines(""),
+     lteSpsPeriod(0),
+     lteSpsRbs(10),
+     lteGrantFile(""),
+     ltePathloss("ns3::FriisPropagationLossModel"),
+     lteCutoff(0.0),
+     lteModel("full"),
+     lteTrace(""),
+     lteDelayCsv(""),
+     lteBearers(""),
+     lteBearerKpiFile(""),
+     linkQueue(""),
+     linkDscp("goose=46,mms=34,reports=26,file=10"),
+     linkWeights("8,4,2,1"),
+     linkQueueKpiFile(""),
+     redundancy(true),
+     linkFailures(""),
+     redundancyKpiFile(""),
+     pcapTracing(false),
+     asciiTracing(false),
+     animTracing(false),
+     lteTracing(false),
+     filePrefix("scenario"),
+     scenarioFile(""),
+     sclFile(""),
+     sclClient("") {
+}
+
+Scenario::~Scenario() {
+}
+
+// Function to set the defaults of the scenario, the name is the file prefix
+void Scenario::setDefaults(ScenarioConfig& config) const {
+     string prefix = getName();
+     prefix.erase(remove(prefix.begin(), prefix.end(), '-'), prefix.end());
+     config.filePrefix = prefix;
+}
+
+// Function to enable pcap and ASCII tracing on all P2P devices
+void Scenario::enableTracing(ScenarioConfig const& config) {
+     if (config.pcapTracing) {
+          NS_LOG_INFO ("Enabling pcap tracing.");
+          m_pointToPoint.EnablePcapAll (config.filePrefix, false);
+     }
+     if (config.asciiTracing) {
+          NS_LOG_INFO ("Enabling ASCII tracing.");
+          AsciiTraceHelper ascii;
+          m_pointToPoint.EnableAsciiAll (ascii.CreateFileStream (config.filePrefix + ".tr"));
+     }
+}
+
+// Function to write the results of the scenario after the simulation, the link queues and the switch if installed
+void Scenario::finish(ScenarioConfig const& config) {
+     if (m_switch) {
+          m_switch->report ();
+     }
+     if (m_linkQueues.isEnabled()) {
+          m_linkQueues.report ();
+     }
+     if (m_linkQueues.isEnabled() && ! config.linkQueueKpiFile.empty()) {
+          NS_LOG_INFO ("Writing link queue KPIs to " << config.linkQueueKpiFile);
+          m_linkQueues.writeKpi (config.linkQueueKpiFile);
+     }
+}
+
+NodeContainer const& Scenario::getDceNodes() const {
+     return m_dceNodes;
+}
+
+vector<ScenarioApp> const& Scenario::getApps() const {
+     return m_apps;
+}
+
+map<uint32_t, string> const& Scenario::getLabels() const {
+     return m_labels;
+}
+
+// Function to get the nodes running a server or a client, every node once
+NodeContainer Scenario::getAppNodes(bool server) const {
+     NodeContainer nodes;
+     set<uint32_t> added;
+     for (size_t i = 0; i < m_apps.size(); ++i) {
+          if (m_apps[i].server == server && added.insert(m_apps[i].node->GetId ()).second) {
+               nodes.Add (m_apps[i].node);
+          }
+     }
+     return nodes;
+}
+
+// Function to get the GOOSE publishers, by default every node running a server
+NodeContainer Scenario::getGoosePublishers() const {
+     return getAppNodes(true);
+}
+
+// Function to get the GOOSE subscribers, by default every node running a server
+NodeContainer Scenario::getGooseSubscribers() const {
+     return getAppNodes(true);
+}
+
+// Function to get the sampled values publishers (merging units), by default every node running a server
+NodeContainer Scenario::getSvPublishers() const {
+     return getAppNodes(true);
+}
+
+// Function to get the sampled values subscribers, by default every node running a client
+NodeContainer Scenario::getSvSubscribers() const {
+     return getAppNodes(false);
+}
+
+// Function to create a scenario by its name, returns 0 for unknown names
+Scenario* Scenario::create(string const& name) {
+     if (name == "simple-p2p") {
+          return new SimpleP2pScenario();
+     } else if (name == "simple-star") {
+          return new SimpleStarScenario();
+     } else if (name == "generic-star") {
+          return new GenericStarScenario();
+     } else if (name == "simple-tree") {
+          return new SimpleTreeScenario();
+     } else if (name == "template") {
+          return new TemplateScenario();
+     } else if (name == "simple-lte") {
+          return new SimpleLteScenario();
+     } else if (name == "generic-lte") {
+          return new GenericLteScenario();
+     } else if (name == "multiple-lte") {
+          return new MultipleLteScenario();
+     } else if (name == "mixed-lte") {
+          return new MixedLteScenario();
+     } else if (name == "cellular-lte") {
+          return new CellularLteScenario();
+     } else if (name == "file") {
+          return new FileScenario();
+     } else if (name == "scd") {
+          return new SclScenario();
+     } else if (name == "prp") {
+          return new PrpScenario();
+     } else if (name == "hsr") {
+          return new HsrScenario();
+     }
+     return 0;
+}
+
+// Function to get the names of all scenarios
+vector<string> Scenario::getNames() {
+     const char* names[] = { "simple-p2p", "simple-star", "generic-star", "simple-tree", "template",
+                             "simple-lte", "generic-lte", "multiple-lte", "mixed-lte", "cellular-lte", "file",
+                             "scd", "prp", "hsr" };
+     return vector<string>(names, names + sizeof(names) / sizeof(names[0]));
+}
+
+// Function to add the IEC61850 server with the default arguments
+void Scenario::addServer(Ptr<Node> node, Time start) {
+     vector<string> arguments;
+     arguments.push_back("-p 10102");
+     arguments.push_back("-w 36");
+     arguments.push_back("-v");
+     addApp(node, true, arguments, start, Time ());
+}
+
+// Function to add an IEC61850 client which polls the given server every second
+void Scenario::addClient(Ptr<Node> node, Ptr<Node> server, Time start) {
+     addClient(node, IpHelper::getIp(server), start);
+}
+
+// Function to add an IEC61850 client which polls the server at the address every second
+void Scenario::addClient(Ptr<Node> node, string const& address, Time start) {
+     vector<string> arguments;
+     arguments.push_back("-s 1");
+     arguments.push_back("-p 10102");
+     arguments.push_back(address);
+     addApp(node, false, arguments, start, Time ());
+}
+
+// Function to add a DCE process, a zero stop time runs until the end
+void Scenario::addApp(Ptr<Node> node, bool server, vector<string> const& arguments, Time start, Time stop) {
+     ScenarioApp app;
+     app.node = node;
+     app.server = server;
+     app.arguments = arguments;
+     app.start = start;
+     app.stop = stop;
+     m_apps.push_back(app);
+}
+
+// Function to name the role of a node (e.g. hub, enb or pgw)
+void Scenario::setLabel(Ptr<Node> node, string const& label) {
+     m_labels[node->GetId ()] = label;
+}
+
+// Function to configure the P2P helper used for the links and for tracing
+void Scenario::setPointToPoint(ScenarioConfig const& config) {
+     m_pointToPoint.SetDeviceAttribute ("DataRate", StringValue (config.dataRate));
+     m_pointToPoint.SetChannelAttribute ("Delay", StringValue (config.delay));
+     if (! config.linkQueue.empty()) {
+          // the packets wait in the queue disc, where they are scheduled, instead of the device
+          m_pointToPoint.SetQueue ("ns3::DropTailQueue<Packet>", "MaxSize", StringValue ("1p"));
+     }
+}
+
+// Function to install the class queue discs on the point-to-point devices of the nodes, after the addresses
+void Scenario::installLinkQueues(ScenarioConfig const& config, NodeContainer const& nodes) {
+     if (config.linkQueue.empty()) {
+          return;
+     }
+     m_linkQueues.configure (config.linkQueue, config.linkDscp, config.linkWeights);
+     m_linkQueues.install (nodes);
+}
+
+// Function to check the hub of the star topologies, true for a switch
+bool Scenario::useSwitch(ScenarioConfig const& config) const {
+     NS_ABORT_MSG_UNLESS (config.starHub == "router" || config.starHub == "switch",
+                          "Unknown star hub " << config.starHub << " (router, switch)");
+     return config.starHub == "switch";
+}
+
+// Function to connect the stations to a switch on the hub node in one subnet, the last station over the uplink port
+void Scenario::buildSwitch(ScenarioConfig const& config, Ptr<Node> hub, NodeContainer const& stations) {
+     NS_LOG_INFO ("Building switched station bus with " << stations.GetN () << " ports.");
+     m_switch = CreateObject<EthernetSwitch> ();
+     m_switch->SetAttribute ("MaxPackets", UintegerValue (config.switchQueueSize));
+     hub->AggregateObject (m_switch);
+
+     string portRate = config.switchPortRate.empty() ? config.dataRate : config.switchPortRate;
+     string uplinkRate = config.switchUplinkRate.empty() ? portRate : config.switchUplinkRate;
+     NetDeviceContainer stationDevices;
+     for (uint32_t i = 0; i < stations.GetN (); ++i) {
+          m_pointToPoint.SetDeviceAttribute ("DataRate", StringValue (i + 1 < stations.GetN () ? portRate : uplinkRate));
+          NetDeviceContainer devices = m_pointToPoint.Install (hub, stations.Get (i));
+          m_switch->addPort(devices.Get (0));
+          stationDevices.Add (devices.Get (1));
+     }
+     setPointToPoint(config);
+
+     // the hub has no IP stack, the stations share one subnet
+     InternetStackHelper stack;
+     stack.Install (stations);
+     Ipv4AddressHelper address;
+     address.SetBase ("10.1.0.0", "255.255.0.0");
+     address.Assign (stationDevices);
+     // the stations drop the flooded frames of the others instead of routing them back to the switch
+     for (uint32_t i = 0; i < stations.GetN (); ++i) {
+          Ptr<Ipv4> ipv4 = stations.Get (i)->GetObject<Ipv4> ();
+          ipv4->SetForwarding (ipv4->GetInterfaceForDevice (stationDevices.Get (i)), false);
+     }
+     setLabel(hub, "switch");
+}
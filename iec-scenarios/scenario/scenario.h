@@ -0,0 +1,127 @@
+#ifndef SCENARIO_H_
+#define SCENARIO_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/point-to-point-module.h"
+#include "../utils/link-queue-helper.h"
+#include "../utils/ethernet-switch.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Parameters shared by all scenarios. A scenario sets its defaults, the
+* command line overrides them afterwards.
+*/
+struct ScenarioConfig {
+     ScenarioConfig();
+
+     std::string server;
+     std::string client;
+     std::string dataRate;
+     std::string delay;
+     double duration;
+     uint32_t nSpokes;
+     std::string starHub;
+     std::string switchPortRate;
+     std::string switchUplinkRate;
+     uint32_t switchQueueSize;
+     uint32_t nUes;
+     uint32_t nEnbs;
+     uint32_t lteGateways;
+     std::string lteLayout;
+     double lteSiteDistance;
+     std::string uePlacement;
+     std::string uePositions;
+     uint32_t lteBandwidth;
+     std::string lteScheduler;
+     std::string lteDeadlines;
+     uint32_t lteSpsPeriod;
+     uint32_t lteSpsRbs;
+     std::string lteGrantFile;
+     std::string ltePathloss;
+     double lteCutoff;
+     std::string lteModel;
+     std::string lteTrace;
+     std::string lteDelayCsv;
+     std::string lteBearers;
+     std::string lteBearerKpiFile;
+     std::string linkQueue;
+     std::string linkDscp;
+     std::string linkWeights;
+     std::string linkQueueKpiFile;
+     bool redundancy;
+     std::string linkFailures;
+     std::string redundancyKpiFile;
+     bool pcapTracing;
+     bool asciiTracing;
+     bool animTracing;
+     bool lteTracing;
+     std::string filePrefix;
+     std::string scenarioFile;
+     std::string sclFile;
+     std::string sclClient;
+};
+
+/**
+* DCE process which is launched by a scenario.
+*/
+struct ScenarioApp {
+     ns3::Ptr<ns3::Node> node;
+     bool server;
+     std::vector<std::string> arguments;
+     ns3::Time start;
+     ns3::Time stop;
+};
+
+/**
+* Base class of all topologies. A scenario builds its nodes, links and
+* addresses and describes which DCE processes run on which node. Setup,
+* tracing, configuration and the installation of the processes are shared
+* by the main program.
+*/
+class Scenario {
+public:
+     virtual ~Scenario();
+     virtual std::string getName() const = 0;
+     virtual std::string getDescription() const = 0;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config) = 0;
+     virtual void enableTracing(ScenarioConfig const& config);
+     virtual void finish(ScenarioConfig const& config);
+
+     ns3::NodeContainer const& getDceNodes() const;
+     std::vector<ScenarioApp> const& getApps() const;
+     std::map<uint32_t, std::string> const& getLabels() const;
+     ns3::NodeContainer getAppNodes(bool server) const;
+     virtual ns3::NodeContainer getGoosePublishers() const;
+     virtual ns3::NodeContainer getGooseSubscribers() const;
+     virtual ns3::NodeContainer getSvPublishers() const;
+     virtual ns3::NodeContainer getSvSubscribers() const;
+
+     static Scenario* create(std::string const& name);
+     static std::vector<std::string> getNames();
+
+protected:
+     void addServer(ns3::Ptr<ns3::Node> node, ns3::Time start);
+     void addClient(ns3::Ptr<ns3::Node> node, ns3::Ptr<ns3::Node> server, ns3::Time start);
+     void addClient(ns3::Ptr<ns3::Node> node, std::string const& address, ns3::Time start);
+     void addApp(ns3::Ptr<ns3::Node> node, bool server, std::vector<std::string> const& arguments,
+                 ns3::Time start, ns3::Time stop);
+     void setLabel(ns3::Ptr<ns3::Node> node, std::string const& label);
+     void setPointToPoint(ScenarioConfig const& config);
+     void installLinkQueues(ScenarioConfig const& config, ns3::NodeContainer const& nodes);
+     bool useSwitch(ScenarioConfig const& config) const;
+     void buildSwitch(ScenarioConfig const& config, ns3::Ptr<ns3::Node> hub, ns3::NodeContainer const& stations);
+
+     ns3::NodeContainer m_dceNodes;
+     ns3::PointToPointHelper m_pointToPoint;
+     std::vector<ScenarioApp> m_apps;
+     std::map<uint32_t, std::string> m_labels;
+     LinkQueueHelper m_linkQueues;
+     ns3::Ptr<EthernetSwitch> m_switch;
+};
+
+#endif /* SCENARIO_H_ */
@@ -0,0 +1,337 @@
+#ifndef SCENARIOS_H_
+#define SCENARIOS_H_
+
+#include "scenario.h"
+#include "scenario-file.h"
+#include "scl-file.h"
+#include "../utils/trace-link.h"
+#include "../utils/lte-delay-recorder.h"
+#include "../utils/interference-cutoff.h"
+#include "../utils/deadline-scheduler.h"
+#include "../utils/qos-helper.h"
+#include "../utils/link-load-helper.h"
+#include "../utils/redundancy-helper.h"
+#include "ns3/lte-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/csma-module.h"
+#include <set>
+
+// ===========================================================================
+//
+//                   P2P
+//           client ----- server
+//
+// 2 nodes : IEC61850 Client and Server
+// ===========================================================================
+class SimpleP2pScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//           client
+//             |
+//           router
+//            /|\
+//           / | \
+//          s1 s2 s3
+//
+// Star topology : One IEC61850 client and three servers
+// ===========================================================================
+class SimpleStarScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//        n2 n3 n4
+//         \ | /
+//          \|/
+//     n1--- n0---n5
+//          /|\
+//         / | \
+//        n8 n7 n6
+//
+// Star topology : One IEC61850 client and nSpokes-1 servers around a hub
+// ===========================================================================
+class GenericStarScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//           client
+//             |
+//             r1
+//           /   \
+//         r2     r3
+//        /\      /\
+//      s1  s2  s3  s4
+//
+// Tree topology : One IEC61850 client and four servers
+// ===========================================================================
+class SimpleTreeScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+// No Topology, only a template with one node running the server.
+// ===========================================================================
+class TemplateScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+/**
+* Base class of the LTE scenarios: EPC, one remote host connected to the
+* PGW over P2P and UEs attached to eNBs.
+*/
+class LteScenario : public Scenario {
+public:
+     LteScenario();
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void enableTracing(ScenarioConfig const& config);
+     virtual void finish(ScenarioConfig const& config);
+
+protected:
+     void configureLte(ScenarioConfig const& config);
+     void buildEpc(ScenarioConfig const& config);
+     void buildRadio(uint32_t nEnbs, uint32_t nUes);
+     void attachUes(bool strongestCell = false);
+     void reportGrants(std::string const& fileName) const;
+     ns3::Ptr<ns3::Node> getControlCenter(uint32_t ue) const;
+
+     ns3::Ptr<ns3::LteHelper> m_lteHelper;
+     ns3::Ptr<ns3::PointToPointEpcHelper> m_epcHelper;
+     // trace driven links instead of radio and EPC, the gateway replaces the PGW
+     bool m_traceLinks;
+     TraceLinkHelper m_traceLinkHelper;
+     std::string m_traceFile;
+     ns3::Ptr<ns3::Node> m_gateway;
+     // delays between UEs and PGW of the full model, for the calibration of the traces and per traffic class
+     bool m_recordDelays;
+     LteDelayRecorder m_delayRecorder;
+     QosHelper m_qosHelper;
+     InterferenceCutoffHelper m_cutoffHelper;
+     ns3::InternetStackHelper m_internet;
+     ns3::Ipv4StaticRoutingHelper m_routingHelper;
+     // one control center per regional gateway link, the region of every UE
+     ns3::NodeContainer m_remoteHosts;
+     std::vector<uint32_t> m_ueRegions;
+     LinkLoadHelper m_gatewayLoad;
+     ns3::NodeContainer m_enbNodes;
+     ns3::NodeContainer m_ueNodes;
+     ns3::NetDeviceContainer m_enbDevs;
+     ns3::NetDeviceContainer m_ueDevs;
+};
+
+// ===========================================================================
+//
+//  ue1 -- enb -- PGW ---------- RH
+//
+// One UE server and the client on the remote host
+// ===========================================================================
+class SimpleLteScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//  ue1..ueN -- enb -- PGW ---------- RH
+//
+// nUEs servers and one client per server on the remote host
+// ===========================================================================
+class GenericLteScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//  ue1 -- enb1 --\
+//                 PGW ---------- RH
+//  ue2 -- enb2 --/
+//
+// Two cells with one UE server each
+// ===========================================================================
+class MultipleLteScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//  ue1 -- enb -- PGW ---------- RH
+//                               |
+//                               s1
+//
+// One UE server and one P2P server behind the remote host
+// ===========================================================================
+class MixedLteScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//   enb1..enbN (hex or grid sites) -- PGW ---------- RH
+//      ue1..ueM (placed around the sites or from a file)
+//
+// nEnbs cells, nUEs servers attached to the strongest cell and one client
+// per server on the remote host
+// ===========================================================================
+class CellularLteScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+
+private:
+     void placeNodes(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+// Topology, LTE cells and applications read from the scenario file given
+// by --ScenarioFile, see scenario-file.h for the statements.
+// ===========================================================================
+class FileScenario : public LteScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void build(ScenarioConfig const& config);
+     virtual void enableTracing(ScenarioConfig const& config);
+
+private:
+     ns3::Ptr<ns3::Node> getNode(NodeRef const& ref, uint32_t index) const;
+     void buildLinks(ScenarioDescription const& description);
+     void buildLte(ScenarioDescription const& description, ScenarioConfig const& config);
+     void buildApps(ScenarioDescription const& description);
+
+     std::vector<ns3::NodeContainer> m_groups;
+};
+
+// ===========================================================================
+//
+//   IED1   IED2   IED3        IED4   IED5
+//    |      |      |           |      |
+//  ==+======+======+==+==    ==+======+==+==
+//     SubNetwork 1    |        SubNetwork 2
+//                   client ------------'
+//
+// IEDs, subnetworks and addresses imported from the SCL file given by
+// --SclFile. Every subnetwork with IP addresses is a CSMA LAN, every IED
+// with an address runs a server, the client polls all of them.
+// ===========================================================================
+class SclScenario : public Scenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void build(ScenarioConfig const& config);
+     virtual void enableTracing(ScenarioConfig const& config);
+     virtual ns3::NodeContainer getGoosePublishers() const;
+     virtual ns3::NodeContainer getSvPublishers() const;
+
+     SclDescription const& getScl() const;
+
+private:
+     void buildSubnet(SclSubnet const& subnet, ScenarioConfig const& config, ns3::Ptr<ns3::Node> client);
+
+     SclDescription m_description;
+     ns3::NodeContainer m_ieds;
+     ns3::CsmaHelper m_csma;
+     std::vector<std::pair<ns3::Ptr<ns3::Node>, std::string> > m_servers;
+     std::set<uint32_t> m_serverIeds;
+};
+
+/**
+* Base class of the IEC 62439-3 topologies: every station is a doubly
+* attached node with two ports, the links can fail by --LinkFailures.
+*/
+class RedundancyScenario : public Scenario {
+public:
+     virtual void setDefaults(ScenarioConfig& config) const;
+     virtual void finish(ScenarioConfig const& config);
+
+protected:
+     void configureRedundancy(ScenarioConfig const& config, std::string const& mode);
+     void assignAddresses(ScenarioConfig const& config, ns3::NodeContainer const& stations);
+     void addApps(ns3::NodeContainer const& stations);
+
+     RedundancyHelper m_redundancy;
+     ns3::NetDeviceContainer m_devices;
+     std::vector<ns3::Ptr<EthernetSwitch> > m_switches;
+};
+
+// ===========================================================================
+//
+//      LAN A  ===+======+======+===   (switch)
+//                |      |      |
+//               s1     s2   client
+//                |      |      |
+//      LAN B  ===+======+======+===   (switch)
+//
+// PRP : nSpokes doubly attached stations on two independent switched LANs,
+// links a<i> and b<i> from station i to the switches
+// ===========================================================================
+class PrpScenario : public RedundancyScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+// ===========================================================================
+//
+//             r0
+//         n0 ---- n1
+//    r5  /          \  r1
+//      n5            n2
+//    r4  \          /  r2
+//         n4 ---- n3
+//             r3
+//
+// HSR : ring of nSpokes doubly attached stations, link r<i> from station i
+// to station i+1, the client on the last station
+// ===========================================================================
+class HsrScenario : public RedundancyScenario {
+public:
+     virtual std::string getName() const;
+     virtual std::string getDescription() const;
+     virtual void build(ScenarioConfig const& config);
+};
+
+#endif /* SCENARIOS_H_ */
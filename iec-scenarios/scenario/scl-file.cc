@@ -0,0 +1,362 @@
+#include "scl-file.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <sstream>
+
+using namespace std;
+
+// bytes read from the file at once
+static const size_t CHUNK_SIZE = 1 << 16;
+// longest start tag with its attributes, longer tags are an error
+static const size_t MAX_TAG = 1 << 20;
+// longest text of a P or BitRate element which is kept
+static const size_t MAX_TEXT = 256;
+
+// Function to replace the predefined XML entities and character references
+static string decodeEntities(string const& text) {
+     if (text.find('&') == string::npos) {
+          return text;
+     }
+     string result;
+     for (size_t i = 0; i < text.size(); ++i) {
+          size_t semicolon = text[i] == '&' ? text.find(';', i) : string::npos;
+          if (semicolon == string::npos) {
+               result += text[i];
+               continue;
+          }
+          string entity = text.substr(i + 1, semicolon - i - 1);
+          if (entity == "amp") {
+               result += '&';
+          } else if (entity == "lt") {
+               result += '<';
+          } else if (entity == "gt") {
+               result += '>';
+          } else if (entity == "quot") {
+               result += '"';
+          } else if (entity == "apos") {
+               result += '\'';
+          } else if (entity.size() > 1 && entity[0] == '#') {
+               long code = entity[1] == 'x' ? strtol(entity.c_str() + 2, 0, 16) : strtol(entity.c_str() + 1, 0, 10);
+               result += (char) code;
+          } else {
+               result += text.substr(i, semicolon - i + 1);
+          }
+          i = semicolon;
+     }
+     return result;
+}
+
+// Function to remove the namespace prefix of an element or attribute name
+static string localName(string const& name) {
+     size_t colon = name.find(':');
+     return colon == string::npos ? name : name.substr(colon + 1);
+}
+
+// elements of the communication section, all other elements are OTHER
+enum Element { OTHER, SCL, IED, COMMUNICATION, SUBNETWORK, BITRATE, CONNECTED_AP, GSE, SMV, ADDRESS, P };
+
+// Function to get the element of a local name, the data model elements are OTHER
+static Element elementOf(char const* name, size_t length) {
+     static char const* names[] = { "", "SCL", "IED", "Communication", "SubNetwork", "BitRate",
+                                    "ConnectedAP", "GSE", "SMV", "Address", "P" };
+     for (size_t i = 1; i < sizeof(names) / sizeof(names[0]); ++i) {
+          if (strlen(names[i]) == length && memcmp(names[i], name, length) == 0) {
+               return (Element) i;
+          }
+     }
+     return OTHER;
+}
+
+/**
+* Handles the elements of the SCL file while the file is scanned. Only the
+* path of the open elements and the text of the current P or BitRate
+* element are kept.
+*/
+class SclReader {
+public:
+     SclReader(SclDescription& description) : m_description(description), m_collect(false) {}
+
+     // Function to handle a complete tag without the angle brackets
+     void handleTag(string const& tag) {
+          if (tag.empty() || tag[0] == '?' || tag[0] == '!') {
+               return;
+          }
+          if (tag[0] == '/') {
+               endElement();
+               return;
+          }
+          bool selfClosing = tag[tag.size() - 1] == '/';
+          size_t end = tag.find_first_of(" \t\r\n/");
+          size_t begin = tag.rfind(':', end == string::npos ? tag.size() : end);
+          begin = begin == string::npos ? 0 : begin + 1;
+          Element element = elementOf(tag.data() + begin, (end == string::npos ? tag.size() : end) - begin);
+          // the attributes of the data model elements are not needed
+          map<string, string> attributes;
+          if (element != OTHER && element != SCL && element != COMMUNICATION && element != ADDRESS) {
+               parseAttributes(tag, end, attributes);
+          }
+          startElement(element, attributes);
+          if (selfClosing) {
+               endElement();
+          }
+     }
+
+     // Function to add text between tags, kept only inside P and BitRate
+     void addText(char c) {
+          if (m_collect && m_text.size() < MAX_TEXT) {
+               m_text += c;
+          }
+     }
+
+     bool collecting() const {
+          return m_collect;
+     }
+
+     bool balanced() const {
+          return m_path.empty();
+     }
+
+private:
+     // Function to read the name="value" pairs of a tag
+     void parseAttributes(string const& tag, size_t position, map<string, string>& attributes) {
+          while (position != string::npos && position < tag.size()) {
+               size_t equal = tag.find('=', position);
+               if (equal == string::npos) {
+                    return;
+               }
+               size_t nameBegin = tag.find_first_not_of(" \t\r\n", position);
+               size_t nameEnd = tag.find_last_not_of(" \t\r\n", equal - 1);
+               size_t quote = tag.find_first_of("\"'", equal);
+               if (quote == string::npos || nameBegin > nameEnd) {
+                    return;
+               }
+               size_t close = tag.find(tag[quote], quote + 1);
+               if (close == string::npos) {
+                    return;
+               }
+               attributes[localName(tag.substr(nameBegin, nameEnd - nameBegin + 1))] =
+                    decodeEntities(tag.substr(quote + 1, close - quote - 1));
+               position = close + 1;
+          }
+     }
+
+     // Function to get the index of an IED, unknown IEDs are added
+     uint32_t iedIndex(string const& name) {
+          map<string, uint32_t>::iterator it = m_iedIndex.find(name);
+          if (it != m_iedIndex.end()) {
+               return it->second;
+          }
+          uint32_t index = m_description.ieds.size();
+          m_iedIndex[name] = index;
+          m_description.ieds.push_back(name);
+          return index;
+     }
+
+     bool hasAccessPoint() const {
+          return ! m_description.subnets.empty() && ! m_description.subnets.back().accessPoints.empty();
+     }
+
+     Element parent(size_t level) const {
+          return m_path.size() > level ? m_path[m_path.size() - 1 - level] : OTHER;
+     }
+
+     void startElement(Element element, map<string, string>& attributes) {
+          Element up = parent(0);
+          if (element == IED && up == SCL) {
+               iedIndex(attributes["name"]);
+          } else if (element == SUBNETWORK && up == COMMUNICATION) {
+               SclSubnet subnet;
+               subnet.name = attributes["name"];
+               subnet.type = attributes["type"];
+               m_description.subnets.push_back(subnet);
+          } else if (element == BITRATE && up == SUBNETWORK) {
+               m_multiplier = attributes["multiplier"];
+               startText();
+          } else if (element == CONNECTED_AP && up == SUBNETWORK && ! m_description.subnets.empty()) {
+               SclAccessPoint accessPoint;
+               accessPoint.ied = iedIndex(attributes["iedName"]);
+               accessPoint.apName = attributes["apName"];
+               m_description.subnets.back().accessPoints.push_back(accessPoint);
+          } else if ((element == GSE || element == SMV) && up == CONNECTED_AP && hasAccessPoint()) {
+               SclControlBlock block;
+               block.ied = m_description.subnets.back().accessPoints.back().ied;
+               block.sampledValues = element == SMV;
+               block.ldInst = attributes["ldInst"];
+               block.cbName = attributes["cbName"];
+               m_description.controlBlocks.push_back(block);
+          } else if (element == P && up == ADDRESS) {
+               m_type = attributes["type"];
+               startText();
+          }
+          m_path.push_back(element);
+     }
+
+     void endElement() {
+          if (m_path.empty()) {
+               return;
+          }
+          Element element = m_path.back();
+          m_path.pop_back();
+          if (element == BITRATE && m_collect && ! m_description.subnets.empty()) {
+               m_description.subnets.back().bitRate = endText() + m_multiplier + "bps";
+          } else if (element == P && m_collect) {
+               string value = endText();
+               Element owner = parent(1);
+               if (owner == CONNECTED_AP && hasAccessPoint()) {
+                    SclAccessPoint& accessPoint = m_description.subnets.back().accessPoints.back();
+                    if (m_type == "IP") {
+                         accessPoint.ip = value;
+                    } else if (m_type == "IP-SUBNET") {
+                         accessPoint.mask = value;
+                    }
+               } else if ((owner == GSE || owner == SMV) && ! m_description.controlBlocks.empty()) {
+                    SclControlBlock& block = m_description.controlBlocks.back();
+                    if (m_type == "MAC-Address") {
+                         block.mac = value;
+                    } else if (m_type == "APPID") {
+                         block.appId = value;
+                    } else if (m_type == "VLAN-ID") {
+                         block.vlanId = value;
+                    } else if (m_type == "VLAN-PRIORITY") {
+                         block.vlanPriority = value;
+                    }
+               }
+          }
+     }
+
+     void startText() {
+          m_collect = true;
+          m_text.clear();
+     }
+
+     // Function to stop collecting and return the trimmed text
+     string endText() {
+          m_collect = false;
+          size_t first = m_text.find_first_not_of(" \t\r\n");
+          size_t last = m_text.find_last_not_of(" \t\r\n");
+          return first == string::npos ? "" : decodeEntities(m_text.substr(first, last - first + 1));
+     }
+
+     SclDescription& m_description;
+     map<string, uint32_t> m_iedIndex;
+     vector<Element> m_path;
+     bool m_collect;
+     string m_text;
+     string m_type;
+     string m_multiplier;
+};
+
+// Function to scan an SCL file chunk by chunk and collect the communication section
+bool SclFile::parse(string const& fileName, SclDescription& description, string& error) {
+     FILE* file = fopen(fileName.c_str(), "rb");
+     if (file == 0) {
+          error = "cannot open SCL file " + fileName;
+          return false;
+     }
+
+     enum State { TEXT, TAG, COMMENT, CDATA };
+     State state = TEXT;
+     SclReader reader(description);
+     string tag;
+     char quote = 0;
+     size_t markers = 0;
+     uint64_t offset = 0;
+     char* buffer = new char[CHUNK_SIZE];
+     size_t n;
+     while (error.empty() && (n = fread(buffer, 1, CHUNK_SIZE, file)) > 0) {
+          for (size_t i = 0; i < n && error.empty(); ++i) {
+               char c = buffer[i];
+               switch (state) {
+               case TEXT:
+                    // skipping the text outside of P and BitRate in one step
+                    if (c != '<' && ! reader.collecting()) {
+                         char* next = (char*) memchr(buffer + i, '<', n - i);
+                         i = next == 0 ? n - 1 : next - buffer - 1;
+                         break;
+                    }
+                    if (c == '<') {
+                         state = TAG;
+                         tag.clear();
+                         quote = 0;
+                    } else {
+                         reader.addText(c);
+                    }
+                    break;
+               case TAG:
+                    // copying runs of plain characters at once
+                    if (! tag.empty() && tag[0] != '!') {
+                         size_t j = i;
+                         if (quote != 0) {
+                              while (j < n && buffer[j] != quote) {
+                                   ++j;
+                              }
+                         } else {
+                              while (j < n && buffer[j] != '>' && buffer[j] != '"' && buffer[j] != '\'') {
+                                   ++j;
+                              }
+                         }
+                         if (j > i) {
+                              tag.append(buffer + i, j - i);
+                              i = j - 1;
+                              break;
+                         }
+                    }
+                    if (quote != 0) {
+                         quote = c == quote ? 0 : quote;
+                    } else if (c == '"' || c == '\'') {
+                         quote = c;
+                    } else if (c == '>') {
+                         reader.handleTag(tag);
+                         state = TEXT;
+                         break;
+                    }
+                    tag += c;
+                    if (tag[0] == '!' && tag.size() == 3 && tag == "!--") {
+                         state = COMMENT;
+                         markers = 0;
+                    } else if (tag[0] == '!' && tag.size() == 8 && tag == "![CDATA[") {
+                         state = CDATA;
+                         markers = 0;
+                    } else if (tag.size() > MAX_TAG) {
+                         ostringstream message;
+                         message << fileName << ": tag longer than " << MAX_TAG << " bytes at offset " << offset + i;
+                         error = message.str();
+                    }
+                    break;
+               case COMMENT:
+                    // waiting for "-->"
+                    if (c == '>' && markers >= 2) {
+                         state = TEXT;
+                    }
+                    markers = c == '-' ? markers + 1 : 0;
+                    break;
+               case CDATA:
+                    // waiting for "]]>", the content is text
+                    if (c == '>' && markers >= 2) {
+                         state = TEXT;
+                    } else if (c != ']') {
+                         for (size_t j = 0; j < markers; ++j) {
+                              reader.addText(']');
+                         }
+                         reader.addText(c);
+                    }
+                    markers = c == ']' ? markers + 1 : 0;
+                    break;
+               }
+          }
+          offset += n;
+     }
+     delete[] buffer;
+     fclose(file);
+
+     if (error.empty() && (state != TEXT || ! reader.balanced())) {
+          error = fileName + ": unexpected end of file";
+     }
+     if (error.empty() && description.subnets.empty()) {
+          error = fileName + ": no SubNetwork in the Communication section";
+     }
+     return error.empty();
+}
@@ -0,0 +1,59 @@
+#ifndef SCL_FILE_H_
+#define SCL_FILE_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+/**
+* Access point of an IED in a subnetwork (ConnectedAP).
+*/
+struct SclAccessPoint {
+     uint32_t ied;
+     std::string apName;
+     std::string ip;
+     std::string mask;
+};
+
+/**
+* GOOSE or SV control block addressing (GSE or SMV of a ConnectedAP).
+*/
+struct SclControlBlock {
+     uint32_t ied;
+     bool sampledValues;
+     std::string ldInst;
+     std::string cbName;
+     std::string mac;
+     std::string appId;
+     std::string vlanId;
+     std::string vlanPriority;
+};
+
+struct SclSubnet {
+     std::string name;
+     std::string type;
+     std::string bitRate;
+     std::vector<SclAccessPoint> accessPoints;
+};
+
+/**
+* Communication section and IEDs of an SCL file (SCD, SSD, CID, ...).
+*/
+struct SclDescription {
+     std::vector<std::string> ieds;
+     std::vector<SclSubnet> subnets;
+     std::vector<SclControlBlock> controlBlocks;
+};
+
+/**
+* Streaming reader for SCL files. The file is read in fixed chunks, only the
+* Communication section and the names of the IEDs are kept, data models and
+* data type templates are skipped, so the memory does not grow with the size
+* of the file.
+*/
+class SclFile {
+public:
+     static bool parse(std::string const& fileName, SclDescription& description, std::string& error);
+};
+
+#endif /* SCL_FILE_H_ */
@@ -0,0 +1,220 @@
+#include "scenarios.h"
+#include "../utils/string-helper.h"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <set>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("SclScenario");
+
+// Function to check an address of the SCL file, returns it in host order
+static bool parseAddress(string const& text, uint32_t& address) {
+     struct in_addr parsed;
+     if (inet_aton(text.c_str(), &parsed) == 0) {
+          return false;
+     }
+     address = ntohl(parsed.s_addr);
+     return true;
+}
+
+// Function to format an address in host order
+static string formatAddress(uint32_t address) {
+     struct in_addr formatted;
+     formatted.s_addr = htonl(address);
+     return inet_ntoa(formatted);
+}
+
+// Function to add an interface with the given address to the node of the device
+static void assignAddress(Ptr<NetDevice> device, Ipv4Address address, Ipv4Mask mask) {
+     Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+     int32_t interface = ipv4->AddInterface (device);
+     ipv4->AddAddress (interface, Ipv4InterfaceAddress (address, mask));
+     ipv4->SetMetric (interface, 1);
+     ipv4->SetUp (interface);
+}
+
+string SclScenario::getName() const {
+     return "scd";
+}
+
+string SclScenario::getDescription() const {
+     return "IEDs, subnetworks and addresses imported from --SclFile";
+}
+
+SclDescription const& SclScenario::getScl() const {
+     return m_description;
+}
+
+// Function to get the IEDs with an address and a GSE control block as GOOSE publishers
+NodeContainer SclScenario::getGoosePublishers() const {
+     NodeContainer nodes;
+     set<uint32_t> added;
+     for (size_t i = 0; i < m_description.controlBlocks.size(); ++i) {
+          SclControlBlock const& block = m_description.controlBlocks[i];
+          if (! block.sampledValues && m_serverIeds.count(block.ied) && added.insert(block.ied).second) {
+               nodes.Add (m_ieds.Get (block.ied));
+          }
+     }
+     return nodes.GetN () > 0 ? nodes : Scenario::getGoosePublishers();
+}
+
+// Function to get the IEDs with an address and a SMV control block as sampled values publishers
+NodeContainer SclScenario::getSvPublishers() const {
+     NodeContainer nodes;
+     set<uint32_t> added;
+     for (size_t i = 0; i < m_description.controlBlocks.size(); ++i) {
+          SclControlBlock const& block = m_description.controlBlocks[i];
+          if (block.sampledValues && m_serverIeds.count(block.ied) && added.insert(block.ied).second) {
+               nodes.Add (m_ieds.Get (block.ied));
+          }
+     }
+     return nodes.GetN () > 0 ? nodes : Scenario::getSvPublishers();
+}
+
+// Function to enable pcap and ASCII tracing on the CSMA devices of the subnetworks
+void SclScenario::enableTracing(ScenarioConfig const& config) {
+     if (config.pcapTracing) {
+          NS_LOG_INFO ("Enabling pcap tracing.");
+          m_csma.EnablePcapAll (config.filePrefix, false);
+     }
+     if (config.asciiTracing) {
+          NS_LOG_INFO ("Enabling ASCII tracing.");
+          AsciiTraceHelper ascii;
+          m_csma.EnableAsciiAll (ascii.CreateFileStream (config.filePrefix + ".tr"));
+     }
+}
+
+void SclScenario::build(ScenarioConfig const& config) {
+     NS_ABORT_MSG_IF (config.sclFile.empty(), "The scd topology needs --SclFile");
+     NS_LOG_INFO ("Reading SCL file " + config.sclFile + ".");
+     string error;
+     NS_ABORT_MSG_UNLESS (SclFile::parse(config.sclFile, m_description, error), error);
+
+     NS_LOG_INFO ("Building SCL topology.");
+     InternetStackHelper internet;
+     m_ieds.Create (m_description.ieds.size());
+     internet.Install (m_ieds);
+     for (uint32_t i = 0; i < m_ieds.GetN (); ++i) {
+          setLabel(m_ieds.Get (i), m_description.ieds[i]);
+     }
+
+     // the client is an IED of the file or an extra node in every subnetwork
+     Ptr<Node> client;
+     if (config.sclClient.empty()) {
+          client = CreateObject<Node> ();
+          internet.Install (client);
+          setLabel(client, "client");
+     } else {
+          vector<string>::const_iterator it = find(m_description.ieds.begin(), m_description.ieds.end(), config.sclClient);
+          NS_ABORT_MSG_IF (it == m_description.ieds.end(), "Unknown client IED " + config.sclClient);
+          client = m_ieds.Get (it - m_description.ieds.begin());
+     }
+
+     for (size_t i = 0; i < m_description.subnets.size(); ++i) {
+          buildSubnet(m_description.subnets[i], config, config.sclClient.empty() ? client : Ptr<Node> ());
+     }
+     Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+
+     uint32_t nGoose = 0;
+     for (size_t i = 0; i < m_description.controlBlocks.size(); ++i) {
+          nGoose += m_description.controlBlocks[i].sampledValues ? 0 : 1;
+     }
+     NS_LOG_INFO ("IEDs: " + StringHelper::toString((uint32_t) m_description.ieds.size()));
+     NS_LOG_INFO ("Subnetworks: " + StringHelper::toString((uint32_t) m_description.subnets.size()));
+     NS_LOG_INFO ("GSE control blocks: " + StringHelper::toString(nGoose));
+     NS_LOG_INFO ("SMV control blocks: " + StringHelper::toString((uint32_t) m_description.controlBlocks.size() - nGoose));
+
+     // one server per IED with an address, polled by the client at its first address
+     m_dceNodes.Add (client);
+     for (size_t i = 0; i < m_servers.size(); ++i) {
+          if (m_servers[i].first == client) {
+               continue;
+          }
+          m_dceNodes.Add (m_servers[i].first);
+          addServer(m_servers[i].first, Seconds (1.0));
+     }
+     for (size_t i = 0; i < m_servers.size(); ++i) {
+          if (m_servers[i].first != client) {
+               addClient(client, m_servers[i].second, Seconds (5.0));
+          }
+     }
+}
+
+// Function to create the CSMA LAN of a subnetwork with the addresses of the SCL file,
+// access points without address get the next free one
+void SclScenario::buildSubnet(SclSubnet const& subnet, ScenarioConfig const& config, Ptr<Node> client) {
+     vector<SclAccessPoint const*> accessPoints;
+     string maskText;
+     uint32_t network = 0;
+     for (size_t i = 0; i < subnet.accessPoints.size(); ++i) {
+          SclAccessPoint const& accessPoint = subnet.accessPoints[i];
+          if (network == 0 && parseAddress(accessPoint.ip, network)) {
+               maskText = accessPoint.mask;
+          }
+          accessPoints.push_back(&accessPoint);
+     }
+     if (network == 0) {
+          NS_LOG_INFO ("Skipping subnetwork " + subnet.name + " without IP addresses.");
+          return;
+     }
+     uint32_t mask = 0xffffff00;
+     if (! maskText.empty()) {
+          NS_ABORT_MSG_UNLESS (parseAddress(maskText, mask), "Invalid IP-SUBNET " + maskText + " in " + subnet.name);
+     }
+     network &= mask;
+
+     // collecting the given addresses, duplicates are an error
+     set<uint32_t> used;
+     for (size_t i = 0; i < accessPoints.size(); ++i) {
+          uint32_t address;
+          if (accessPoints[i]->ip.empty()) {
+               continue;
+          }
+          NS_ABORT_MSG_UNLESS (parseAddress(accessPoints[i]->ip, address), "Invalid IP " + accessPoints[i]->ip
+                               + " of " + m_description.ieds[accessPoints[i]->ied]);
+          NS_ABORT_MSG_UNLESS ((address & mask) == network, "IP " + accessPoints[i]->ip + " outside of " + subnet.name);
+          NS_ABORT_MSG_UNLESS (used.insert(address).second, "Duplicate IP " + accessPoints[i]->ip + " in " + subnet.name);
+     }
+
+     NodeContainer members;
+     for (size_t i = 0; i < accessPoints.size(); ++i) {
+          members.Add (m_ieds.Get (accessPoints[i]->ied));
+     }
+     if (client) {
+          members.Add (client);
+     }
+     m_csma.SetChannelAttribute ("DataRate", StringValue (subnet.bitRate.empty() ? config.dataRate : subnet.bitRate));
+     m_csma.SetChannelAttribute ("Delay", StringValue (config.delay));
+     NetDeviceContainer devices = m_csma.Install (members);
+
+     uint32_t next = 1;
+     uint32_t last = ~mask - 1;
+     for (size_t i = 0; i < accessPoints.size(); ++i) {
+          uint32_t address;
+          if (! parseAddress(accessPoints[i]->ip, address)) {
+               while (next <= last && used.count(network | next)) {
+                    ++next;
+               }
+               NS_ABORT_MSG_IF (next > last, "No free address in " + subnet.name);
+               address = network | next;
+               used.insert(address);
+          }
+          assignAddress(devices.Get (i), Ipv4Address (address), Ipv4Mask (mask));
+          if (m_serverIeds.insert(accessPoints[i]->ied).second) {
+               m_servers.push_back(make_pair(m_ieds.Get (accessPoints[i]->ied), formatAddress(address)));
+          }
+     }
+
+     // the extra client takes the highest free address
+     if (client) {
+          while (last >= next && used.count(network | last)) {
+               --last;
+          }
+          NS_ABORT_MSG_IF (last < next, "No free address for the client in " + subnet.name);
+          assignAddress(devices.Get (devices.GetN () - 1), Ipv4Address (network | last), Ipv4Mask (mask));
+     }
+     NS_LOG_INFO ("Subnetwork " + subnet.name + ": " + StringHelper::toString((uint32_t) accessPoints.size()) + " access points.");
+}
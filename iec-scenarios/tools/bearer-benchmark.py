@@ -0,0 +1,110 @@
+#!/usr/bin/env python3
+"""Comparison of the LTE traffic classes with and without dedicated bearers.
+
+Simulates generic-lte with the IEC traffic and bulk file transfers from
+every UE, once with all traffic on the default bearer and once with the
+bearers of --bearers (--LteBearers), for every file size and several
+seeds. Prints the delay quantiles and the throughput per traffic class and
+direction from --LteBearerKpiFile, the delay quantiles are the means of
+the seeds weighted by their received packets.
+
+Example:
+    tools/bearer-benchmark.py --command "build/bin/dce-iec-scenarios" \\
+        --bearers "mms=3:64,goose=3:32,reports=7,file=9" --sizes 0,100000,1000000 \\
+        --runs 3 --jobs 8 --csv bearers.csv -- --nUEs=10 --Reports=true --Duration=30
+"""
+
+import argparse
+import csv
+
+from simrunner import SimRunner, read_kpis
+
+CLASSES = ["mms", "reports", "goose", "file", "other"]
+DIRECTIONS = ["ul", "dl"]
+COLUMNS = ["received", "p50_ms", "p99_ms", "max_ms", "kbps"]
+
+
+class Benchmark:
+    def __init__(self, options):
+        self.options = options
+        self.runner = SimRunner(options.command, options.jobs, options.verbose)
+        self.modes = {"default": [], "bearers": ["--LteBearers=" + options.bearers]}
+
+    def simulate(self, mode, size, run):
+        """Schedules one simulation, its result are the KPIs per traffic class."""
+        arguments = list(self.options.extra) + self.modes[mode]
+        arguments += ["--Topology=%s" % self.options.topology, "--RngRun=%d" % run,
+                      "--PollProbe=true", "--FileTransfer=%s" % ("true" if size > 0 else "false"),
+                      "--FileTransferSize=%d" % size]
+        return self.runner.submit(arguments, [("LteBearerKpiFile", read_kpis)])
+
+    @staticmethod
+    def evaluate(results):
+        """Combines the runs of a point into one row per class and direction."""
+        results = [result[0] for result in results if result is not None]
+        rows = []
+        for traffic_class in CLASSES:
+            for direction in DIRECTIONS:
+                prefix = "%s_%s_" % (traffic_class, direction)
+                received = sum(kpis.get(prefix + "received", 0) for kpis in results)
+                if not received:
+                    continue
+                row = {"received": received}
+                for name in ("p50_ms", "p99_ms", "max_ms"):
+                    row[name] = sum(kpis.get(prefix + name, 0.0) * kpis.get(prefix + "received", 0)
+                                    for kpis in results) / received
+                row["kbps"] = sum(kpis.get(prefix + "kbps", 0.0) for kpis in results) / len(results)
+                rows.append((traffic_class, direction, row))
+        return rows, len(results)
+
+    def run(self):
+        runs = range(1, self.options.runs + 1)
+        futures = dict(((mode, size, run), self.simulate(mode, size, run))
+                       for mode in self.modes for size in self.options.sizes for run in runs)
+        rows = []
+        for size in self.options.sizes:
+            for mode in self.modes:
+                class_rows, valid = self.evaluate([futures[(mode, size, run)].result() for run in runs])
+                for traffic_class, direction, row in class_rows:
+                    rows.append((size, mode, valid, traffic_class, direction, row))
+        self.runner.shutdown()
+        return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="dce-iec-scenarios",
+                        help="command running the simulation")
+    parser.add_argument("--topology", default="generic-lte", help="LTE topology")
+    parser.add_argument("--bearers", default="mms=3:64,goose=3:32,reports=7,file=9",
+                        help="dedicated bearers as \"class=qci[:kbps],...\"")
+    parser.add_argument("--sizes", default="0,1000000",
+                        help="comma separated file sizes in bytes, 0 disables the file transfers")
+    parser.add_argument("--runs", type=int, default=3, help="seeds per point")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel simulations")
+    parser.add_argument("--csv", default="", help="write the results as CSV")
+    parser.add_argument("--verbose", action="store_true", help="print the simulations")
+    parser.add_argument("extra", nargs="*", help="further options of the simulation after --")
+    options = parser.parse_args()
+    options.sizes = [int(size) for size in options.sizes.split(",") if size]
+
+    rows = Benchmark(options).run()
+
+    print("%10s %-8s %5s %-8s %4s" % ("file size", "bearers", "runs", "class", "dir")
+          + "".join(" %10s" % column for column in COLUMNS))
+    for size, mode, valid, traffic_class, direction, row in rows:
+        print("%10d %-8s %5d %-8s %4s" % (size, mode, valid, traffic_class, direction)
+              + "".join(" %10.3f" % row[column] for column in COLUMNS))
+    if options.csv:
+        with open(options.csv, "w") as csv_file:
+            writer = csv.writer(csv_file)
+            writer.writerow(["file_size", "bearers", "runs", "class", "direction"] + COLUMNS)
+            for size, mode, valid, traffic_class, direction, row in rows:
+                writer.writerow([size, mode, valid, traffic_class, direction]
+                                + ["%.6f" % row[column] for column in COLUMNS])
+        print("Wrote %s" % options.csv)
+
+
+if __name__ == "__main__":
+    main()
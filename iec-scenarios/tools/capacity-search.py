@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+"""Capacity search over the load of dce-iec-scenarios.
+
+Searches the largest value of a load parameter (nSpokes, nUEs, ...) for
+which the poll probe meets its SLA, optionally for every combination of
+further options (data rate, LTE bandwidth, scheduler, ...). Every load is
+simulated with several seeds, a load is sustainable if the share of passing
+runs reaches the confidence. The runs of a search step are simulated in
+parallel; with more jobs than seeds, several loads are tested per step
+(k-section instead of bisection). The KPIs of every run are cached, so a
+repeated or extended search only simulates new points.
+
+Examples:
+    tools/capacity-search.py --command "build/bin/dce-iec-scenarios" \\
+        --low 1 --high 200 --data-rates 1Mbps,10Mbps --runs 5 \\
+        -- --Topology=generic-star --Duration=30
+
+    tools/capacity-search.py --command "build/bin/dce-iec-scenarios" \\
+        --parameter nUEs --low 1 --high 100 --kpi p95_ms --sla-ms 200 \\
+        --vary LteBandwidth=25,50,100 --vary LteScheduler=pf,rr --jobs 8 \\
+        -- --Topology=generic-lte --Duration=30
+"""
+
+import argparse
+import itertools
+import math
+
+from simrunner import SimRunner, read_kpis
+
+
+def wilson_lower_bound(passed, runs, z=1.96):
+    """Lower bound of the 95 % Wilson interval of the pass probability."""
+    if runs == 0:
+        return 0.0
+    share = passed / runs
+    denominator = 1 + z * z / runs
+    center = share + z * z / (2 * runs)
+    margin = z * math.sqrt(share * (1 - share) / runs + z * z / (4 * runs * runs))
+    return (center - margin) / denominator
+
+
+def configurations(options):
+    """Returns the combinations of the varied options as lists of arguments."""
+    varied = []
+    if options.data_rates:
+        varied.append(("DataRate", [rate for rate in options.data_rates.split(",") if rate]))
+    for vary in options.vary:
+        name, _, values = vary.partition("=")
+        varied.append((name, [value for value in values.split(",") if value]))
+    combinations = []
+    for values in itertools.product(*[values for _, values in varied]):
+        combinations.append(["--%s=%s" % (name, value)
+                             for (name, _), value in zip(varied, values)])
+    return combinations
+
+
+class CapacitySearch:
+    def __init__(self, options):
+        self.options = options
+        self.sla = options.sla_ms if options.sla_ms > 0 else options.cycle * 1000.0
+        self.runner = SimRunner(options.command, options.jobs, options.verbose, options.cache)
+
+    def arguments(self, load, configuration, run):
+        arguments = list(self.options.extra) + configuration
+        arguments.append("--%s=%d" % (self.options.parameter, load))
+        arguments.append("--RngRun=%d" % run)
+        arguments.append("--PollProbe=true")
+        arguments.append("--PollCycle=%g" % self.options.cycle)
+        return arguments
+
+    def passes(self, results):
+        """KPI predicate: the completion time KPI within the SLA, few missed polls."""
+        kpis = results[0] if results else {}
+        if not kpis or kpis.get("completed", 0) == 0:
+            return False
+        return (kpis[self.options.kpi] < self.sla
+                and kpis.get("missed_ratio", 0.0) <= self.options.max_missed)
+
+    def evaluate(self, loads, configuration):
+        """Simulates all runs of the loads in parallel, returns load -> (sustainable, passed)."""
+        runs = range(1, self.options.runs + 1)
+        futures = dict(((load, run), self.runner.submit(self.arguments(load, configuration, run),
+                                                        [("KpiFile", read_kpis)]))
+                       for load in loads for run in runs)
+        results = {}
+        for load in loads:
+            passed = sum(1 for run in runs if self.passes(futures[(load, run)].result()))
+            sustainable = passed >= self.options.confidence * self.options.runs
+            print("  %s=%d%s: %d/%d runs pass%s" % (
+                self.options.parameter, load,
+                " (" + " ".join(configuration) + ")" if configuration else "",
+                passed, self.options.runs, "" if sustainable else ", not sustainable"))
+            results[load] = (sustainable, passed)
+        return results
+
+    def search(self, configuration):
+        """Searches the largest sustainable load, assuming the KPI grows with the load."""
+        low, high = self.options.low, self.options.high
+        results = self.evaluate([low, high], configuration)
+        if not results[low][0]:
+            return None, results[low][1], low
+        if results[high][0]:
+            return high, results[high][1], None
+        best, best_passed, failing = low, results[low][1], high
+        points = max(1, self.options.jobs // max(self.options.runs, 1))
+        while failing - best > 1:
+            # equally spaced loads between the best sustainable and the first failing one
+            count = min(points, failing - best - 1)
+            loads = sorted(set(best + (failing - best) * (i + 1) // (count + 1) for i in range(count)))
+            results = self.evaluate(loads, configuration)
+            for load in loads:
+                if results[load][0]:
+                    best, best_passed = load, results[load][1]
+                else:
+                    failing = load
+                    break
+        return best, best_passed, failing
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="dce-iec-scenarios",
+                        help="command running the simulation")
+    parser.add_argument("--parameter", default="nSpokes",
+                        help="option scaling the load (nSpokes, nUEs)")
+    parser.add_argument("--low", type=int, default=1, help="smallest load")
+    parser.add_argument("--high", type=int, default=100, help="largest load")
+    parser.add_argument("--data-rates", default="",
+                        help="comma separated data rates, one search per rate")
+    parser.add_argument("--vary", action="append", default=[],
+                        help="NAME=v1,v2 option to vary, one search per combination")
+    parser.add_argument("--runs", type=int, default=3, help="seeds per load")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel simulations")
+    parser.add_argument("--confidence", type=float, default=1.0,
+                        help="share of passing runs for a sustainable load")
+    parser.add_argument("--cycle", type=float, default=1.0, help="poll cycle in sec")
+    parser.add_argument("--kpi", default="p99_ms",
+                        help="completion time KPI (p50_ms, p95_ms, p99_ms, max_ms, mean_ms)")
+    parser.add_argument("--sla-ms", type=float, default=0.0,
+                        help="largest KPI value in ms, default is the cycle")
+    parser.add_argument("--max-missed", type=float, default=0.0,
+                        help="largest share of polls missing their deadline")
+    parser.add_argument("--cache", default="capacity-cache.json",
+                        help="cache of the KPIs per run, empty disables it")
+    parser.add_argument("--verbose", action="store_true", help="print the simulations")
+    parser.add_argument("extra", nargs="*", help="further options of the simulation after --")
+    options = parser.parse_args()
+
+    search = CapacitySearch(options)
+    results = []
+    for configuration in configurations(options):
+        print("Searching %s%s" % (options.parameter,
+                                  " with " + " ".join(configuration) if configuration else ""))
+        results.append((configuration, search.search(configuration)))
+    search.runner.shutdown()
+
+    print("")
+    print("%s <= %g ms" % (options.kpi, search.sla))
+    print("%-40s %10s %10s %12s" % ("configuration", "max load", "first fail", "P(pass) >="))
+    for configuration, (best, passed, failing) in results:
+        bound = wilson_lower_bound(passed, options.runs) if best is not None else 0.0
+        print("%-40s %10s %10s %12.2f" % (" ".join(configuration) or "default",
+                                            best if best is not None else "-",
+                                            failing if failing is not None else "-", bound))
+    print("%d simulations, %d cached runs" % (search.runner.simulations, len(search.runner.cache)))
+
+
+if __name__ == "__main__":
+    main()
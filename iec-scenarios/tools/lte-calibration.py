@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Calibration of the trace driven LTE model from full LTE runs.
+
+Simulates generic-lte with the full LTE model for several loads (UEs per
+cell) and seeds, records the delay of every packet between the UEs and the
+PGW (--LteDelayCsv) and writes a trace for --LteTrace with one section per
+load: quantiles of the uplink and downlink delay and the loss of every UE.
+The trace model uses the section nearest to the load of its scenario.
+
+With --validate, every load is simulated again with the trace model and the
+completion times of the poll probe are compared with those of the full
+runs; the script fails if a relative error exceeds the tolerance.
+
+Example:
+    tools/lte-calibration.py --command "build/bin/dce-iec-scenarios" \\
+        --loads 1,5,10,20 --runs 3 --jobs 8 --output lte-calibrated.txt \\
+        --validate -- --Duration=30 --LteScheduler=pf
+"""
+
+import argparse
+import csv
+import sys
+
+from simrunner import SimRunner, read_kpis
+
+KPIS = ["p50_ms", "p95_ms", "p99_ms", "mean_ms"]
+
+
+def read_delays(file_name):
+    """Reads --LteDelayCsv, returns the delays in ms and the sent and received packets per UE."""
+    delays = {"ul": [], "dl": []}
+    sent = {}
+    received = {}
+    with open(file_name) as delay_file:
+        for row in csv.DictReader(delay_file):
+            key = (row["ue"], row["direction"])
+            if row["kind"] == "sent":
+                sent[key] = int(row["value"])
+            elif row["kind"] == "delay":
+                delays[row["direction"]].append(float(row["value"]) / 1000.0)
+                received[key] = received.get(key, 0) + 1
+    return delays, sent, received
+
+
+def quantiles(values, count):
+    """Returns count equally spaced quantiles of the values, linearly interpolated."""
+    if not values:
+        return []
+    values = sorted(values)
+    result = []
+    for i in range(count):
+        position = (i + 0.5) / count * (len(values) - 1)
+        lower = int(position)
+        upper = min(lower + 1, len(values) - 1)
+        result.append(values[lower] + (values[upper] - values[lower]) * (position - lower))
+    return result
+
+
+def relative_error(abstract, full):
+    if full == 0:
+        return 0.0 if abstract == 0 else float("inf")
+    return abs(abstract - full) / full
+
+
+class Calibration:
+    def __init__(self, options):
+        self.options = options
+        self.runner = SimRunner(options.command, options.jobs, options.verbose)
+
+    def simulate(self, load, run, model_arguments, delays):
+        """Schedules one simulation, its result are the KPIs and, for the full model, the delays."""
+        arguments = list(self.options.extra) + model_arguments
+        arguments += ["--Topology=generic-lte", "--nUEs=%d" % load, "--RngRun=%d" % run,
+                      "--PollProbe=true"]
+        outputs = [("KpiFile", read_kpis)]
+        if delays:
+            outputs.append(("LteDelayCsv", read_delays))
+        return self.runner.submit(arguments, outputs)
+
+    @staticmethod
+    def result(results):
+        """Returns the KPIs and the delays (None without) of a run, empty KPIs if it failed."""
+        if not results:
+            return {}, None
+        return results[0], results[1] if len(results) > 1 else None
+
+    def simulate_all(self, model_arguments, delays):
+        """Simulates every load and seed in parallel, returns load -> list of results."""
+        runs = range(1, self.options.runs + 1)
+        futures = dict(((load, run), self.simulate(load, run, model_arguments, delays))
+                       for load in self.options.loads for run in runs)
+        return dict((load, [self.result(futures[(load, run)].result()) for run in runs])
+                    for load in self.options.loads)
+
+    def write_trace(self, results):
+        """Writes the delay quantiles and the per UE losses of every load."""
+        with open(self.options.output, "w") as trace:
+            trace.write("# calibrated with the full LTE model: %s\n" % " ".join(self.options.extra))
+            for load in self.options.loads:
+                delays = {"ul": [], "dl": []}
+                losses = {"ul": [], "dl": []}
+                for _, recorded in results[load]:
+                    if recorded is None:
+                        continue
+                    run_delays, sent, received = recorded
+                    for direction in delays:
+                        delays[direction].extend(run_delays[direction])
+                    for (ue, direction), packets in sorted(sent.items()):
+                        if packets > 0:
+                            lost = packets - received.get((ue, direction), 0)
+                            losses[direction].append(max(lost, 0) / packets)
+                trace.write("load %d\n" % load)
+                for direction in ("ul", "dl"):
+                    for value in quantiles(delays[direction], self.options.quantiles):
+                        trace.write("%s_delay_ms %.3f\n" % (direction, value))
+                    for value in losses[direction]:
+                        trace.write("%s_loss %.6f\n" % (direction, value))
+                print("  load %d: %d ul and %d dl delays, %d UEs" % (
+                    load, len(delays["ul"]), len(delays["dl"]), len(losses["ul"])))
+        print("Wrote %s" % self.options.output)
+
+    def validate(self, full):
+        """Compares the mean KPIs over the seeds of the trace model with those of the full model."""
+        abstract = self.simulate_all(["--LteModel=trace", "--LteTrace=" + self.options.output], False)
+        print("")
+        print("%6s %-8s %10s %10s %8s" % ("load", "kpi", "full", "trace", "error"))
+        passed = True
+        for load in self.options.loads:
+            for kpi in KPIS:
+                values = []
+                for results in (full[load], abstract[load]):
+                    samples = [kpis[kpi] for kpis, _ in results if kpi in kpis]
+                    values.append(sum(samples) / len(samples) if samples else None)
+                if None in values:
+                    print("%6d %-8s %10s %10s %8s" % (load, kpi, "-", "-", "failed"))
+                    passed = False
+                    continue
+                error = relative_error(values[1], values[0])
+                flag = "" if error <= self.options.tolerance else " !"
+                passed = passed and not flag
+                print("%6d %-8s %10.2f %10.2f %7.1f%%%s" % (load, kpi, values[0], values[1],
+                                                           error * 100, flag))
+        print("relative errors %s the tolerance of %g %%" % (
+            "within" if passed else "exceed", self.options.tolerance * 100))
+        return passed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="dce-iec-scenarios",
+                        help="command running the simulation")
+    parser.add_argument("--loads", default="1,5,10,20",
+                        help="comma separated numbers of UEs per cell")
+    parser.add_argument("--runs", type=int, default=3, help="seeds per load")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel simulations")
+    parser.add_argument("--quantiles", type=int, default=100,
+                        help="delay quantiles per direction and load")
+    parser.add_argument("--output", default="lte-calibrated.txt", help="trace file to write")
+    parser.add_argument("--validate", action="store_true",
+                        help="compare the trace model with the full model")
+    parser.add_argument("--tolerance", type=float, default=0.2,
+                        help="largest relative error of a KPI in the validation")
+    parser.add_argument("--verbose", action="store_true", help="print the simulations")
+    parser.add_argument("extra", nargs="*", help="further options of the simulation after --")
+    options = parser.parse_args()
+    options.loads = [int(load) for load in options.loads.split(",") if load]
+
+    calibration = Calibration(options)
+    print("Simulating the full LTE model")
+    full = calibration.simulate_all(["--LteModel=full"], True)
+    calibration.write_trace(full)
+    passed = calibration.validate(full) if options.validate else True
+    calibration.runner.shutdown()
+    sys.exit(0 if passed else 1)
+
+
+if __name__ == "__main__":
+    main()
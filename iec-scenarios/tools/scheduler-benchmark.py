@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""Benchmark of the LTE MAC schedulers with the IEC traffic of generic-lte.
+
+Simulates every scheduler at every load (UEs per cell) with several seeds
+and compares the poll completion times of the poll probe and the one-way
+delays between the UEs and the PGW per direction (--LteDelayCsv). The
+delay quantiles are taken over the packets of all seeds of a point, the
+poll quantiles are the means of the seeds weighted by their polls.
+
+A --variant adds a labelled set of options to compare, like the deadline
+scheduler with semi-persistent grants. The uplink RBs per received packet
+and the share of empty semi-persistent grants come from --LteGrantFile,
+which only the deadline scheduler writes.
+
+Example:
+    tools/scheduler-benchmark.py --command "build/bin/dce-iec-scenarios" \\
+        --schedulers pf,rr,tdmt,deadline --loads 5,10,20,40 --runs 3 --jobs 8 \\
+        --csv schedulers.csv -- --Duration=30
+
+    tools/scheduler-benchmark.py --schedulers deadline \\
+        --variant "sps20=--LteScheduler=deadline --LteSpsPeriod=20" -- --Duration=30
+"""
+
+import argparse
+import csv
+import os
+import shlex
+
+from simrunner import SimRunner, read_kpis
+
+COLUMNS = ["poll_p50_ms", "poll_p99_ms", "missed_ratio",
+           "ul_p50_ms", "ul_p95_ms", "ul_p99_ms", "dl_p50_ms", "dl_p99_ms", "ul_loss",
+           "rbs_per_ul_packet", "sps_empty_ratio"]
+
+
+def read_grants(file_name):
+    """Reads --LteGrantFile, empty if the scheduler did not write it."""
+    if os.path.getsize(file_name) == 0:
+        return {}
+    return read_kpis(file_name)
+
+
+def read_delays(file_name):
+    """Reads --LteDelayCsv, returns the delays in ms and the sent packets per direction."""
+    delays = {"ul": [], "dl": []}
+    sent = {"ul": 0, "dl": 0}
+    with open(file_name) as delay_file:
+        for row in csv.DictReader(delay_file):
+            if row["kind"] == "sent":
+                sent[row["direction"]] += int(row["value"])
+            elif row["kind"] == "delay":
+                delays[row["direction"]].append(float(row["value"]) / 1000.0)
+    return delays, sent
+
+
+def quantile(values, share):
+    if not values:
+        return float("nan")
+    values = sorted(values)
+    return values[min(int(share * len(values)), len(values) - 1)]
+
+
+class Benchmark:
+    def __init__(self, options):
+        self.options = options
+        self.runner = SimRunner(options.command, options.jobs, options.verbose)
+
+    def simulate(self, variant, load, run):
+        """Schedules one simulation, its result are the KPIs, the delays and sent packets and the grants."""
+        arguments = list(self.options.extra)
+        arguments += ["--Topology=%s" % self.options.topology] + self.options.variants[variant]
+        arguments += ["--%s=%d" % (self.options.parameter, load), "--RngRun=%d" % run,
+                      "--PollProbe=true"]
+        return self.runner.submit(arguments, [("KpiFile", read_kpis), ("LteDelayCsv", read_delays),
+                                              ("LteGrantFile", read_grants)])
+
+    def evaluate(self, results):
+        """Combines the runs of a point into one row of COLUMNS."""
+        results = [result for result in results if result is not None]
+        delays = {"ul": [], "dl": []}
+        sent = {"ul": 0, "dl": 0}
+        polls = 0
+        missed = 0
+        completed = 0
+        # the probe writes quantiles per run, weighted by the completed polls of the run
+        weighted = {"p50_ms": 0.0, "p99_ms": 0.0}
+        grants = {}
+        for kpis, (run_delays, run_sent), run_grants in results:
+            for direction in delays:
+                delays[direction].extend(run_delays[direction])
+                sent[direction] += run_sent[direction]
+            completed += kpis.get("completed", 0)
+            polls += kpis.get("polls", 0)
+            missed += kpis.get("missed", 0)
+            for name in weighted:
+                weighted[name] += kpis.get(name, 0.0) * kpis.get("completed", 0)
+            for name, value in run_grants.items():
+                grants[name] = grants.get(name, 0) + value
+        sps_grants = grants.get("sps_grants", 0)
+        row = {
+            "poll_p50_ms": weighted["p50_ms"] / completed if completed else float("nan"),
+            "poll_p99_ms": weighted["p99_ms"] / completed if completed else float("nan"),
+            "missed_ratio": missed / polls if polls else float("nan"),
+            "ul_p50_ms": quantile(delays["ul"], 0.5),
+            "ul_p95_ms": quantile(delays["ul"], 0.95),
+            "ul_p99_ms": quantile(delays["ul"], 0.99),
+            "dl_p50_ms": quantile(delays["dl"], 0.5),
+            "dl_p99_ms": quantile(delays["dl"], 0.99),
+            "ul_loss": 1 - len(delays["ul"]) / sent["ul"] if sent["ul"] else float("nan"),
+            "rbs_per_ul_packet": grants["rbs"] / len(delays["ul"]) if "rbs" in grants and delays["ul"]
+                                 else float("nan"),
+            "sps_empty_ratio": grants["sps_empty"] / sps_grants if sps_grants else float("nan"),
+        }
+        return row, len(results)
+
+    def run(self):
+        runs = range(1, self.options.runs + 1)
+        futures = dict(((variant, load, run), self.simulate(variant, load, run))
+                       for variant in self.options.variants for load in self.options.loads
+                       for run in runs)
+        rows = []
+        for load in self.options.loads:
+            for variant in self.options.variants:
+                row, valid = self.evaluate([futures[(variant, load, run)].result() for run in runs])
+                rows.append((load, variant, valid, row))
+        self.runner.shutdown()
+        return rows
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--command", default="dce-iec-scenarios",
+                        help="command running the simulation")
+    parser.add_argument("--topology", default="generic-lte", help="LTE topology")
+    parser.add_argument("--parameter", default="nUEs", help="option scaling the load")
+    parser.add_argument("--schedulers", default="pf,rr,tdmt,deadline",
+                        help="comma separated values of --LteScheduler")
+    parser.add_argument("--variant", action="append", default=[], metavar="LABEL=OPTIONS",
+                        help="further point with the given simulation options, repeatable")
+    parser.add_argument("--loads", default="5,10,20", help="comma separated loads")
+    parser.add_argument("--runs", type=int, default=3, help="seeds per point")
+    parser.add_argument("--jobs", type=int, default=1, help="parallel simulations")
+    parser.add_argument("--csv", default="", help="write the results as CSV")
+    parser.add_argument("--verbose", action="store_true", help="print the simulations")
+    parser.add_argument("extra", nargs="*", help="further options of the simulation after --")
+    options = parser.parse_args()
+    # the options of every compared point by its label, in the order of the table
+    options.variants = {}
+    for name in options.schedulers.split(","):
+        if name:
+            options.variants[name] = ["--LteScheduler=" + name]
+    for variant in options.variant:
+        label, separator, arguments = variant.partition("=")
+        if not label or not separator:
+            parser.error("invalid variant %s, expected LABEL=OPTIONS" % variant)
+        options.variants[label] = shlex.split(arguments)
+    options.loads = [int(load) for load in options.loads.split(",") if load]
+
+    rows = Benchmark(options).run()
+
+    print("%6s %-10s %5s" % ("load", "variant", "runs")
+          + "".join(" %12s" % column for column in COLUMNS))
+    for load, variant, valid, row in rows:
+        print("%6d %-10s %5d" % (load, variant, valid)
+              + "".join(" %12.3f" % row[column] for column in COLUMNS))
+    if options.csv:
+        with open(options.csv, "w") as csv_file:
+            writer = csv.writer(csv_file)
+            writer.writerow([options.parameter, "variant", "runs"] + COLUMNS)
+            for load, variant, valid, row in rows:
+                writer.writerow([load, variant, valid] + ["%.6f" % row[column] for column in COLUMNS])
+        print("Wrote %s" % options.csv)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,108 @@
+"""Runs of dce-iec-scenarios for the tools under tools/.
+
+SimRunner runs the simulation with a temporary file for every output
+option (--KpiFile, --LteDelayCsv, ...), reads the files back and removes
+them, several runs in parallel. A failed run, one that exits with an error
+or writes no or broken output, is reported and returns None. With a cache,
+the outputs of every successful run are kept by command, binary and
+arguments, so a repeated or extended study only simulates new points;
+failed runs are not cached, a later study after a fix simulates them again.
+"""
+
+import json
+import os
+import shlex
+import shutil
+import subprocess
+import sys
+import tempfile
+import threading
+from concurrent.futures import ThreadPoolExecutor
+
+
+def read_kpis(file_name):
+    """Reads the name=value lines written by --KpiFile and the other KPI files."""
+    kpis = {}
+    with open(file_name) as kpi_file:
+        for line in kpi_file:
+            name, _, value = line.strip().partition("=")
+            if name:
+                kpis[name] = float(value)
+    if not kpis:
+        raise ValueError("no KPIs written")
+    return kpis
+
+
+def binary_version(command):
+    """Identifies the simulation binary by its path, size and mtime, a rebuild invalidates the cache."""
+    for word in shlex.split(command):
+        path = shutil.which(word) or (word if os.path.isfile(word) else None)
+        if path and not os.path.basename(path).startswith(("python", "waf", "env")):
+            status = os.stat(path)
+            return "%s:%d:%d" % (os.path.realpath(path), status.st_size, int(status.st_mtime))
+    return ""
+
+
+class SimRunner:
+    def __init__(self, command, jobs=1, verbose=False, cache_file=None):
+        """cache_file None disables the cache, "" keeps it in memory only."""
+        self.command = command
+        self.verbose = verbose
+        self.cache_file = cache_file
+        self.cache = {}
+        if cache_file and os.path.exists(cache_file):
+            with open(cache_file) as cache:
+                self.cache = json.load(cache)
+        self.binary = binary_version(command)
+        self.lock = threading.Lock()
+        self.executor = ThreadPoolExecutor(max_workers=max(jobs, 1))
+        self.simulations = 0
+
+    def save_cache(self):
+        if self.cache_file:
+            with open(self.cache_file, "w") as cache:
+                json.dump(self.cache, cache, indent=1, sort_keys=True)
+
+    def submit(self, arguments, outputs):
+        """Schedules simulate() on the pool, returns its future."""
+        return self.executor.submit(self.simulate, arguments, outputs)
+
+    def simulate(self, arguments, outputs):
+        """Runs one simulation, outputs are (option, reader) pairs.
+
+        Returns the list of the read outputs, None if the run failed.
+        """
+        key = " ".join([self.command, self.binary] + list(arguments)
+                       + ["--%s" % option for option, _ in outputs])
+        if self.cache_file is not None:
+            with self.lock:
+                if key in self.cache:
+                    return self.cache[key]
+        files = []
+        for option, _ in outputs:
+            handle, name = tempfile.mkstemp(suffix="." + option.lower())
+            os.close(handle)
+            files.append(name)
+        command = shlex.split(self.command) + list(arguments)
+        command += ["--%s=%s" % (option, name) for (option, _), name in zip(outputs, files)]
+        if self.verbose:
+            print("  running " + " ".join(command), file=sys.stderr)
+        results = None
+        try:
+            subprocess.run(command, check=True, stdout=subprocess.DEVNULL,
+                           stderr=None if self.verbose else subprocess.DEVNULL)
+            results = [reader(name) for (_, reader), name in zip(outputs, files)]
+        except (subprocess.CalledProcessError, OSError, ValueError, KeyError) as error:
+            print("  run failed (%s): %s" % (error, " ".join(arguments)), file=sys.stderr)
+        finally:
+            for name in files:
+                os.remove(name)
+        with self.lock:
+            self.simulations += 1
+            if self.cache_file is not None and results is not None:
+                self.cache[key] = results
+                self.save_cache()
+        return results
+
+    def shutdown(self):
+        self.executor.shutdown()
@@ -0,0 +1,236 @@
+#include "accounting-helper.h"
+#include "string-helper.h"
+#include "ns3/dce-module.h"
+
+#include <time.h>
+#include <malloc.h>
+#include <sys/resource.h>
+#include <sys/time.h>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("AccountingHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (AccountingScheduler);
+
+static const uint32_t NO_CONTEXT = 0xffffffff;
+
+AccountingScheduler* AccountingScheduler::s_instance = 0;
+
+TypeId AccountingScheduler::GetTypeId (void) {
+     static TypeId tid = TypeId ("AccountingScheduler")
+          .SetParent<Scheduler> ()
+          .AddConstructor<AccountingScheduler> ();
+     return tid;
+}
+
+AccountingScheduler::AccountingScheduler() :
+     m_scheduler(CreateObject<MapScheduler> ()),
+     m_context(NO_CONTEXT),
+     m_last(cpuTime()) {
+     m_core.cpu = 0;
+     m_core.events = 0;
+     s_instance = this;
+}
+
+// Function to get the scheduler created by the simulator
+AccountingScheduler* AccountingScheduler::getInstance() {
+     return s_instance;
+}
+void AccountingScheduler::Insert (const Event &ev) {
+     m_scheduler->Insert (ev);
+}
+
+bool AccountingScheduler::IsEmpty (void) const {
+     return m_scheduler->IsEmpty ();
+}
+
+Scheduler::Event AccountingScheduler::PeekNext (void) const {
+     return m_scheduler->PeekNext ();
+}
+
+// The previous event has finished when the next one is removed
+Scheduler::Event AccountingScheduler::RemoveNext (void) {
+     flush();
+     Event ev = m_scheduler->RemoveNext ();
+     m_context = ev.key.m_context;
+     if (m_context == NO_CONTEXT) {
+          ++m_core.events;
+     } else {
+          if (m_context >= m_nodes.size()) {
+               Usage usage = { 0, 0 };
+               m_nodes.resize(m_context + 1, usage);
+          }
+          ++m_nodes[m_context].events;
+     }
+     return ev;
+}
+
+void AccountingScheduler::Remove (const Event &ev) {
+     m_scheduler->Remove (ev);
+}
+
+// Function to account the CPU time since the last event to its context
+void AccountingScheduler::flush() {
+     double now = cpuTime();
+     if (m_context == NO_CONTEXT || m_context >= m_nodes.size()) {
+          m_core.cpu += now - m_last;
+     } else {
+          m_nodes[m_context].cpu += now - m_last;
+     }
+     m_last = now;
+}
+
+// Function to account the last event after the simulation, the time afterwards is not accounted
+void AccountingScheduler::stop() {
+     flush();
+     m_context = NO_CONTEXT;
+}
+
+AccountingScheduler::Usage const& AccountingScheduler::getCoreUsage() const {
+     return m_core;
+}
+
+vector<AccountingScheduler::Usage> const& AccountingScheduler::getNodeUsage() const {
+     return m_nodes;
+}
+
+// Function to get the CPU time of the simulator in seconds
+double AccountingScheduler::cpuTime() {
+     struct timespec ts;
+     clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+     return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+AccountingHelper::AccountingHelper() :
+     m_enabled(false),
+     m_wallStart(0) {
+}
+
+// Function to install the accounting scheduler, call before the simulation
+void AccountingHelper::enable() {
+     ObjectFactory factory;
+     factory.SetTypeId (AccountingScheduler::GetTypeId ());
+     Simulator::SetScheduler (factory);
+     m_enabled = true;
+     m_wallStart = wallTime();
+}
+
+bool AccountingHelper::isEnabled() const {
+     return m_enabled;
+}
+
+// Function to end the accounting when the simulation returns, before the results are written
+void AccountingHelper::stop() {
+     AccountingScheduler* scheduler = AccountingScheduler::getInstance();
+     if (m_enabled && scheduler != 0) {
+          scheduler->stop();
+     }
+}
+
+// Function to name the role of a node (e.g. enb or pgw) in the report
+void AccountingHelper::setLabel(Ptr<Node> node, string const& label) {
+     m_labels[node->GetId ()] = label;
+}
+
+// Function to collect one row for the core and for every active node
+vector<AccountingHelper::Row> AccountingHelper::collect() {
+     vector<Row> rows;
+     AccountingScheduler* scheduler = AccountingScheduler::getInstance();
+     if (scheduler == 0) {
+          return rows;
+     }
+
+     // processes per node as given by DCE
+     map<uint32_t, string> processes;
+     vector<ProcStatus> status = DceManagerHelper::GetProcStatus ();
+     for (size_t i = 0; i < status.size(); ++i) {
+          string cmd = status[i].GetCmdLine ();
+          cmd = cmd.substr(0, cmd.find(' '));
+          cmd = cmd.substr(cmd.rfind('/') + 1);
+          string& entry = processes[status[i].GetNode ()];
+          if (!entry.empty()) {
+               entry += " ";
+          }
+          entry += cmd + "[" + StringHelper::toString((unsigned int) status[i].GetPid ()) + "]";
+     }
+
+     Row core = { "core", "simulator", "", scheduler->getCoreUsage().cpu, scheduler->getCoreUsage().events };
+     rows.push_back(core);
+     vector<AccountingScheduler::Usage> const& nodes = scheduler->getNodeUsage();
+     for (uint32_t i = 0; i < nodes.size(); ++i) {
+          if (nodes[i].events == 0 && m_labels.find(i) == m_labels.end()) {
+               continue;
+          }
+          Row row = { "node-" + StringHelper::toString(i), m_labels[i], processes[i], nodes[i].cpu, nodes[i].events };
+          rows.push_back(row);
+     }
+     return rows;
+}
+
+// Function to print the accounting of the run
+void AccountingHelper::report() {
+     if (!m_enabled) {
+          return;
+     }
+     vector<Row> rows = collect();
+     double cpu = 0;
+     for (size_t i = 0; i < rows.size(); ++i) {
+          cpu += rows[i].cpu;
+     }
+     struct rusage usage;
+     getrusage(RUSAGE_SELF, &usage);
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+     struct mallinfo2 heap = mallinfo2();
+#else
+     struct mallinfo heap = mallinfo();
+#endif
+
+     cout << "Accounting" << endl;
+     cout << "  wall time:        " << wallTime() - m_wallStart << " sec" << endl;
+     cout << "  cpu time:         " << cpu << " sec" << endl;
+     cout << "  peak rss:         " << usage.ru_maxrss << " kB" << endl;
+     cout << "  heap in use:      " << heap.uordblks / 1024 << " kB" << endl;
+     cout << "  context switches: " << usage.ru_nvcsw << " voluntary, "
+          << usage.ru_nivcsw << " involuntary" << endl;
+     cout << setw(12) << left << "name" << setw(12) << "label" << setw(12) << right << "cpu [s]"
+          << setw(8) << "cpu [%]" << setw(12) << "events" << "  processes" << endl;
+     for (size_t i = 0; i < rows.size(); ++i) {
+          cout << setw(12) << left << rows[i].name << setw(12) << rows[i].label
+               << setw(12) << right << fixed << setprecision(3) << rows[i].cpu
+               << setw(8) << setprecision(1) << (cpu > 0 ? 100 * rows[i].cpu / cpu : 0)
+               << setw(12) << rows[i].events << "  " << rows[i].processes << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to export the accounting as CSV
+bool AccountingHelper::writeCsv(string const& fileName) {
+     if (!m_enabled) {
+          return false;
+     }
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write accounting file " << fileName);
+          return false;
+     }
+     vector<Row> rows = collect();
+     out << "name,label,cpu,events,processes" << endl;
+     for (size_t i = 0; i < rows.size(); ++i) {
+          out << rows[i].name << "," << rows[i].label << "," << rows[i].cpu << ","
+              << rows[i].events << "," << rows[i].processes << endl;
+     }
+     return true;
+}
+
+// Function to get the wall clock time in seconds
+double AccountingHelper::wallTime() {
+     struct timeval tv;
+     gettimeofday(&tv, NULL);
+     return tv.tv_sec + tv.tv_usec * 1e-6;
+}
@@ -0,0 +1,80 @@
+#ifndef ACCOUNTING_HELPER_H_
+#define ACCOUNTING_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Scheduler which wraps the map scheduler and attributes the host CPU time
+* between two removed events to the context (node) of the earlier event.
+* The DCE processes run within the events of their node, so the time of a
+* node contains its processes and its part of the network stack. Events
+* without context are accounted to the simulator core.
+*/
+class AccountingScheduler : public ns3::Scheduler {
+public:
+     static ns3::TypeId GetTypeId (void);
+     AccountingScheduler();
+     virtual void Insert (const Event &ev);
+     virtual bool IsEmpty (void) const;
+     virtual Event PeekNext (void) const;
+     virtual Event RemoveNext (void);
+     virtual void Remove (const Event &ev);
+
+     struct Usage {
+          double cpu;
+          uint64_t events;
+     };
+
+     static AccountingScheduler* getInstance();
+     void flush();
+     void stop();
+     Usage const& getCoreUsage() const;
+     std::vector<Usage> const& getNodeUsage() const;
+
+private:
+     static double cpuTime();
+     static AccountingScheduler* s_instance;
+
+     ns3::Ptr<ns3::Scheduler> m_scheduler;
+     uint32_t m_context;
+     double m_last;
+     Usage m_core;
+     std::vector<Usage> m_nodes;
+};
+
+/**
+* Installs the accounting scheduler and prints the CPU time, the number of
+* events and the processes of every node and of the simulator core.
+*/
+class AccountingHelper {
+public:
+     AccountingHelper();
+     void enable();
+     bool isEnabled() const;
+     void stop();
+     void setLabel(ns3::Ptr<ns3::Node> node, std::string const& label);
+     void report();
+     bool writeCsv(std::string const& fileName);
+
+private:
+     struct Row {
+          std::string name;
+          std::string label;
+          std::string processes;
+          double cpu;
+          uint64_t events;
+     };
+
+     std::vector<Row> collect();
+     static double wallTime();
+
+     bool m_enabled;
+     std::map<uint32_t, std::string> m_labels;
+     double m_wallStart;
+};
+
+#endif /* ACCOUNTING_HELPER_H_ */
@@ -0,0 +1,115 @@
+#include "activation-helper.h"
+
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("ActivationHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (ActivationListener);
+
+TypeId ActivationListener::GetTypeId (void) {
+     static TypeId tid = TypeId ("ActivationListener")
+          .SetParent<Application> ()
+          .AddConstructor<ActivationListener> ()
+          .AddAttribute ("Port", "Port of the server which is activated",
+                         UintegerValue (10102),
+                         MakeUintegerAccessor (&ActivationListener::m_port),
+                         MakeUintegerChecker<uint16_t> ());
+     return tid;
+}
+
+ActivationListener::ActivationListener() :
+     m_port(10102),
+     m_activated(false) {
+}
+
+// Function to set the DCE application which is launched on activation and its stop time
+void ActivationListener::setServer(DceApplicationHelper const& dce, Time stop) {
+     m_dce = dce;
+     m_stopTime = stop;
+}
+
+bool ActivationListener::isActivated() const {
+     return m_activated;
+}
+
+Time ActivationListener::getActivationTime() const {
+     return m_activationTime;
+}
+
+void ActivationListener::DoDispose (void) {
+     m_socket = 0;
+     Application::DoDispose ();
+}
+
+void ActivationListener::StartApplication (void) {
+     if (m_activated) {
+          return;
+     }
+     m_socket = Socket::CreateSocket (GetNode (), TcpSocketFactory::GetTypeId ());
+     m_socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_port));
+     m_socket->Listen ();
+     m_socket->SetAcceptCallback (
+          MakeCallback (&ActivationListener::handleRequest, this),
+          MakeNullCallback<void, Ptr<Socket>, const Address &> ());
+}
+
+void ActivationListener::StopApplication (void) {
+     if (m_socket != 0) {
+          m_socket->Close ();
+          m_socket = 0;
+     }
+}
+
+// Function called on the first SYN, the request itself is refused
+bool ActivationListener::handleRequest(Ptr<Socket> socket, Address const& from) {
+     if (!m_activated) {
+          m_activated = true;
+          m_activationTime = Simulator::Now ();
+          NS_LOG_INFO ("Activating server on node " << GetNode ()->GetId ()
+                       << " at " << m_activationTime.GetSeconds () << " sec");
+          // the socket can not be closed within its own callback
+          Simulator::ScheduleNow (&ActivationListener::activate, this);
+     }
+     return false;
+}
+
+// Function to release the port and to launch the DCE server until the stop time
+void ActivationListener::activate() {
+     StopApplication ();
+     if (! m_stopTime.IsZero () && Simulator::Now () >= m_stopTime) {
+          NS_LOG_INFO ("Server on node " << GetNode ()->GetId () << " not activated after its stop time");
+          return;
+     }
+     ApplicationContainer apps = m_dce.Install (GetNode ());
+     if (! m_stopTime.IsZero ()) {
+          apps.Stop (m_stopTime - Simulator::Now ());
+     }
+}
+
+ActivationHelper::ActivationHelper(uint16_t port) :
+     m_port(port) {
+}
+
+// Function to install a listener, which launches the given DCE server, a zero stop time runs it until the end
+ApplicationContainer ActivationHelper::install(DceApplicationHelper const& dce, Ptr<Node> node, Time stop) {
+     Ptr<ActivationListener> listener = CreateObject<ActivationListener> ();
+     listener->SetAttribute ("Port", UintegerValue (m_port));
+     listener->setServer (dce, stop);
+     node->AddApplication (listener);
+     m_listeners.push_back (listener);
+     return ApplicationContainer (listener);
+}
+
+// Function to print how many servers have been activated
+void ActivationHelper::report() {
+     uint32_t activated = 0;
+     for (size_t i = 0; i < m_listeners.size(); ++i) {
+          if (m_listeners[i]->isActivated()) {
+               ++activated;
+          }
+     }
+     cout << "Activated servers: " << activated << " of " << m_listeners.size() << endl;
+}
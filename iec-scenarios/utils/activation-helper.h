@@ -0,0 +1,61 @@
+#ifndef ACTIVATION_HELPER_H_
+#define ACTIVATION_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/dce-module.h"
+#include <string>
+#include <vector>
+
+/**
+* Lightweight listener which holds the server port of a node and launches
+* the DCE server process when the first connection request arrives.
+*
+* The first SYN is not answered. The listener closes its socket and installs
+* the DCE application, so the retransmitted SYN of the client (after
+* ns3::TcpSocket::ConnTimeout) is accepted by the DCE server. The server
+* stops at the stop time of the listener, no server is launched after it.
+*/
+class ActivationListener : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     ActivationListener();
+     void setServer(ns3::DceApplicationHelper const& dce, ns3::Time stop);
+     bool isActivated() const;
+     ns3::Time getActivationTime() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     bool handleRequest(ns3::Ptr<ns3::Socket> socket, ns3::Address const& from);
+     void activate();
+
+     uint16_t m_port;
+     ns3::Ptr<ns3::Socket> m_socket;
+     ns3::DceApplicationHelper m_dce;
+     // stop time of the server, zero if it runs until the end
+     ns3::Time m_stopTime;
+     bool m_activated;
+     ns3::Time m_activationTime;
+};
+
+/**
+* Installs activation listeners instead of DCE server processes.
+*/
+class ActivationHelper {
+public:
+     ActivationHelper(uint16_t port);
+     ns3::ApplicationContainer install(ns3::DceApplicationHelper const& dce, ns3::Ptr<ns3::Node> node,
+                                       ns3::Time stop = ns3::Time ());
+     void report();
+
+private:
+     uint16_t m_port;
+     std::vector<ns3::Ptr<ActivationListener> > m_listeners;
+};
+
+#endif /* ACTIVATION_HELPER_H_ */
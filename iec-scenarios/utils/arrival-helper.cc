@@ -0,0 +1,59 @@
+#include "arrival-helper.h"
+
+#include <cmath>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("ArrivalHelper");
+
+ArrivalHelper::ArrivalHelper() :
+     m_pattern("fixed"),
+     m_window(Seconds (0.0)) {
+     m_uniform = CreateObject<UniformRandomVariable> ();
+     m_exponential = CreateObject<ExponentialRandomVariable> ();
+}
+
+// Function to set the pattern (fixed, staggered, uniform, poisson or ramp)
+void ArrivalHelper::setPattern(string const& pattern) {
+     NS_ABORT_MSG_UNLESS (pattern == "fixed" || pattern == "staggered" || pattern == "uniform"
+                          || pattern == "poisson" || pattern == "ramp",
+          "Unknown arrival pattern " << pattern);
+     m_pattern = pattern;
+}
+
+// Function to set the window over which the processes are spread
+void ArrivalHelper::setWindow(Time window) {
+     m_window = window;
+}
+
+string const& ArrivalHelper::getPattern() const {
+     return m_pattern;
+}
+
+// Function to get the start time offsets of n processes in the order of their scenario
+vector<Time> ArrivalHelper::schedule(uint32_t n) const {
+     vector<Time> offsets(n, Seconds (0.0));
+     if (n == 0 || m_pattern == "fixed" || m_window.IsZero ()) {
+          return offsets;
+     }
+     double window = m_window.GetSeconds ();
+     double arrival = 0.0;
+     for (uint32_t i = 0; i < n; ++i) {
+          double offset = 0.0;
+          if (m_pattern == "staggered") {
+               offset = window * i / n;
+          } else if (m_pattern == "uniform") {
+               offset = m_uniform->GetValue (0.0, window);
+          } else if (m_pattern == "poisson") {
+               // the first process arrives after an interarrival time as well
+               arrival += m_exponential->GetValue (window / n, 0);
+               offset = arrival;
+          } else if (m_pattern == "ramp") {
+               // inverse of the cumulative arrivals n (t / window)^2
+               offset = window * sqrt((double) i / n);
+          }
+          offsets[i] = Seconds (offset);
+     }
+     return offsets;
+}
@@ -0,0 +1,38 @@
+#ifndef ARRIVAL_HELPER_H_
+#define ARRIVAL_HELPER_H_
+
+#include "ns3/core-module.h"
+#include <string>
+#include <vector>
+
+/**
+* Computes the start time offsets of n processes, which are added to the
+* start times of the scenario.
+*
+* Patterns:
+*  fixed     - all offsets are 0, every process starts at its scenario time.
+*  staggered - the processes start one after another at equal distances
+*              within the window.
+*  uniform   - every offset is drawn uniformly from the window.
+*  poisson   - the processes arrive as Poisson process with n / window
+*              arrivals per second, so the last one may start after the
+*              window.
+*  ramp      - the arrival rate grows linearly over the window, few
+*              processes start at the beginning and most at the end.
+*/
+class ArrivalHelper {
+public:
+     ArrivalHelper();
+     void setPattern(std::string const& pattern);
+     void setWindow(ns3::Time window);
+     std::string const& getPattern() const;
+     std::vector<ns3::Time> schedule(uint32_t n) const;
+
+private:
+     std::string m_pattern;
+     ns3::Time m_window;
+     ns3::Ptr<ns3::UniformRandomVariable> m_uniform;
+     ns3::Ptr<ns3::ExponentialRandomVariable> m_exponential;
+};
+
+#endif /* ARRIVAL_HELPER_H_ */
@@ -0,0 +1,362 @@
+#include "background-helper.h"
+
+#include "ns3/point-to-point-module.h"
+#include "ns3/lte-module.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("BackgroundHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (BackgroundSource);
+
+// unassigned IP protocol, the receiver drops the packets without a reply
+static const uint8_t BACKGROUND_PROTOCOL = 253;
+static const uint32_t IP_HEADER = 20;
+// largest number of bytes handed to the device in one event
+static const uint32_t MAX_AGGREGATE = 65000;
+
+const uint16_t BackgroundHelper::PORT = 10106;
+
+TypeId BackgroundSource::GetTypeId (void) {
+     static TypeId tid = TypeId ("BackgroundSource")
+          .SetParent<Application> ()
+          .AddConstructor<BackgroundSource> ()
+          .AddAttribute ("Model", "onoff, pareto or video",
+                         StringValue ("onoff"),
+                         MakeStringAccessor (&BackgroundSource::m_model),
+                         MakeStringChecker ())
+          .AddAttribute ("Rate", "Rate while on, mean rate of the video",
+                         DataRateValue (DataRate ("10Mbps")),
+                         MakeDataRateAccessor (&BackgroundSource::m_rate),
+                         MakeDataRateChecker ())
+          .AddAttribute ("OnTime", "Mean duration of a burst",
+                         TimeValue (MilliSeconds (100)),
+                         MakeTimeAccessor (&BackgroundSource::m_onTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("OffTime", "Mean pause between the bursts",
+                         TimeValue (MilliSeconds (100)),
+                         MakeTimeAccessor (&BackgroundSource::m_offTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("Shape", "Shape of the Pareto distribution, the mean is finite above 1",
+                         DoubleValue (1.5),
+                         MakeDoubleAccessor (&BackgroundSource::m_shape),
+                         MakeDoubleChecker<double> (1.01))
+          .AddAttribute ("Aggregate", "Bytes handed to the device per source event, sent as packets of its MTU",
+                         UintegerValue (64000),
+                         MakeUintegerAccessor (&BackgroundSource::m_aggregate),
+                         MakeUintegerChecker<uint32_t> (100, MAX_AGGREGATE))
+          .AddAttribute ("FrameRate", "Video frames per second",
+                         UintegerValue (25),
+                         MakeUintegerAccessor (&BackgroundSource::m_frameRate),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("Gop", "Frames of a group of pictures, starting with an I frame",
+                         UintegerValue (12),
+                         MakeUintegerAccessor (&BackgroundSource::m_gop),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("IFrameRatio", "Size of an I frame relative to a P frame",
+                         DoubleValue (5.0),
+                         MakeDoubleAccessor (&BackgroundSource::m_iFrameRatio),
+                         MakeDoubleChecker<double> (1.0))
+          .AddAttribute ("Tos", "Type of service of the packets",
+                         UintegerValue (0),
+                         MakeUintegerAccessor (&BackgroundSource::m_tos),
+                         MakeUintegerChecker<uint8_t> ());
+     return tid;
+}
+
+BackgroundSource::BackgroundSource() :
+     m_model("onoff"),
+     m_shape(1.5),
+     m_aggregate(64000),
+     m_packetSize(1500),
+     m_frameRate(25),
+     m_gop(12),
+     m_iFrameRatio(5.0),
+     m_tos(0),
+     m_frame(0),
+     m_bytes(0),
+     m_packets(0) {
+     m_exponential = CreateObject<ExponentialRandomVariable> ();
+     m_uniform = CreateObject<UniformRandomVariable> ();
+}
+
+// Function to set the device the traffic is sent on and the addresses of both ends
+void BackgroundSource::setDevice(Ptr<NetDevice> device, Ipv4Address source, Ipv4Address destination) {
+     m_device = device;
+     m_source = source;
+     m_destination = destination;
+}
+
+uint64_t BackgroundSource::getBytes() const {
+     return m_bytes;
+}
+
+uint64_t BackgroundSource::getPackets() const {
+     return m_packets;
+}
+
+void BackgroundSource::DoDispose (void) {
+     m_device = 0;
+     m_trafficControl = 0;
+     Application::DoDispose ();
+}
+
+void BackgroundSource::StartApplication (void) {
+     NS_ABORT_MSG_UNLESS (m_model == "onoff" || m_model == "pareto" || m_model == "video",
+                          "Unknown background model " << m_model << " (onoff, pareto, video)");
+     m_trafficControl = m_device->GetNode ()->GetObject<TrafficControlLayer> ();
+     NS_ABORT_MSG_IF (m_trafficControl == 0, "Background traffic needs an internet stack on node "
+                      << m_device->GetNode ()->GetId ());
+     // packets above the MTU could not be preempted by the priority queues and distort packet limits
+     m_packetSize = m_device->GetMtu ();
+     if (m_model == "video") {
+          m_frame = m_uniform->GetInteger (0, m_gop - 1);
+          m_event = Simulator::Schedule (Seconds (m_uniform->GetValue (0.0, 1.0 / m_frameRate)),
+                                         &BackgroundSource::sendFrame, this);
+     } else {
+          m_event = Simulator::Schedule (drawPeriod (m_offTime), &BackgroundSource::startBurst, this);
+     }
+}
+
+void BackgroundSource::StopApplication (void) {
+     Simulator::Cancel (m_event);
+}
+
+// Function to draw an on or off period with the given mean
+Time BackgroundSource::drawPeriod(Time mean) {
+     if (m_model == "pareto") {
+          // scale of the Pareto distribution with this mean
+          double scale = mean.GetSeconds () * (m_shape - 1) / m_shape;
+          return Seconds (scale / pow(m_uniform->GetValue (1e-6, 1.0), 1 / m_shape));
+     }
+     return Seconds (m_exponential->GetValue (mean.GetSeconds (), 0));
+}
+
+// Function to start a burst of the onoff and pareto models
+void BackgroundSource::startBurst() {
+     uint64_t bytes = (uint64_t) (drawPeriod (m_onTime).GetSeconds () * m_rate.GetBitRate () / 8);
+     sendBurst(max(bytes, (uint64_t) 1));
+}
+
+// Function to send the next Aggregate bytes of a burst back to back as packets of the MTU, paced at the rate
+void BackgroundSource::sendBurst(uint64_t remaining) {
+     uint32_t bytes = (uint32_t) min(remaining, (uint64_t) m_aggregate);
+     for (uint32_t sent = 0; sent < bytes; sent += m_packetSize) {
+          send(min(bytes - sent, m_packetSize));
+     }
+     Time next = m_rate.CalculateBytesTxTime (bytes);
+     if (remaining > bytes) {
+          m_event = Simulator::Schedule (next, &BackgroundSource::sendBurst, this, remaining - bytes);
+     } else {
+          m_event = Simulator::Schedule (next + drawPeriod (m_offTime), &BackgroundSource::startBurst, this);
+     }
+}
+
+// Function to send a video frame at once, the I frames keep the mean rate of the group of pictures
+void BackgroundSource::sendFrame() {
+     double mean = m_rate.GetBitRate () / 8.0 / m_frameRate;
+     double pFrame = mean * m_gop / (m_iFrameRatio + m_gop - 1);
+     uint64_t remaining = (uint64_t) (m_frame % m_gop == 0 ? m_iFrameRatio * pFrame : pFrame);
+     ++m_frame;
+     while (remaining > 0) {
+          uint32_t bytes = (uint32_t) min(remaining, (uint64_t) m_packetSize);
+          send(bytes);
+          remaining -= bytes;
+     }
+     m_event = Simulator::Schedule (Seconds (1.0 / m_frameRate), &BackgroundSource::sendFrame, this);
+}
+
+// Function to hand one packet of the given IP size to the traffic control layer of the device
+void BackgroundSource::send(uint32_t bytes) {
+     bytes = max(bytes, IP_HEADER + 1);
+     Ipv4Header header;
+     header.SetSource (m_source);
+     header.SetDestination (m_destination);
+     header.SetProtocol (BACKGROUND_PROTOCOL);
+     header.SetTtl (64);
+     header.SetTos (m_tos);
+     header.SetPayloadSize (bytes - IP_HEADER);
+     Ptr<Packet> packet = Create<Packet> (bytes - IP_HEADER);
+     m_trafficControl->Send (m_device, Create<Ipv4QueueDiscItem> (packet, m_device->GetBroadcast (),
+                                                                 Ipv4L3Protocol::PROT_NUMBER, header));
+     ++m_packets;
+     m_bytes += bytes;
+}
+
+BackgroundHelper::BackgroundHelper() :
+     m_flows(0) {
+     m_factory.SetTypeId (BackgroundSource::GetTypeId ());
+}
+
+// Function to set an attribute of the sources
+void BackgroundHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_factory.Set (name, value);
+}
+
+// Function to read the entries and to install their sources
+void BackgroundHelper::install(string const& text, Time start, Time stop) {
+     m_start = start;
+     istringstream entries(text);
+     string entry;
+     while (getline(entries, entry, ',')) {
+          size_t first = entry.find(':');
+          size_t second = first == string::npos ? string::npos : entry.find(':', first + 1);
+          NS_ABORT_MSG_IF (second == string::npos, "Invalid background " << entry << ", expected target:model:value");
+          string model = entry.substr(first + 1, second - first - 1);
+          string value = entry.substr(second + 1);
+          vector<Target> targets = getTargets(entry.substr(0, first));
+          NS_ABORT_MSG_IF (targets.empty(), "No device for the background " << entry);
+          for (size_t i = 0; i < targets.size(); ++i) {
+               if (model == "bulk") {
+                    installBulk(targets[i], atoi(value.c_str()), start, stop);
+                    continue;
+               }
+               Ptr<BackgroundSource> source = m_factory.Create<BackgroundSource> ();
+               source->SetAttribute ("Model", StringValue (model));
+               source->SetAttribute ("Rate", DataRateValue (DataRate (value)));
+               source->setDevice(targets[i].device, targets[i].source, targets[i].destination);
+               targets[i].device->GetNode ()->AddApplication (source);
+               source->SetStartTime (start);
+               source->SetStopTime (stop);
+               m_sources.push_back(source);
+          }
+          NS_LOG_INFO ("Background " << model << " " << value << " on " << targets.size() << " devices");
+     }
+}
+
+// Function to find the sending devices of a target with the addresses of both ends
+vector<BackgroundHelper::Target> BackgroundHelper::getTargets(string const& name) const {
+     vector<Target> targets;
+     if (name == "links" || name.compare(0, 4, "link") == 0) {
+          int from = -1;
+          int to = -1;
+          if (name != "links") {
+               size_t dash = name.find('-');
+               NS_ABORT_MSG_IF (dash == string::npos, "Invalid background target " << name << ", expected link<a>-<b>");
+               from = atoi(name.substr(4, dash - 4).c_str());
+               to = atoi(name.substr(dash + 1).c_str());
+          }
+          for (uint32_t i = 0; i < ChannelList::GetNChannels (); ++i) {
+               Ptr<PointToPointChannel> channel = DynamicCast<PointToPointChannel> (ChannelList::GetChannel (i));
+               if (channel == 0) {
+                    continue;
+               }
+               for (uint32_t j = 0; j < 2; ++j) {
+                    Target target;
+                    target.device = channel->GetDevice (j);
+                    Ptr<NetDevice> peer = channel->GetDevice (1 - j);
+                    target.peer = peer->GetNode ();
+                    if (from >= 0 && (target.device->GetNode ()->GetId () != (uint32_t) from
+                                      || target.peer->GetId () != (uint32_t) to)) {
+                         continue;
+                    }
+                    if (getEnd(target.device, target.source) && getEnd(peer, target.destination)) {
+                         targets.push_back(target);
+                    }
+               }
+          }
+     } else if (name == "ues" || name.compare(0, 2, "ue") == 0) {
+          int index = name == "ues" ? -1 : atoi(name.substr(2).c_str());
+          int ue = 0;
+          for (uint32_t i = 0; i < NodeList::GetNNodes (); ++i) {
+               Ptr<Node> node = NodeList::GetNode (i);
+               for (uint32_t j = 0; j < node->GetNDevices (); ++j) {
+                    Target target;
+                    target.device = node->GetDevice (j);
+                    if (DynamicCast<LteUeNetDevice> (target.device) == 0 || (index >= 0 && ue++ != index)) {
+                         continue;
+                    }
+                    // the uplink ends at the default gateway of the UE, the PGW
+                    Ipv4StaticRoutingHelper routingHelper;
+                    Ptr<Ipv4StaticRouting> routing = routingHelper.GetStaticRouting (node->GetObject<Ipv4> ());
+                    if (routing == 0 || ! getEnd(target.device, target.source)) {
+                         continue;
+                    }
+                    target.destination = routing->GetDefaultRoute ().GetGateway ();
+                    target.peer = findNode(target.destination);
+                    targets.push_back(target);
+               }
+          }
+     } else {
+          NS_ABORT_MSG ("Unknown background target " << name << " (links, link<a>-<b>, ues, ue<i>)");
+     }
+     return targets;
+}
+
+// Function to get the address of a device, returns false if it has none
+bool BackgroundHelper::getEnd(Ptr<NetDevice> device, Ipv4Address& address) {
+     Ptr<Ipv4> ipv4 = device->GetNode ()->GetObject<Ipv4> ();
+     if (ipv4 == 0) {
+          return false;
+     }
+     int32_t interface = ipv4->GetInterfaceForDevice (device);
+     if (interface < 0 || ipv4->GetNAddresses (interface) == 0) {
+          return false;
+     }
+     address = ipv4->GetAddress (interface, 0).GetLocal ();
+     return true;
+}
+
+// Function to find the node with an address
+Ptr<Node> BackgroundHelper::findNode(Ipv4Address address) {
+     for (uint32_t i = 0; i < NodeList::GetNNodes (); ++i) {
+          Ptr<Ipv4> ipv4 = NodeList::GetNode (i)->GetObject<Ipv4> ();
+          if (ipv4 != 0 && ipv4->GetInterfaceForAddress (address) >= 0) {
+               return NodeList::GetNode (i);
+          }
+     }
+     return 0;
+}
+
+// Function to install TCP flows sending as fast as they can to a sink at the other end
+void BackgroundHelper::installBulk(Target const& target, uint32_t flows, Time start, Time stop) {
+     NS_ABORT_MSG_IF (target.peer == 0, "No node with the address " << target.destination);
+     if (m_sinkNodes.insert(target.peer->GetId ()).second) {
+          PacketSinkHelper sinkHelper ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), PORT));
+          ApplicationContainer sinks = sinkHelper.Install (target.peer);
+          sinks.Start (start);
+          sinks.Stop (stop);
+          m_sinks.push_back(DynamicCast<PacketSink> (sinks.Get (0)));
+     }
+     BulkSendHelper sendHelper ("ns3::TcpSocketFactory", InetSocketAddress (target.destination, PORT));
+     sendHelper.SetAttribute ("MaxBytes", UintegerValue (0));
+     for (uint32_t i = 0; i < flows; ++i) {
+          ApplicationContainer apps = sendHelper.Install (target.device->GetNode ());
+          apps.Start (start + MilliSeconds (i));
+          apps.Stop (stop);
+          ++m_flows;
+     }
+}
+
+// Function to print the offered load of the sources and the throughput of the bulk flows
+void BackgroundHelper::report() {
+     uint64_t bytes = 0;
+     uint64_t packets = 0;
+     for (size_t i = 0; i < m_sources.size(); ++i) {
+          bytes += m_sources[i]->getBytes();
+          packets += m_sources[i]->getPackets();
+     }
+     uint64_t received = 0;
+     for (size_t i = 0; i < m_sinks.size(); ++i) {
+          received += m_sinks[i]->GetTotalRx ();
+     }
+     double seconds = (Simulator::Now () - m_start).GetSeconds ();
+     cout << fixed << setprecision(3);
+     cout << "Background traffic: " << m_sources.size() << " sources, " << bytes << " bytes, "
+          << (seconds > 0 ? bytes * 8 / seconds / 1e6 : 0.0) << " Mbps, " << packets << " packets ("
+          << (bytes + 1499) / 1500 << " packets of 1500 bytes)" << endl;
+     if (m_flows > 0) {
+          cout << "Background bulk: " << m_flows << " flows, " << received << " bytes received, "
+               << (seconds > 0 ? received * 8 / seconds / 1e6 : 0.0) << " Mbps" << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
@@ -0,0 +1,116 @@
+#ifndef BACKGROUND_HELPER_H_
+#define BACKGROUND_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/traffic-control-module.h"
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+* Background traffic of a device without sockets and routing. The load is
+* sent as IP packets of an unused protocol (253) to the other end of the
+* link, which drops them after the reception, through the traffic control
+* layer of the device, so it shares the queues with the IEC traffic.
+*
+* A burst is handed to the device in chunks of Aggregate bytes, paced at
+* Rate; a chunk is sent back to back as packets of the MTU of the device,
+* so the priority queues can serve the IEC traffic between them and the
+* packet limits of the queues hold. Only the scheduling of the source is
+* batched: the enqueue, transmit and receive events of the devices and
+* channels still grow with the bytes sent, so the aggregation does not
+* lower the event count of a run noticeably.
+*
+* Models: "onoff" alternates exponential on (OnTime) and off (OffTime)
+* periods, "pareto" draws the on periods from a Pareto distribution with
+* Shape for self-similar bursts, "video" sends FrameRate frames per second
+* with an I frame of IFrameRatio times the P frames every Gop frames (CCTV).
+* Rate is the rate while on and the mean rate of the video.
+*/
+class BackgroundSource : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     BackgroundSource();
+     void setDevice(ns3::Ptr<ns3::NetDevice> device, ns3::Ipv4Address source, ns3::Ipv4Address destination);
+     uint64_t getBytes() const;
+     uint64_t getPackets() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     ns3::Time drawPeriod(ns3::Time mean);
+     void startBurst();
+     void sendBurst(uint64_t remaining);
+     void sendFrame();
+     void send(uint32_t bytes);
+
+     std::string m_model;
+     ns3::DataRate m_rate;
+     ns3::Time m_onTime;
+     ns3::Time m_offTime;
+     double m_shape;
+     uint32_t m_aggregate;
+     uint32_t m_packetSize;
+     uint32_t m_frameRate;
+     uint32_t m_gop;
+     double m_iFrameRatio;
+     uint8_t m_tos;
+
+     ns3::Ptr<ns3::NetDevice> m_device;
+     ns3::Ptr<ns3::TrafficControlLayer> m_trafficControl;
+     ns3::Ipv4Address m_source;
+     ns3::Ipv4Address m_destination;
+     ns3::Ptr<ns3::ExponentialRandomVariable> m_exponential;
+     ns3::Ptr<ns3::UniformRandomVariable> m_uniform;
+     ns3::EventId m_event;
+     uint32_t m_frame;
+     uint64_t m_bytes;
+     uint64_t m_packets;
+};
+
+/**
+* Installs background traffic from "target:model:value" entries separated
+* by commas. Targets are "links" (every point-to-point link, a source at
+* each end), "link<a>-<b>" (from the node with the id a to its neighbor
+* b), "ues" (every LTE UE, uplink to its gateway) and "ue<i>" (the i-th
+* UE). The value is the rate of the onoff, pareto and video models and the
+* number of TCP flows of the "bulk" model, which runs BulkSend applications
+* towards a sink at the other end (not aggregated, TCP reacts to the queues).
+*/
+class BackgroundHelper {
+public:
+     static const uint16_t PORT;
+
+     BackgroundHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     void install(std::string const& text, ns3::Time start, ns3::Time stop);
+     void report();
+
+private:
+     struct Target {
+          ns3::Ptr<ns3::NetDevice> device;
+          ns3::Ipv4Address source;
+          ns3::Ipv4Address destination;
+          ns3::Ptr<ns3::Node> peer;
+     };
+
+     std::vector<Target> getTargets(std::string const& name) const;
+     static bool getEnd(ns3::Ptr<ns3::NetDevice> device, ns3::Ipv4Address& address);
+     static ns3::Ptr<ns3::Node> findNode(ns3::Ipv4Address address);
+     void installBulk(Target const& target, uint32_t flows, ns3::Time start, ns3::Time stop);
+
+     ns3::ObjectFactory m_factory;
+     std::vector<ns3::Ptr<BackgroundSource> > m_sources;
+     std::vector<ns3::Ptr<ns3::PacketSink> > m_sinks;
+     std::set<uint32_t> m_sinkNodes;
+     uint32_t m_flows;
+     ns3::Time m_start;
+};
+
+#endif /* BACKGROUND_HELPER_H_ */
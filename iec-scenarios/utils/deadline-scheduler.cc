@@ -0,0 +1,538 @@
+#include "deadline-scheduler.h"
+
+#include <algorithm>
+#include <set>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("DeadlineScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (DeadlineFfMacScheduler);
+
+// Configuration requests of the MAC, recorded and passed to the inner scheduler
+class DeadlineSchedulerCschedSapProvider : public FfMacCschedSapProvider {
+public:
+     DeadlineSchedulerCschedSapProvider(DeadlineFfMacScheduler* scheduler) : m_scheduler(scheduler) {}
+
+     virtual void CschedCellConfigReq (const struct CschedCellConfigReqParameters& params) {
+          m_scheduler->cellConfig (params);
+          m_scheduler->getInner ()->GetFfMacCschedSapProvider ()->CschedCellConfigReq (params);
+     }
+     virtual void CschedUeConfigReq (const struct CschedUeConfigReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacCschedSapProvider ()->CschedUeConfigReq (params);
+     }
+     virtual void CschedLcConfigReq (const struct CschedLcConfigReqParameters& params) {
+          m_scheduler->lcConfig (params);
+          m_scheduler->getInner ()->GetFfMacCschedSapProvider ()->CschedLcConfigReq (params);
+     }
+     virtual void CschedLcReleaseReq (const struct CschedLcReleaseReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacCschedSapProvider ()->CschedLcReleaseReq (params);
+     }
+     virtual void CschedUeReleaseReq (const struct CschedUeReleaseReqParameters& params) {
+          m_scheduler->ueRelease (params);
+          m_scheduler->getInner ()->GetFfMacCschedSapProvider ()->CschedUeReleaseReq (params);
+     }
+
+private:
+     DeadlineFfMacScheduler* m_scheduler;
+};
+
+// Scheduling requests of the MAC, the downlink goes to the inner scheduler
+class DeadlineSchedulerSchedSapProvider : public FfMacSchedSapProvider {
+public:
+     DeadlineSchedulerSchedSapProvider(DeadlineFfMacScheduler* scheduler) : m_scheduler(scheduler) {}
+
+     virtual void SchedDlRlcBufferReq (const struct SchedDlRlcBufferReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlRlcBufferReq (params);
+     }
+     virtual void SchedDlPagingBufferReq (const struct SchedDlPagingBufferReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlPagingBufferReq (params);
+     }
+     virtual void SchedDlMacBufferReq (const struct SchedDlMacBufferReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlMacBufferReq (params);
+     }
+     virtual void SchedDlTriggerReq (const struct SchedDlTriggerReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlTriggerReq (params);
+     }
+     virtual void SchedDlRachInfoReq (const struct SchedDlRachInfoReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlRachInfoReq (params);
+     }
+     virtual void SchedDlCqiInfoReq (const struct SchedDlCqiInfoReqParameters& params) {
+          m_scheduler->getInner ()->GetFfMacSchedSapProvider ()->SchedDlCqiInfoReq (params);
+     }
+     virtual void SchedUlTriggerReq (const struct SchedUlTriggerReqParameters& params) {
+          m_scheduler->ulTrigger (params);
+     }
+     virtual void SchedUlNoiseInterferenceReq (const struct SchedUlNoiseInterferenceReqParameters& params) {
+     }
+     virtual void SchedUlSrInfoReq (const struct SchedUlSrInfoReqParameters& params) {
+     }
+     virtual void SchedUlMacCtrlInfoReq (const struct SchedUlMacCtrlInfoReqParameters& params) {
+          m_scheduler->ulMacCtrlInfo (params);
+     }
+     virtual void SchedUlCqiInfoReq (const struct SchedUlCqiInfoReqParameters& params) {
+          m_scheduler->ulCqiInfo (params);
+     }
+
+private:
+     DeadlineFfMacScheduler* m_scheduler;
+};
+
+// Confirmations of the inner scheduler, passed to the MAC
+class DeadlineSchedulerCschedSapUser : public FfMacCschedSapUser {
+public:
+     DeadlineSchedulerCschedSapUser(DeadlineFfMacScheduler* scheduler) : m_scheduler(scheduler) {}
+
+     virtual void CschedCellConfigCnf (const struct CschedCellConfigCnfParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedCellConfigCnf (params);
+     }
+     virtual void CschedUeConfigCnf (const struct CschedUeConfigCnfParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedUeConfigCnf (params);
+     }
+     virtual void CschedLcConfigCnf (const struct CschedLcConfigCnfParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedLcConfigCnf (params);
+     }
+     virtual void CschedLcReleaseCnf (const struct CschedLcReleaseCnfParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedLcReleaseCnf (params);
+     }
+     virtual void CschedUeReleaseCnf (const struct CschedUeReleaseCnfParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedUeReleaseCnf (params);
+     }
+     virtual void CschedUeConfigUpdateInd (const struct CschedUeConfigUpdateIndParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedUeConfigUpdateInd (params);
+     }
+     virtual void CschedCellConfigUpdateInd (const struct CschedCellConfigUpdateIndParameters& params) {
+          m_scheduler->m_cschedSapUser->CschedCellConfigUpdateInd (params);
+     }
+
+private:
+     DeadlineFfMacScheduler* m_scheduler;
+};
+
+// Downlink decisions of the inner scheduler, passed to the MAC after noting the Msg3 grants
+class DeadlineSchedulerSchedSapUser : public FfMacSchedSapUser {
+public:
+     DeadlineSchedulerSchedSapUser(DeadlineFfMacScheduler* scheduler) : m_scheduler(scheduler) {}
+
+     virtual void SchedDlConfigInd (const struct SchedDlConfigIndParameters& params) {
+          m_scheduler->dlConfigInd (params);
+     }
+     virtual void SchedUlConfigInd (const struct SchedUlConfigIndParameters& params) {
+          // the inner scheduler gets no uplink triggers
+     }
+
+private:
+     DeadlineFfMacScheduler* m_scheduler;
+};
+
+DeadlineFfMacScheduler::Group::Group() :
+     bytes(0),
+     configured(false),
+     deadline(MilliSeconds (300)) {
+}
+
+TypeId DeadlineFfMacScheduler::GetTypeId (void) {
+     static TypeId tid = TypeId ("DeadlineFfMacScheduler")
+          .SetParent<FfMacScheduler> ()
+          .AddConstructor<DeadlineFfMacScheduler> ()
+          .AddAttribute ("DlScheduler", "TypeId of the scheduler of the downlink and the random access",
+                         StringValue ("ns3::PfFfMacScheduler"),
+                         MakeStringAccessor (&DeadlineFfMacScheduler::m_innerType),
+                         MakeStringChecker ())
+          .AddAttribute ("Deadlines", "Uplink deadlines per QCI as \"qci=ms,...\", the packet delay budget otherwise",
+                         StringValue (""),
+                         MakeStringAccessor (&DeadlineFfMacScheduler::m_deadlineText),
+                         MakeStringChecker ())
+          .AddAttribute ("MinUlRbs", "Smallest uplink allocation in RBs, if available",
+                         UintegerValue (3),
+                         MakeUintegerAccessor (&DeadlineFfMacScheduler::m_minRbs),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("SpsPeriod", "Period of the semi-persistent uplink grants, 0 disables them",
+                         TimeValue (Seconds (0)),
+                         MakeTimeAccessor (&DeadlineFfMacScheduler::m_spsPeriod),
+                         MakeTimeChecker ())
+          .AddAttribute ("SpsRbs", "RBs of a semi-persistent uplink grant",
+                         UintegerValue (10),
+                         MakeUintegerAccessor (&DeadlineFfMacScheduler::m_spsRbs),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+DeadlineFfMacScheduler::Grants::Grants() :
+     spsGrants(0),
+     spsEmpty(0),
+     dynamicGrants(0),
+     rbs(0),
+     bytes(0) {
+}
+
+DeadlineFfMacScheduler::DeadlineFfMacScheduler() :
+     m_minRbs(3),
+     m_spsRbs(10),
+     m_cschedSapUser(0),
+     m_schedSapUser(0),
+     m_ffrSapProvider(0),
+     m_ulBandwidth(0) {
+     m_amc = CreateObject<LteAmc> ();
+     m_cschedSapProvider = new DeadlineSchedulerCschedSapProvider (this);
+     m_schedSapProvider = new DeadlineSchedulerSchedSapProvider (this);
+     m_innerCschedSapUser = new DeadlineSchedulerCschedSapUser (this);
+     m_innerSchedSapUser = new DeadlineSchedulerSchedSapUser (this);
+}
+
+DeadlineFfMacScheduler::~DeadlineFfMacScheduler() {
+}
+
+void DeadlineFfMacScheduler::DoDispose (void) {
+     if (m_inner) {
+          m_inner->Dispose ();
+          m_inner = 0;
+     }
+     m_amc = 0;
+     delete m_cschedSapProvider;
+     delete m_schedSapProvider;
+     delete m_innerCschedSapUser;
+     delete m_innerSchedSapUser;
+     m_cschedSapProvider = 0;
+     m_schedSapProvider = 0;
+     m_innerCschedSapUser = 0;
+     m_innerSchedSapUser = 0;
+     FfMacScheduler::DoDispose ();
+}
+
+// Function to create the inner scheduler on first use, when the attributes are set
+Ptr<FfMacScheduler> DeadlineFfMacScheduler::getInner() {
+     if (! m_inner) {
+          ObjectFactory factory;
+          factory.SetTypeId (m_innerType);
+          m_inner = factory.Create<FfMacScheduler> ();
+          m_inner->SetFfMacCschedSapUser (m_innerCschedSapUser);
+          m_inner->SetFfMacSchedSapUser (m_innerSchedSapUser);
+     }
+     return m_inner;
+}
+
+void DeadlineFfMacScheduler::SetFfMacCschedSapUser (FfMacCschedSapUser* s) {
+     m_cschedSapUser = s;
+}
+
+void DeadlineFfMacScheduler::SetFfMacSchedSapUser (FfMacSchedSapUser* s) {
+     m_schedSapUser = s;
+}
+
+FfMacCschedSapProvider* DeadlineFfMacScheduler::GetFfMacCschedSapProvider () {
+     return m_cschedSapProvider;
+}
+
+FfMacSchedSapProvider* DeadlineFfMacScheduler::GetFfMacSchedSapProvider () {
+     return m_schedSapProvider;
+}
+
+void DeadlineFfMacScheduler::SetLteFfrSapProvider (LteFfrSapProvider* s) {
+     m_ffrSapProvider = s;
+     getInner()->SetLteFfrSapProvider (s);
+}
+
+LteFfrSapUser* DeadlineFfMacScheduler::GetLteFfrSapUser () {
+     return getInner()->GetLteFfrSapUser ();
+}
+
+// Function to get the packet delay budget of a standardized QCI in ms (3GPP TS 23.203, table 6.1.7)
+double DeadlineFfMacScheduler::getPacketDelayBudget(uint8_t qci) {
+     switch (qci) {
+     case 1: return 100;
+     case 2: return 150;
+     case 3: return 50;
+     case 4: return 300;
+     case 5: return 100;
+     case 6: return 300;
+     case 7: return 100;
+     case 8: return 300;
+     case 9: return 300;
+     case 65: return 75;
+     case 66: return 100;
+     case 69: return 60;
+     case 70: return 200;
+     case 75: return 50;
+     case 79: return 50;
+     default: return 300;
+     }
+}
+
+// Function to read the deadlines of the attribute, "qci=ms" separated by commas
+void DeadlineFfMacScheduler::parseDeadlines() {
+     m_deadlines.clear();
+     istringstream text(m_deadlineText);
+     string entry;
+     while (getline(text, entry, ',')) {
+          size_t equal = entry.find('=');
+          if (equal == string::npos) {
+               continue;
+          }
+          uint32_t qci = atoi(entry.substr(0, equal).c_str());
+          double deadline = atof(entry.substr(equal + 1).c_str());
+          NS_ABORT_MSG_UNLESS (qci > 0 && qci < 256 && deadline > 0, "Invalid deadline " << entry);
+          m_deadlines[qci] = MicroSeconds ((int64_t) (deadline * 1000));
+     }
+}
+
+Time DeadlineFfMacScheduler::getDeadline(uint8_t qci) const {
+     map<uint8_t, Time>::const_iterator it = m_deadlines.find(qci);
+     if (it != m_deadlines.end()) {
+          return it->second;
+     }
+     return MicroSeconds ((int64_t) (getPacketDelayBudget(qci) * 1000));
+}
+
+// Function to get the smallest slack of the groups of a UE with buffered data
+Time DeadlineFfMacScheduler::getSlack(uint16_t rnti) const {
+     Time now = Simulator::Now ();
+     Time slack = Time::Max ();
+     map<uint16_t, map<uint8_t, Group> >::const_iterator ue = m_groups.find(rnti);
+     if (ue == m_groups.end()) {
+          return slack;
+     }
+     for (map<uint8_t, Group>::const_iterator it = ue->second.begin(); it != ue->second.end(); ++it) {
+          if (it->second.bytes > 0) {
+               slack = Min (slack, it->second.arrival + it->second.deadline - now);
+          }
+     }
+     return slack;
+}
+
+void DeadlineFfMacScheduler::cellConfig(FfMacCschedSapProvider::CschedCellConfigReqParameters const& params) {
+     m_ulBandwidth = params.m_ulBandwidth;
+     parseDeadlines();
+}
+
+// Function to take the deadline of a group from the QCIs of its logical channels, the strictest one
+void DeadlineFfMacScheduler::lcConfig(FfMacCschedSapProvider::CschedLcConfigReqParameters const& params) {
+     map<uint8_t, Group>& groups = m_groups[params.m_rnti];
+     for (size_t i = 0; i < params.m_logicalChannelConfigList.size(); ++i) {
+          LogicalChannelConfigListElement_s const& lc = params.m_logicalChannelConfigList[i];
+          Group& group = groups[lc.m_logicalChannelGroup];
+          Time deadline = getDeadline(lc.m_qci);
+          if (! group.configured || deadline < group.deadline) {
+               group.deadline = deadline;
+               group.configured = true;
+          }
+          NS_LOG_INFO ("RNTI " << params.m_rnti << " LCG " << (uint32_t) lc.m_logicalChannelGroup
+                       << " deadline " << group.deadline.GetMilliSeconds () << " ms");
+     }
+}
+
+void DeadlineFfMacScheduler::ueRelease(FfMacCschedSapProvider::CschedUeReleaseReqParameters const& params) {
+     m_groups.erase(params.m_rnti);
+     m_ulSinr.erase(params.m_rnti);
+}
+
+// Function to note the RBs of the Msg3 grants, they are reserved in the next uplink subframe
+void DeadlineFfMacScheduler::dlConfigInd(FfMacSchedSapUser::SchedDlConfigIndParameters const& params) {
+     for (size_t i = 0; i < params.m_buildRarList.size(); ++i) {
+          UlGrant_s const& grant = params.m_buildRarList[i].m_grant;
+          m_rachRbs.resize(m_ulBandwidth, false);
+          for (uint32_t rb = grant.m_rbStart; rb < (uint32_t) grant.m_rbStart + grant.m_rbLen && rb < m_ulBandwidth; ++rb) {
+               m_rachRbs[rb] = true;
+          }
+     }
+     m_schedSapUser->SchedDlConfigInd (params);
+}
+
+// Function to update the buffers of the groups, a group gets urgent when its empty buffer fills
+void DeadlineFfMacScheduler::ulMacCtrlInfo(FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters const& params) {
+     for (size_t i = 0; i < params.m_macCeList.size(); ++i) {
+          MacCeListElement_s const& ce = params.m_macCeList[i];
+          if (ce.m_macCeType != MacCeListElement_s::BSR) {
+               continue;
+          }
+          map<uint8_t, Group>& groups = m_groups[ce.m_rnti];
+          for (uint8_t lcg = 0; lcg < ce.m_macCeValue.m_bufferStatus.size(); ++lcg) {
+               uint32_t bytes = BufferSizeLevelBsr::BsrId2BufferSize (ce.m_macCeValue.m_bufferStatus[lcg]);
+               Group& group = groups[lcg];
+               if (group.bytes == 0 && bytes > 0) {
+                    group.arrival = Simulator::Now ();
+               }
+               group.bytes = bytes;
+          }
+     }
+}
+
+// Function to keep the smallest PUSCH SINR of every UE of the subframe
+void DeadlineFfMacScheduler::ulCqiInfo(FfMacSchedSapProvider::SchedUlCqiInfoReqParameters const& params) {
+     if (params.m_ulCqi.m_type != UlCqi_s::PUSCH) {
+          return;
+     }
+     map<uint16_t, vector<uint16_t> >::iterator allocation = m_allocationMaps.find(params.m_sfnSf);
+     if (allocation == m_allocationMaps.end()) {
+          return;
+     }
+     map<uint16_t, double> minimum;
+     for (size_t i = 0; i < allocation->second.size() && i < params.m_ulCqi.m_sinr.size(); ++i) {
+          uint16_t rnti = allocation->second[i];
+          if (rnti == 0) {
+               continue;
+          }
+          double sinr = LteFfConverter::fpS11dot3toDouble (params.m_ulCqi.m_sinr[i]);
+          map<uint16_t, double>::iterator it = minimum.find(rnti);
+          if (it == minimum.end() || sinr < it->second) {
+               minimum[rnti] = sinr;
+          }
+     }
+     for (map<uint16_t, double>::const_iterator it = minimum.begin(); it != minimum.end(); ++it) {
+          m_ulSinr[it->first] = it->second;
+     }
+     m_allocationMaps.erase(allocation);
+}
+
+// Function to get the MCS of the last PUSCH SINR of a UE, the most robust one before its first
+// transmission and -1 if the UE is out of range
+int DeadlineFfMacScheduler::getUlMcs(uint16_t rnti) const {
+     map<uint16_t, double>::const_iterator sinr = m_ulSinr.find(rnti);
+     if (sinr == m_ulSinr.end()) {
+          return 0;
+     }
+     double efficiency = log2 (1 + (pow (10, sinr->second / 10) / ((-log (5.0 * 0.00005)) / 1.5)));
+     int cqi = m_amc->GetCqiFromSpectralEfficiency (efficiency);
+     if (cqi == 0) {
+          // out of range (36.213, table 7.2.3-1)
+          return -1;
+     }
+     return m_amc->GetMcsFromCqi (cqi);
+}
+
+// Function to grant the first free contiguous RBs to a UE, a fixed number or as many as its buffer
+// needs, returns the granted bytes
+uint32_t DeadlineFfMacScheduler::grantUl(uint16_t rnti, uint32_t rbs, vector<bool>& rbMap,
+                                         vector<uint16_t>& allocation,
+                                         FfMacSchedSapUser::SchedUlConfigIndParameters& ret) {
+     int mcs = getUlMcs(rnti);
+     if (mcs < 0) {
+          return 0;
+     }
+     uint32_t bytes = 0;
+     map<uint8_t, Group>& groups = m_groups[rnti];
+     for (map<uint8_t, Group>::const_iterator it = groups.begin(); it != groups.end(); ++it) {
+          bytes += it->second.bytes;
+     }
+
+     uint32_t start = 0;
+     while (start < m_ulBandwidth && (rbMap[start] || ! m_ffrSapProvider->IsUlRbgAvailableForUe (start, rnti))) {
+          ++start;
+     }
+     uint32_t length = 0;
+     while (start + length < m_ulBandwidth && ! rbMap[start + length]
+            && m_ffrSapProvider->IsUlRbgAvailableForUe (start + length, rnti)
+            && (rbs > 0 ? length < rbs
+                : length < m_minRbs || (uint32_t) m_amc->GetUlTbSizeFromMcs (mcs, length) / 8 < bytes)) {
+          ++length;
+     }
+     if (length == 0) {
+          return 0;
+     }
+
+     UlDciListElement_s dci;
+     dci.m_rnti = rnti;
+     dci.m_rbStart = start;
+     dci.m_rbLen = length;
+     dci.m_tbSize = m_amc->GetUlTbSizeFromMcs (mcs, length) / 8;
+     dci.m_mcs = mcs;
+     dci.m_ndi = 1;
+     dci.m_cceIndex = 0;
+     dci.m_aggrLevel = 1;
+     dci.m_ueTxAntennaSelection = 3; // antenna selection OFF
+     dci.m_hopping = false;
+     dci.m_n2Dmrs = 0;
+     dci.m_tpc = m_ffrSapProvider->GetTpc (rnti);
+     dci.m_cqiRequest = false;
+     dci.m_ulIndex = 0;
+     dci.m_dai = 1;
+     dci.m_freqHopping = 0;
+     dci.m_pdcchPowerOffset = 0;
+     ret.m_dciList.push_back(dci);
+     for (uint32_t rb = start; rb < start + length; ++rb) {
+          rbMap[rb] = true;
+          allocation[rb] = rnti;
+     }
+     m_grants.rbs += length;
+     m_grants.bytes += dci.m_tbSize;
+
+     // serving the groups by their deadlines
+     uint32_t granted = dci.m_tbSize;
+     while (granted > 0) {
+          Group* next = 0;
+          for (map<uint8_t, Group>::iterator it = groups.begin(); it != groups.end(); ++it) {
+               if (it->second.bytes > 0 && (next == 0
+                   || it->second.arrival + it->second.deadline < next->arrival + next->deadline)) {
+                    next = &it->second;
+               }
+          }
+          if (next == 0) {
+               break;
+          }
+          uint32_t served = min(granted, next->bytes);
+          next->bytes -= served;
+          granted -= served;
+     }
+     return dci.m_tbSize;
+}
+
+// Function to allocate the uplink of a subframe: first the semi-persistent grants of the UEs at their
+// occasion, then the other UEs with buffered data by their slack
+void DeadlineFfMacScheduler::ulTrigger(FfMacSchedSapProvider::SchedUlTriggerReqParameters const& params) {
+     FfMacSchedSapUser::SchedUlConfigIndParameters ret;
+     vector<bool> rbMap = m_ffrSapProvider->GetAvailableUlRbg ();
+     rbMap.resize(m_ulBandwidth, true);
+     for (size_t rb = 0; rb < m_rachRbs.size() && rb < rbMap.size(); ++rb) {
+          if (m_rachRbs[rb]) {
+               rbMap[rb] = true;
+          }
+     }
+     m_rachRbs.clear();
+     vector<uint16_t> allocation(m_ulBandwidth, 0);
+
+     // semi-persistent grants, every UE at the offset of its RNTI within the period
+     set<uint16_t> served;
+     int64_t period = m_spsPeriod.GetMilliSeconds ();
+     if (period > 0) {
+          int64_t subframe = Simulator::Now ().GetMilliSeconds () % period;
+          for (map<uint16_t, map<uint8_t, Group> >::const_iterator it = m_groups.begin(); it != m_groups.end(); ++it) {
+               if (it->first % period != subframe) {
+                    continue;
+               }
+               bool empty = getSlack(it->first) == Time::Max ();
+               if (grantUl(it->first, m_spsRbs, rbMap, allocation, ret) > 0) {
+                    served.insert(it->first);
+                    ++m_grants.spsGrants;
+                    if (empty) {
+                         ++m_grants.spsEmpty;
+                    }
+               }
+          }
+     }
+
+     // dynamic grants by the slack
+     vector<pair<Time, uint16_t> > ues;
+     for (map<uint16_t, map<uint8_t, Group> >::const_iterator it = m_groups.begin(); it != m_groups.end(); ++it) {
+          Time slack = getSlack(it->first);
+          if (slack != Time::Max () && ! served.count(it->first)) {
+               ues.push_back(make_pair(slack, it->first));
+          }
+     }
+     sort(ues.begin(), ues.end());
+     for (size_t u = 0; u < ues.size(); ++u) {
+          if (grantUl(ues[u].second, 0, rbMap, allocation, ret) > 0) {
+               ++m_grants.dynamicGrants;
+          }
+     }
+
+     m_allocationMaps[params.m_sfnSf] = allocation;
+     m_schedSapUser->SchedUlConfigInd (ret);
+}
+
+DeadlineFfMacScheduler::Grants const& DeadlineFfMacScheduler::getGrants() const {
+     return m_grants;
+}
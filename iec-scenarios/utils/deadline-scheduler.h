@@ -0,0 +1,115 @@
+#ifndef DEADLINE_SCHEDULER_H_
+#define DEADLINE_SCHEDULER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+#include <string>
+#include <vector>
+#include <map>
+
+class DeadlineSchedulerCschedSapProvider;
+class DeadlineSchedulerSchedSapProvider;
+class DeadlineSchedulerCschedSapUser;
+class DeadlineSchedulerSchedSapUser;
+
+/**
+* Uplink scheduler which serves the UEs by the slack of their buffered data,
+* earliest deadline first. A logical channel group becomes urgent when its
+* BSR reports data after an empty buffer; its deadline is the packet delay
+* budget of the QCI of its bearers (3GPP TS 23.203), or the value of the
+* Deadlines attribute ("qci=ms,..."). Every UE gets the contiguous RBs for
+* its buffer, so urgent UEs are not throttled by an equal share.
+*
+* The downlink, the random access and the cell and UE configuration are
+* delegated to a standard scheduler (DlScheduler). Like the schedulers
+* with HarqEnabled=false, uplink HARQ retransmissions are not scheduled.
+*/
+class DeadlineFfMacScheduler : public ns3::FfMacScheduler {
+public:
+     static ns3::TypeId GetTypeId (void);
+     DeadlineFfMacScheduler();
+     virtual ~DeadlineFfMacScheduler();
+
+     virtual void SetFfMacCschedSapUser (ns3::FfMacCschedSapUser* s);
+     virtual void SetFfMacSchedSapUser (ns3::FfMacSchedSapUser* s);
+     virtual ns3::FfMacCschedSapProvider* GetFfMacCschedSapProvider ();
+     virtual ns3::FfMacSchedSapProvider* GetFfMacSchedSapProvider ();
+     virtual void SetLteFfrSapProvider (ns3::LteFfrSapProvider* s);
+     virtual ns3::LteFfrSapUser* GetLteFfrSapUser ();
+
+     struct Grants {
+          Grants();
+          uint64_t spsGrants;
+          // semi-persistent grants without reported data
+          uint64_t spsEmpty;
+          uint64_t dynamicGrants;
+          uint64_t rbs;
+          uint64_t bytes;
+     };
+
+     static double getPacketDelayBudget(uint8_t qci);
+     Grants const& getGrants() const;
+
+     friend class DeadlineSchedulerCschedSapProvider;
+     friend class DeadlineSchedulerSchedSapProvider;
+     friend class DeadlineSchedulerCschedSapUser;
+     friend class DeadlineSchedulerSchedSapUser;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     struct Group {
+          Group();
+          uint32_t bytes;
+          bool configured;
+          ns3::Time arrival;
+          ns3::Time deadline;
+     };
+
+     ns3::Ptr<ns3::FfMacScheduler> getInner();
+     void parseDeadlines();
+     ns3::Time getDeadline(uint8_t qci) const;
+     ns3::Time getSlack(uint16_t rnti) const;
+     int getUlMcs(uint16_t rnti) const;
+     uint32_t grantUl(uint16_t rnti, uint32_t rbs, std::vector<bool>& rbMap, std::vector<uint16_t>& allocation,
+                      ns3::FfMacSchedSapUser::SchedUlConfigIndParameters& ret);
+
+     void cellConfig(ns3::FfMacCschedSapProvider::CschedCellConfigReqParameters const& params);
+     void lcConfig(ns3::FfMacCschedSapProvider::CschedLcConfigReqParameters const& params);
+     void ueRelease(ns3::FfMacCschedSapProvider::CschedUeReleaseReqParameters const& params);
+     void ulTrigger(ns3::FfMacSchedSapProvider::SchedUlTriggerReqParameters const& params);
+     void ulMacCtrlInfo(ns3::FfMacSchedSapProvider::SchedUlMacCtrlInfoReqParameters const& params);
+     void ulCqiInfo(ns3::FfMacSchedSapProvider::SchedUlCqiInfoReqParameters const& params);
+     void dlConfigInd(ns3::FfMacSchedSapUser::SchedDlConfigIndParameters const& params);
+
+     std::string m_innerType;
+     std::string m_deadlineText;
+     uint32_t m_minRbs;
+     ns3::Time m_spsPeriod;
+     uint32_t m_spsRbs;
+     Grants m_grants;
+     ns3::Ptr<ns3::FfMacScheduler> m_inner;
+     ns3::Ptr<ns3::LteAmc> m_amc;
+     std::map<uint8_t, ns3::Time> m_deadlines;
+
+     ns3::FfMacCschedSapUser* m_cschedSapUser;
+     ns3::FfMacSchedSapUser* m_schedSapUser;
+     ns3::LteFfrSapProvider* m_ffrSapProvider;
+     DeadlineSchedulerCschedSapProvider* m_cschedSapProvider;
+     DeadlineSchedulerSchedSapProvider* m_schedSapProvider;
+     DeadlineSchedulerCschedSapUser* m_innerCschedSapUser;
+     DeadlineSchedulerSchedSapUser* m_innerSchedSapUser;
+
+     uint8_t m_ulBandwidth;
+     // deadline and buffer of every logical channel group of a UE
+     std::map<uint16_t, std::map<uint8_t, Group> > m_groups;
+     // smallest PUSCH SINR in dB of the last allocation of a UE
+     std::map<uint16_t, double> m_ulSinr;
+     // RBs of the UEs per uplink subframe, to assign the PUSCH CQIs
+     std::map<uint16_t, std::vector<uint16_t> > m_allocationMaps;
+     // RBs granted for Msg3 in the random access responses
+     std::vector<bool> m_rachRbs;
+};
+
+#endif /* DEADLINE_SCHEDULER_H_ */
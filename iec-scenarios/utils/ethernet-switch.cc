@@ -0,0 +1,220 @@
+#include "ethernet-switch.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("EthernetSwitch");
+
+NS_OBJECT_ENSURE_REGISTERED (EthernetSwitch);
+
+const uint32_t EthernetSwitch::PRIORITIES = 8;
+// 0.0.0.0 is never the source of a station and marks the free slots
+const uint32_t EthernetSwitch::EMPTY = 0;
+
+TypeId EthernetSwitch::GetTypeId (void) {
+     static TypeId tid = TypeId ("EthernetSwitch")
+          .SetParent<Object> ()
+          .AddConstructor<EthernetSwitch> ()
+          .AddAttribute ("AgingTime", "Time a learned address stays valid, 0 keeps it forever",
+                         TimeValue (Seconds (300)),
+                         MakeTimeAccessor (&EthernetSwitch::m_agingTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("MaxPackets", "Frames of a priority queue of a port",
+                         UintegerValue (100),
+                         MakeUintegerAccessor (&EthernetSwitch::m_maxPackets),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+EthernetSwitch::EthernetSwitch() :
+     m_maxPackets(100),
+     m_table(64),
+     m_learned(0),
+     m_forwarded(0),
+     m_flooded(0),
+     m_filtered(0),
+     m_frames(PRIORITIES, 0),
+     m_drops(PRIORITIES, 0),
+     m_delays(PRIORITIES) {
+     for (size_t i = 0; i < m_table.size(); ++i) {
+          m_table[i].address = EMPTY;
+     }
+}
+
+void EthernetSwitch::DoDispose (void) {
+     m_ports.clear();
+     Object::DoDispose ();
+}
+
+// Function to add the hub end of a link as port, receiving all its frames
+void EthernetSwitch::addPort(Ptr<NetDevice> device) {
+     uint32_t ifIndex = device->GetIfIndex ();
+     if (ifIndex >= m_portOfDevice.size()) {
+          m_portOfDevice.resize(ifIndex + 1, -1);
+     }
+     m_portOfDevice[ifIndex] = m_ports.size();
+     Port port;
+     port.device = device;
+     port.queues.resize(PRIORITIES);
+     port.busy = false;
+     m_ports.push_back(port);
+     device->GetNode ()->RegisterProtocolHandler (MakeCallback (&EthernetSwitch::receive, this), 0, device, false);
+     device->TraceConnectWithoutContext ("PhyTxEnd",
+          MakeBoundCallback (&EthernetSwitch::transmitted, this, (uint32_t) (m_ports.size() - 1)));
+}
+
+uint32_t EthernetSwitch::getNPorts() const {
+     return m_ports.size();
+}
+
+// Function to get the slot of an address in the learning table, the free slot where it belongs if unknown
+uint32_t EthernetSwitch::getSlot(uint32_t address) const {
+     uint32_t mask = m_table.size() - 1;
+     // multiplicative hashing, the table size is a power of two
+     uint32_t slot = (address * 2654435761u) & mask;
+     while (m_table[slot].address != address && m_table[slot].address != EMPTY) {
+          slot = (slot + 1) & mask;
+     }
+     return slot;
+}
+
+// Function to learn the port of an address, the table doubles at half load
+void EthernetSwitch::learn(uint32_t address, uint32_t port) {
+     if (address == EMPTY) {
+          return;
+     }
+     uint32_t slot = getSlot(address);
+     if (m_table[slot].address == EMPTY) {
+          ++m_learned;
+          if (m_learned * 2 > m_table.size()) {
+               vector<Entry> old;
+               old.swap(m_table);
+               Entry empty;
+               empty.address = EMPTY;
+               m_table.assign(old.size() * 2, empty);
+               for (size_t i = 0; i < old.size(); ++i) {
+                    if (old[i].address != EMPTY) {
+                         m_table[getSlot(old[i].address)] = old[i];
+                    }
+               }
+               slot = getSlot(address);
+          }
+          m_table[slot].address = address;
+     }
+     m_table[slot].port = port;
+     m_table[slot].time = Simulator::Now ().GetNanoSeconds ();
+}
+
+// Function to get the port of an address, -1 if it is unknown or aged
+int32_t EthernetSwitch::lookup(uint32_t address) const {
+     Entry const& entry = m_table[getSlot(address)];
+     if (entry.address == EMPTY) {
+          return -1;
+     }
+     if (! m_agingTime.IsZero () && Simulator::Now ().GetNanoSeconds () - entry.time > m_agingTime.GetNanoSeconds ()) {
+          return -1;
+     }
+     return entry.port;
+}
+
+// Function to learn the source of a frame and to forward it to the port of its destination or to flood it
+void EthernetSwitch::receive(Ptr<NetDevice> device, Ptr<Packet const> packet, uint16_t protocol,
+                             Address const& from, Address const& to, NetDevice::PacketType type) {
+     uint32_t ingress = m_portOfDevice[device->GetIfIndex ()];
+     uint8_t priority = 0;
+     int32_t egress = -1;
+     if (protocol == Ipv4L3Protocol::PROT_NUMBER) {
+          Ipv4Header header;
+          packet->PeekHeader (header);
+          priority = header.GetDscp () >> 3;
+          learn(header.GetSource ().Get (), ingress);
+          egress = lookup(header.GetDestination ().Get ());
+     }
+     if (egress == (int32_t) ingress) {
+          ++m_filtered;
+     } else if (egress >= 0) {
+          ++m_forwarded;
+          enqueue(egress, packet, protocol, priority);
+     } else {
+          ++m_flooded;
+          for (uint32_t i = 0; i < m_ports.size(); ++i) {
+               if (i != ingress) {
+                    enqueue(i, packet, protocol, priority);
+               }
+          }
+     }
+}
+
+// Function to add a frame to the priority queue of a port, it is sent at once if the port is idle
+void EthernetSwitch::enqueue(uint32_t port, Ptr<Packet const> packet, uint16_t protocol, uint8_t priority) {
+     deque<Frame>& queue = m_ports[port].queues[priority];
+     if (queue.size() >= m_maxPackets) {
+          ++m_drops[priority];
+          return;
+     }
+     Frame frame;
+     frame.packet = packet->Copy ();
+     frame.protocol = protocol;
+     frame.time = Simulator::Now ().GetNanoSeconds ();
+     queue.push_back(frame);
+     ++m_frames[priority];
+     if (! m_ports[port].busy) {
+          transmit(port);
+     }
+}
+
+// Function to send the next frame of the highest non-empty priority, one frame at a time per port
+void EthernetSwitch::transmit(uint32_t port) {
+     Port& current = m_ports[port];
+     if (current.busy) {
+          return;
+     }
+     int32_t priority = PRIORITIES - 1;
+     while (priority >= 0) {
+          deque<Frame>& queue = current.queues[priority];
+          if (queue.empty()) {
+               --priority;
+               continue;
+          }
+          Frame frame = queue.front();
+          queue.pop_front();
+          m_delays[priority].add(NanoSeconds (Simulator::Now ().GetNanoSeconds () - frame.time));
+          current.busy = current.device->Send (frame.packet, current.device->GetBroadcast (), frame.protocol);
+          if (current.busy) {
+               return;
+          }
+          // the device refused the frame, it is lost like a queue overflow
+          ++m_drops[priority];
+     }
+}
+
+// Function to send the next frame after the port finished a transmission
+void EthernetSwitch::transmitted(EthernetSwitch* owner, uint32_t port, Ptr<Packet const> packet) {
+     owner->m_ports[port].busy = false;
+     // the device finishes the transmission after this trace, it can only send again afterwards
+     Simulator::ScheduleNow (&EthernetSwitch::transmit, owner, port);
+}
+
+// Function to print the forwarding counters and the queueing delay per priority
+void EthernetSwitch::report() const {
+     cout << "Ethernet switch: " << m_ports.size() << " ports, " << m_learned << " learned addresses, "
+          << m_forwarded << " forwarded, " << m_flooded << " flooded, " << m_filtered << " filtered" << endl;
+     cout << setw(10) << "priority" << setw(12) << "frames" << setw(10) << "drops"
+          << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << endl;
+     cout << fixed << setprecision(3);
+     for (int32_t priority = PRIORITIES - 1; priority >= 0; --priority) {
+          if (m_frames[priority] == 0 && m_drops[priority] == 0) {
+               continue;
+          }
+          LatencyHistogram const& delays = m_delays[priority];
+          cout << setw(10) << priority << setw(12) << m_frames[priority] << setw(10) << m_drops[priority]
+               << setw(10) << delays.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << delays.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
@@ -0,0 +1,85 @@
+#ifndef ETHERNET_SWITCH_H_
+#define ETHERNET_SWITCH_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <deque>
+#include <vector>
+
+/**
+* Store and forward switch of a station bus on the node of the star hub.
+* The ports are the hub ends of full duplex point-to-point links with their
+* own data rates; the hub needs no IP stack and does no routing.
+*
+* The learning table maps the source address of the received frames to the
+* port, an open addressing hash table with O(1) lookups, so thousands of
+* ports cost no more per frame than a few. The point-to-point frames carry
+* no MAC header, the table learns the IPv4 source addresses of the
+* stations instead. Frames to unknown addresses, broadcasts and multicasts
+* are flooded, entries older than AgingTime are unknown again.
+*
+* Every port has the eight 802.1Q priority queues with MaxPackets frames
+* each, served strictly by priority. The priority of a frame is the class
+* selector of its DSCP (the default DSCP to PCP mapping), e.g. marked by
+* the link queues of the stations.
+*/
+class EthernetSwitch : public ns3::Object {
+public:
+     static ns3::TypeId GetTypeId (void);
+     EthernetSwitch();
+     void addPort(ns3::Ptr<ns3::NetDevice> device);
+     uint32_t getNPorts() const;
+     void report() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     struct Frame {
+          ns3::Ptr<ns3::Packet> packet;
+          uint16_t protocol;
+          int64_t time;
+     };
+
+     struct Port {
+          ns3::Ptr<ns3::NetDevice> device;
+          std::vector<std::deque<Frame> > queues;
+          bool busy;
+     };
+
+     struct Entry {
+          uint32_t address;
+          uint32_t port;
+          int64_t time;
+     };
+
+     static const uint32_t PRIORITIES;
+     static const uint32_t EMPTY;
+
+     void receive(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<ns3::Packet const> packet, uint16_t protocol,
+                  ns3::Address const& from, ns3::Address const& to, ns3::NetDevice::PacketType type);
+     void enqueue(uint32_t port, ns3::Ptr<ns3::Packet const> packet, uint16_t protocol, uint8_t priority);
+     void transmit(uint32_t port);
+     static void transmitted(EthernetSwitch* owner, uint32_t port, ns3::Ptr<ns3::Packet const> packet);
+     uint32_t getSlot(uint32_t address) const;
+     void learn(uint32_t address, uint32_t port);
+     int32_t lookup(uint32_t address) const;
+
+     ns3::Time m_agingTime;
+     uint32_t m_maxPackets;
+     std::vector<Port> m_ports;
+     // port of every device of the node by its interface index
+     std::vector<int32_t> m_portOfDevice;
+     std::vector<Entry> m_table;
+     uint32_t m_learned;
+     uint64_t m_forwarded;
+     uint64_t m_flooded;
+     uint64_t m_filtered;
+     std::vector<uint64_t> m_frames;
+     std::vector<uint64_t> m_drops;
+     std::vector<LatencyHistogram> m_delays;
+};
+
+#endif /* ETHERNET_SWITCH_H_ */
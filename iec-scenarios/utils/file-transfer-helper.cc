@@ -0,0 +1,71 @@
+#include "file-transfer-helper.h"
+
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("FileTransferHelper");
+
+const uint16_t FileTransferHelper::PORT = 10105;
+
+FileTransferHelper::FileTransferHelper() :
+     m_size(1000000),
+     m_interval(Seconds (10.0)),
+     m_files(0) {
+}
+
+void FileTransferHelper::setSize(uint32_t size) {
+     m_size = size;
+}
+
+void FileTransferHelper::setInterval(Time interval) {
+     m_interval = interval;
+}
+
+// Function to install a sink on the first client and the uploads of the files on every server
+void FileTransferHelper::install(NodeContainer const& servers, NodeContainer const& clients, Time start, Time stop) {
+     if (clients.GetN () == 0) {
+          return;
+     }
+     m_start = start;
+     Ptr<Node> client = clients.Get (0);
+     PacketSinkHelper sinkHelper ("ns3::TcpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), PORT));
+     ApplicationContainer sinks = sinkHelper.Install (client);
+     sinks.Start (start);
+     sinks.Stop (stop);
+     m_sinks.push_back(DynamicCast<PacketSink> (sinks.Get (0)));
+
+     Ipv4Address address = client->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ();
+     BulkSendHelper sendHelper ("ns3::TcpSocketFactory", InetSocketAddress (address, PORT));
+     sendHelper.SetAttribute ("MaxBytes", UintegerValue (m_size));
+     for (uint32_t i = 0; i < servers.GetN (); ++i) {
+          if (servers.Get (i) == client) {
+               continue;
+          }
+          // one application per file, every file on its own connection
+          for (Time time = start + MilliSeconds (1); time < stop; time += m_interval) {
+               ApplicationContainer apps = sendHelper.Install (servers.Get (i));
+               apps.Start (time);
+               apps.Stop (stop);
+               ++m_files;
+               if (m_size == 0 || m_interval.IsZero ()) {
+                    break;
+               }
+          }
+     }
+}
+
+// Function to print the received bytes and the mean throughput of the file transfers
+void FileTransferHelper::report() {
+     uint64_t bytes = 0;
+     for (size_t i = 0; i < m_sinks.size(); ++i) {
+          bytes += m_sinks[i]->GetTotalRx ();
+     }
+     double seconds = (Simulator::Now () - m_start).GetSeconds ();
+     cout << "File transfers: " << m_files << " files of " << m_size << " bytes, " << bytes << " bytes received, "
+          << fixed << setprecision(3) << (seconds > 0 ? bytes * 8 / seconds / 1000 : 0.0) << " kbps" << endl;
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
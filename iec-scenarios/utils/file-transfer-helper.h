@@ -0,0 +1,36 @@
+#ifndef FILE_TRANSFER_HELPER_H_
+#define FILE_TRANSFER_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include <string>
+#include <vector>
+
+/**
+* Bulk file transfers (disturbance records, settings, firmware) from every
+* server node to the first client node over TCP. Every server uploads a
+* file of Size bytes on a new connection every Interval as fast as TCP
+* allows; Size 0 sends continuously, Interval 0 sends one file.
+*/
+class FileTransferHelper {
+public:
+     static const uint16_t PORT;
+
+     FileTransferHelper();
+     void setSize(uint32_t size);
+     void setInterval(ns3::Time interval);
+     void install(ns3::NodeContainer const& servers, ns3::NodeContainer const& clients,
+                  ns3::Time start, ns3::Time stop);
+     void report();
+
+private:
+     uint32_t m_size;
+     ns3::Time m_interval;
+     uint64_t m_files;
+     ns3::Time m_start;
+     std::vector<ns3::Ptr<ns3::PacketSink> > m_sinks;
+};
+
+#endif /* FILE_TRANSFER_HELPER_H_ */
@@ -0,0 +1,450 @@
+#include "goose-helper.h"
+
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("GooseHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (GooseHeader);
+NS_OBJECT_ENSURE_REGISTERED (GoosePublisher);
+NS_OBJECT_ENSURE_REGISTERED (GooseSubscriber);
+
+// EtherType of GOOSE frames
+static const uint16_t GOOSE_ETHERTYPE = 0x88B8;
+
+TypeId GooseHeader::GetTypeId (void) {
+     static TypeId tid = TypeId ("GooseHeader")
+          .SetParent<Header> ()
+          .AddConstructor<GooseHeader> ();
+     return tid;
+}
+
+GooseHeader::GooseHeader() :
+     appId(0),
+     publisher(0),
+     stNum(0),
+     sqNum(0),
+     timeAllowedToLive(0),
+     t(0),
+     sendTime(0) {
+}
+
+TypeId GooseHeader::GetInstanceTypeId (void) const {
+     return GetTypeId ();
+}
+
+uint32_t GooseHeader::GetSerializedSize (void) const {
+     return 2 + 4 + 4 + 4 + 4 + 8 + 8;
+}
+
+void GooseHeader::Serialize (Buffer::Iterator start) const {
+     start.WriteHtonU16 (appId);
+     start.WriteHtonU32 (publisher);
+     start.WriteHtonU32 (stNum);
+     start.WriteHtonU32 (sqNum);
+     start.WriteHtonU32 (timeAllowedToLive);
+     start.WriteHtonU64 ((uint64_t) t);
+     start.WriteHtonU64 ((uint64_t) sendTime);
+}
+
+uint32_t GooseHeader::Deserialize (Buffer::Iterator start) {
+     appId = start.ReadNtohU16 ();
+     publisher = start.ReadNtohU32 ();
+     stNum = start.ReadNtohU32 ();
+     sqNum = start.ReadNtohU32 ();
+     timeAllowedToLive = start.ReadNtohU32 ();
+     t = (int64_t) start.ReadNtohU64 ();
+     sendTime = (int64_t) start.ReadNtohU64 ();
+     return GetSerializedSize ();
+}
+
+void GooseHeader::Print (ostream &os) const {
+     os << "appId=" << appId << " stNum=" << stNum << " sqNum=" << sqNum
+        << " TAL=" << timeAllowedToLive << "ms";
+}
+
+TypeId GoosePublisher::GetTypeId (void) {
+     static TypeId tid = TypeId ("GoosePublisher")
+          .SetParent<Application> ()
+          .AddConstructor<GoosePublisher> ()
+          .AddAttribute ("AppId", "APPID of the GOOSE control block",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&GoosePublisher::m_appId),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("Transport", "udp (routable GOOSE) or ethernet (EtherType 0x88B8)",
+                         StringValue ("udp"),
+                         MakeStringAccessor (&GoosePublisher::m_transport),
+                         MakeStringChecker ())
+          .AddAttribute ("Port", "UDP port of routable GOOSE",
+                         UintegerValue (102),
+                         MakeUintegerAccessor (&GoosePublisher::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("Size", "Size of the GOOSE PDU in bytes",
+                         UintegerValue (160),
+                         MakeUintegerAccessor (&GoosePublisher::m_size),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("MinTime", "First repetition interval after a state change",
+                         TimeValue (MilliSeconds (2)),
+                         MakeTimeAccessor (&GoosePublisher::m_minTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("MaxTime", "Heartbeat interval",
+                         TimeValue (Seconds (1.0)),
+                         MakeTimeAccessor (&GoosePublisher::m_maxTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("EventRate", "Mean state changes per second, 0 sends only heartbeats",
+                         DoubleValue (1.0),
+                         MakeDoubleAccessor (&GoosePublisher::m_eventRate),
+                         MakeDoubleChecker<double> (0.0));
+     return tid;
+}
+
+GoosePublisher::GoosePublisher() :
+     m_appId(1),
+     m_transport("udp"),
+     m_port(102),
+     m_size(160),
+     m_eventRate(1.0),
+     m_stNum(0),
+     m_sqNum(0),
+     m_events(0),
+     m_frames(0) {
+     m_eventDelay = CreateObject<ExponentialRandomVariable> ();
+}
+
+// Function to add a subscriber, used by the udp transport
+void GoosePublisher::addSubscriber(Ipv4Address address) {
+     m_subscribers.push_back(address);
+}
+
+uint64_t GoosePublisher::getEvents() const {
+     return m_events;
+}
+
+uint64_t GoosePublisher::getFrames() const {
+     return m_frames;
+}
+
+void GoosePublisher::DoDispose (void) {
+     m_sockets.clear();
+     Application::DoDispose ();
+}
+
+void GoosePublisher::StartApplication (void) {
+     Ptr<Node> node = GetNode ();
+     if (m_transport == "ethernet") {
+          // one packet socket per LAN device, sending to the multicast MAC of the AppId
+          char mac[18];
+          snprintf(mac, sizeof(mac), "01:0c:cd:01:%02x:%02x", m_appId >> 8, m_appId & 0xff);
+          for (uint32_t i = 0; i < node->GetNDevices (); ++i) {
+               Ptr<NetDevice> device = node->GetDevice (i);
+               if (device->IsPointToPoint () || ! device->IsBroadcast ()
+                   || device->GetInstanceTypeId ().GetName () == "ns3::LoopbackNetDevice") {
+                    continue;
+               }
+               Ptr<Socket> socket = Socket::CreateSocket (node, PacketSocketFactory::GetTypeId ());
+               PacketSocketAddress local;
+               local.SetSingleDevice (device->GetIfIndex ());
+               local.SetProtocol (GOOSE_ETHERTYPE);
+               socket->Bind (local);
+               PacketSocketAddress remote;
+               remote.SetSingleDevice (device->GetIfIndex ());
+               remote.SetPhysicalAddress (Mac48Address (mac));
+               remote.SetProtocol (GOOSE_ETHERTYPE);
+               socket->Connect (remote);
+               m_sockets.push_back(socket);
+               m_destinations.push_back(remote);
+          }
+          if (m_sockets.empty()) {
+               NS_LOG_WARN ("No LAN device for GOOSE on node " << node->GetId ());
+          }
+     } else {
+          Ptr<Socket> socket = Socket::CreateSocket (node, UdpSocketFactory::GetTypeId ());
+          socket->Bind ();
+          for (size_t i = 0; i < m_subscribers.size(); ++i) {
+               m_sockets.push_back(socket);
+               m_destinations.push_back(InetSocketAddress (m_subscribers[i], m_port));
+          }
+     }
+
+     // initial state, then the state changes
+     m_stNum = 1;
+     m_sqNum = 0;
+     m_lastChange = Simulator::Now ();
+     m_interval = m_minTime;
+     send();
+     m_repeatEvent = Simulator::Schedule (m_interval, &GoosePublisher::repeat, this);
+     if (m_eventRate > 0.0) {
+          m_eventDelay->SetAttribute ("Mean", DoubleValue (1.0 / m_eventRate));
+          m_changeEvent = Simulator::Schedule (Seconds (m_eventDelay->GetValue ()), &GoosePublisher::changeState, this);
+     }
+}
+
+void GoosePublisher::StopApplication (void) {
+     m_repeatEvent.Cancel ();
+     m_changeEvent.Cancel ();
+     // the udp transport uses one socket for all destinations
+     for (size_t i = 0; i < m_sockets.size(); ++i) {
+          if (i == 0 || m_sockets[i] != m_sockets[i - 1]) {
+               m_sockets[i]->Close ();
+          }
+     }
+     m_sockets.clear();
+     m_destinations.clear();
+}
+
+// Function to send a new state at once and to restart the repetitions at MinTime
+void GoosePublisher::changeState() {
+     m_repeatEvent.Cancel ();
+     ++m_stNum;
+     m_sqNum = 0;
+     ++m_events;
+     m_lastChange = Simulator::Now ();
+     m_interval = m_minTime;
+     send();
+     m_repeatEvent = Simulator::Schedule (m_interval, &GoosePublisher::repeat, this);
+     m_changeEvent = Simulator::Schedule (Seconds (m_eventDelay->GetValue ()), &GoosePublisher::changeState, this);
+}
+
+// Function to repeat the current state, the interval doubles up to MaxTime
+void GoosePublisher::repeat() {
+     ++m_sqNum;
+     m_interval = Min (m_interval + m_interval, m_maxTime);
+     send();
+     m_repeatEvent = Simulator::Schedule (m_interval, &GoosePublisher::repeat, this);
+}
+
+void GoosePublisher::send() {
+     GooseHeader header;
+     header.appId = m_appId;
+     header.publisher = GetNode ()->GetId ();
+     header.stNum = m_stNum;
+     header.sqNum = m_sqNum;
+     header.timeAllowedToLive = (uint32_t) (2 * m_interval.GetMilliSeconds ());
+     header.t = m_lastChange.GetNanoSeconds ();
+     header.sendTime = Simulator::Now ().GetNanoSeconds ();
+     uint32_t padding = m_size > header.GetSerializedSize () ? m_size - header.GetSerializedSize () : 0;
+     Ptr<Packet> packet = Create<Packet> (padding);
+     packet->AddHeader (header);
+     for (size_t i = 0; i < m_sockets.size(); ++i) {
+          m_sockets[i]->SendTo (packet->Copy (), 0, m_destinations[i]);
+          ++m_frames;
+     }
+}
+
+TypeId GooseSubscriber::GetTypeId (void) {
+     static TypeId tid = TypeId ("GooseSubscriber")
+          .SetParent<Application> ()
+          .AddConstructor<GooseSubscriber> ()
+          .AddAttribute ("Transport", "udp (routable GOOSE) or ethernet (EtherType 0x88B8)",
+                         StringValue ("udp"),
+                         MakeStringAccessor (&GooseSubscriber::m_transport),
+                         MakeStringChecker ())
+          .AddAttribute ("Port", "UDP port of routable GOOSE",
+                         UintegerValue (102),
+                         MakeUintegerAccessor (&GooseSubscriber::m_port),
+                         MakeUintegerChecker<uint16_t> ());
+     return tid;
+}
+
+GooseSubscriber::GooseSubscriber() :
+     m_transport("udp"),
+     m_port(102),
+     m_frames(0),
+     m_events(0),
+     m_lostEvents(0) {
+     for (uint32_t i = 0; i < CLASSES; ++i) {
+          m_within[i] = 0;
+     }
+}
+
+Time GooseSubscriber::getClassLimit(uint32_t index) {
+     const int64_t limits[CLASSES] = { 3, 10, 20 };
+     return MilliSeconds (limits[index]);
+}
+
+LatencyHistogram const& GooseSubscriber::getFrameTimes() const {
+     return m_frameTimes;
+}
+
+LatencyHistogram const& GooseSubscriber::getEventTimes() const {
+     return m_eventTimes;
+}
+
+uint64_t GooseSubscriber::getFrames() const {
+     return m_frames;
+}
+
+uint64_t GooseSubscriber::getEvents() const {
+     return m_events;
+}
+
+uint64_t GooseSubscriber::getLostEvents() const {
+     return m_lostEvents;
+}
+
+uint64_t GooseSubscriber::getEventsWithin(uint32_t index) const {
+     return m_within[index];
+}
+
+void GooseSubscriber::DoDispose (void) {
+     m_socket = 0;
+     Application::DoDispose ();
+}
+
+void GooseSubscriber::StartApplication (void) {
+     if (m_transport == "ethernet") {
+          m_socket = Socket::CreateSocket (GetNode (), PacketSocketFactory::GetTypeId ());
+          PacketSocketAddress local;
+          local.SetAllDevices ();
+          local.SetProtocol (GOOSE_ETHERTYPE);
+          NS_ABORT_MSG_IF (m_socket->Bind (local) != 0,
+                           "Cannot bind the GOOSE subscriber of node " << GetNode ()->GetId ());
+     } else {
+          m_socket = Socket::CreateSocket (GetNode (), UdpSocketFactory::GetTypeId ());
+          NS_ABORT_MSG_IF (m_socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_port)) != 0,
+                           "Cannot bind the GOOSE subscriber of node " << GetNode ()->GetId () << " to UDP port " << m_port);
+     }
+     m_socket->SetRecvCallback (MakeCallback (&GooseSubscriber::receive, this));
+}
+
+void GooseSubscriber::StopApplication (void) {
+     if (m_socket != 0) {
+          m_socket->Close ();
+          m_socket = 0;
+     }
+}
+
+// Function to measure the transfer times, a state change is the first frame with a new stNum
+void GooseSubscriber::receive(Ptr<Socket> socket) {
+     Ptr<Packet> packet;
+     while ((packet = socket->Recv ())) {
+          GooseHeader header;
+          packet->RemoveHeader (header);
+          Time now = Simulator::Now ();
+          ++m_frames;
+          m_frameTimes.add (now - NanoSeconds (header.sendTime));
+
+          map<uint32_t, uint32_t>::iterator last = m_lastStNum.find(header.publisher);
+          if (last == m_lastStNum.end()) {
+               m_lastStNum[header.publisher] = header.stNum;
+               continue;
+          }
+          if (header.stNum <= last->second) {
+               continue;
+          }
+          m_lostEvents += header.stNum - last->second - 1;
+          last->second = header.stNum;
+          ++m_events;
+          Time transfer = now - NanoSeconds (header.t);
+          m_eventTimes.add (transfer);
+          for (uint32_t i = 0; i < CLASSES; ++i) {
+               if (transfer <= getClassLimit(i)) {
+                    ++m_within[i];
+               }
+          }
+     }
+}
+
+GooseHelper::GooseHelper() :
+     m_transport("udp") {
+     m_publisherFactory.SetTypeId (GoosePublisher::GetTypeId ());
+}
+
+// Function to set an attribute of the publishers (Size, MinTime, MaxTime, EventRate, Port)
+void GooseHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_publisherFactory.Set (name, value);
+}
+
+void GooseHelper::setTransport(string const& transport) {
+     NS_ABORT_MSG_UNLESS (transport == "udp" || transport == "ethernet", "Unknown GOOSE transport " + transport);
+     m_transport = transport;
+}
+
+// Function to install the subscribers and the publishers, the AppId is the index of the publisher
+void GooseHelper::install(NodeContainer const& publishers, NodeContainer const& subscribers, Time start, Time stop) {
+     if (m_transport == "ethernet") {
+          PacketSocketHelper packetSocket;
+          packetSocket.Install (NodeContainer (publishers, subscribers));
+     }
+     for (uint32_t i = 0; i < subscribers.GetN (); ++i) {
+          Ptr<GooseSubscriber> subscriber = CreateObject<GooseSubscriber> ();
+          subscriber->SetAttribute ("Transport", StringValue (m_transport));
+          subscribers.Get (i)->AddApplication (subscriber);
+          subscriber->SetStartTime (start);
+          subscriber->SetStopTime (stop);
+          m_subscribers.push_back(subscriber);
+     }
+     for (uint32_t i = 0; i < publishers.GetN (); ++i) {
+          Ptr<GoosePublisher> publisher = m_publisherFactory.Create<GoosePublisher> ();
+          publisher->SetAttribute ("Transport", StringValue (m_transport));
+          publisher->SetAttribute ("AppId", UintegerValue (i + 1));
+          for (uint32_t j = 0; j < subscribers.GetN (); ++j) {
+               if (subscribers.Get (j) != publishers.Get (i)) {
+                    publisher->addSubscriber(subscribers.Get (j)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+               }
+          }
+          publishers.Get (i)->AddApplication (publisher);
+          publisher->SetStartTime (start);
+          publisher->SetStopTime (stop);
+          m_publishers.push_back(publisher);
+     }
+}
+
+// Function to print the transfer times of the state changes per subscriber
+void GooseHelper::report() {
+     uint64_t events = 0;
+     uint64_t frames = 0;
+     for (size_t i = 0; i < m_publishers.size(); ++i) {
+          events += m_publishers[i]->getEvents();
+          frames += m_publishers[i]->getFrames();
+     }
+     cout << "GOOSE (" << m_transport << "): " << m_publishers.size() << " publishers, "
+          << events << " state changes, " << frames << " frames sent" << endl;
+     cout << setw(8) << left << "node" << right << setw(10) << "frames" << setw(8) << "events"
+          << setw(6) << "lost" << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]";
+     for (uint32_t j = 0; j < GooseSubscriber::CLASSES; ++j) {
+          cout << setw(6) << "<=" << setw(3) << GooseSubscriber::getClassLimit(j).GetMilliSeconds () << "ms";
+     }
+     cout << endl;
+     cout << fixed;
+     for (size_t i = 0; i < m_subscribers.size(); ++i) {
+          Ptr<GooseSubscriber> subscriber = m_subscribers[i];
+          LatencyHistogram const& times = subscriber->getEventTimes();
+          cout << setw(8) << left << subscriber->GetNode ()->GetId () << right
+               << setw(10) << subscriber->getFrames() << setw(8) << subscriber->getEvents()
+               << setw(6) << subscriber->getLostEvents() << setprecision(3)
+               << setw(10) << times.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << times.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << times.getMax().GetSeconds () * 1000 << setprecision(1);
+          for (uint32_t j = 0; j < GooseSubscriber::CLASSES; ++j) {
+               double share = subscriber->getEvents() > 0 ? 100.0 * subscriber->getEventsWithin(j) / subscriber->getEvents() : 0;
+               cout << setw(10) << share << "%";
+          }
+          cout << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the histograms of all subscribers as CSV
+bool GooseHelper::writeCsv(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write GOOSE file " << fileName);
+          return false;
+     }
+     out << "node,kind,upper_us,count" << endl;
+     for (size_t i = 0; i < m_subscribers.size(); ++i) {
+          ostringstream node;
+          node << m_subscribers[i]->GetNode ()->GetId ();
+          m_subscribers[i]->getEventTimes().writeCsv(out, node.str() + ",event");
+          m_subscribers[i]->getFrameTimes().writeCsv(out, node.str() + ",frame");
+     }
+     return true;
+}
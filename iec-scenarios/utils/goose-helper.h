@@ -0,0 +1,150 @@
+#ifndef GOOSE_HELPER_H_
+#define GOOSE_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Fields of a GOOSE message which are used by the model. t is the time of
+* the last state change (stNum), the send time of the frame is carried in
+* addition to measure the transfer time of every frame.
+*/
+class GooseHeader : public ns3::Header {
+public:
+     static ns3::TypeId GetTypeId (void);
+     GooseHeader();
+     virtual ns3::TypeId GetInstanceTypeId (void) const;
+     virtual uint32_t GetSerializedSize (void) const;
+     virtual void Serialize (ns3::Buffer::Iterator start) const;
+     virtual uint32_t Deserialize (ns3::Buffer::Iterator start);
+     virtual void Print (std::ostream &os) const;
+
+     uint16_t appId;
+     uint32_t publisher;
+     uint32_t stNum;
+     uint32_t sqNum;
+     uint32_t timeAllowedToLive;
+     int64_t t;
+     int64_t sendTime;
+};
+
+/**
+* GOOSE publisher. State changes arrive as Poisson process, every change
+* increments stNum and is sent at once, then it is repeated with sqNum
+* incremented and the interval doubled from MinTime up to MaxTime, which
+* is the heartbeat afterwards.
+*
+* Transport "udp" sends routable GOOSE (IEC 61850-90-5) to every
+* subscriber, which works over P2P and LTE. Transport "ethernet" sends
+* frames with EtherType 0x88B8 to the multicast MAC of the AppId on all
+* broadcast capable devices (CSMA LANs).
+*/
+class GoosePublisher : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     GoosePublisher();
+     void addSubscriber(ns3::Ipv4Address address);
+     uint64_t getEvents() const;
+     uint64_t getFrames() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void changeState();
+     void repeat();
+     void send();
+
+     uint16_t m_appId;
+     std::string m_transport;
+     uint16_t m_port;
+     uint32_t m_size;
+     ns3::Time m_minTime;
+     ns3::Time m_maxTime;
+     double m_eventRate;
+     ns3::Ptr<ns3::ExponentialRandomVariable> m_eventDelay;
+
+     std::vector<ns3::Ptr<ns3::Socket> > m_sockets;
+     std::vector<ns3::Address> m_destinations;
+     std::vector<ns3::Ipv4Address> m_subscribers;
+     uint32_t m_stNum;
+     uint32_t m_sqNum;
+     ns3::Time m_lastChange;
+     ns3::Time m_interval;
+     ns3::EventId m_repeatEvent;
+     ns3::EventId m_changeEvent;
+     uint64_t m_events;
+     uint64_t m_frames;
+};
+
+/**
+* GOOSE subscriber, measures the transfer time of every frame and of every
+* state change (from t to the first received frame of the new stNum, so a
+* lost first frame shows up as the delay of its repetition).
+*/
+class GooseSubscriber : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     GooseSubscriber();
+
+     LatencyHistogram const& getFrameTimes() const;
+     LatencyHistogram const& getEventTimes() const;
+     uint64_t getFrames() const;
+     uint64_t getEvents() const;
+     uint64_t getLostEvents() const;
+     uint64_t getEventsWithin(uint32_t index) const;
+
+     // transfer time classes of IEC 61850-5 (TT6 3 ms, TT5 10 ms, TT4 20 ms)
+     static const uint32_t CLASSES = 3;
+     static ns3::Time getClassLimit(uint32_t index);
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void receive(ns3::Ptr<ns3::Socket> socket);
+
+     std::string m_transport;
+     uint16_t m_port;
+     ns3::Ptr<ns3::Socket> m_socket;
+     std::map<uint32_t, uint32_t> m_lastStNum;
+     LatencyHistogram m_frameTimes;
+     LatencyHistogram m_eventTimes;
+     uint64_t m_frames;
+     uint64_t m_events;
+     uint64_t m_lostEvents;
+     uint64_t m_within[CLASSES];
+};
+
+/**
+* Installs a publisher on every publishing node and a subscriber on every
+* subscribing node. Every publisher sends to all subscribers except its
+* own node. Prints the transfer times per subscriber.
+*/
+class GooseHelper {
+public:
+     GooseHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     void setTransport(std::string const& transport);
+     void install(ns3::NodeContainer const& publishers, ns3::NodeContainer const& subscribers,
+                  ns3::Time start, ns3::Time stop);
+     void report();
+     bool writeCsv(std::string const& fileName);
+
+private:
+     ns3::ObjectFactory m_publisherFactory;
+     std::string m_transport;
+     std::vector<ns3::Ptr<GoosePublisher> > m_publishers;
+     std::vector<ns3::Ptr<GooseSubscriber> > m_subscribers;
+};
+
+#endif /* GOOSE_HELPER_H_ */
@@ -0,0 +1,185 @@
+#include "interference-cutoff.h"
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("InterferenceCutoff");
+
+NS_OBJECT_ENSURE_REGISTERED (CutoffPropagationLossModel);
+
+const double CutoffPropagationLossModel::CUTOFF_LOSS = 1000.0;
+
+TypeId CutoffPropagationLossModel::GetTypeId (void) {
+     static TypeId tid = TypeId ("CutoffPropagationLossModel")
+          .SetParent<PropagationLossModel> ()
+          .AddConstructor<CutoffPropagationLossModel> ()
+          .AddAttribute ("Cutoff", "Distance in m beyond which no signal is received, 0 disables",
+                         DoubleValue (0.0),
+                         MakeDoubleAccessor (&CutoffPropagationLossModel::m_cutoff),
+                         MakeDoubleChecker<double> (0.0))
+          .AddAttribute ("Model", "TypeId of the wrapped pathloss model",
+                         StringValue ("ns3::FriisPropagationLossModel"),
+                         MakeStringAccessor (&CutoffPropagationLossModel::m_modelType),
+                         MakeStringChecker ())
+          .AddAttribute ("Frequency", "Carrier frequency in Hz, passed to the wrapped model",
+                         DoubleValue (0.0),
+                         MakeDoubleAccessor (&CutoffPropagationLossModel::setFrequency,
+                                             &CutoffPropagationLossModel::getFrequency),
+                         MakeDoubleChecker<double> (0.0));
+     return tid;
+}
+
+CutoffPropagationLossModel::CutoffPropagationLossModel() :
+     m_cutoff(0.0),
+     m_frequency(0.0) {
+}
+
+// Function to set the frequency, which the LTE helper sets after the creation of the model
+void CutoffPropagationLossModel::setFrequency(double frequency) {
+     m_frequency = frequency;
+     if (m_model && frequency > 0.0) {
+          m_model->SetAttributeFailSafe ("Frequency", DoubleValue (frequency));
+     }
+}
+
+double CutoffPropagationLossModel::getFrequency() const {
+     return m_frequency;
+}
+
+// Function to create the wrapped model on first use, when all attributes are set
+Ptr<PropagationLossModel> CutoffPropagationLossModel::getModel() const {
+     if (! m_model) {
+          ObjectFactory factory;
+          factory.SetTypeId (m_modelType);
+          m_model = factory.Create<PropagationLossModel> ();
+          if (m_frequency > 0.0) {
+               m_model->SetAttributeFailSafe ("Frequency", DoubleValue (m_frequency));
+          }
+     }
+     return m_model;
+}
+
+double CutoffPropagationLossModel::DoCalcRxPower (double txPowerDbm, Ptr<MobilityModel> a,
+                                                  Ptr<MobilityModel> b) const {
+     if (m_cutoff > 0.0 && a->GetDistanceFrom (b) > m_cutoff) {
+          return txPowerDbm - CUTOFF_LOSS;
+     }
+     return getModel()->CalcRxPower (txPowerDbm, a, b);
+}
+
+int64_t CutoffPropagationLossModel::DoAssignStreams (int64_t stream) {
+     return getModel()->AssignStreams (stream);
+}
+
+InterferenceCutoffHelper::InterferenceCutoffHelper() :
+     m_cutoff(0.0),
+     m_model("ns3::FriisPropagationLossModel") {
+}
+
+// Function to wrap the pathloss model of the LTE helper, before the devices are installed
+void InterferenceCutoffHelper::configure(Ptr<LteHelper> lteHelper, double cutoff, string const& model) {
+     m_cutoff = cutoff;
+     m_model = model;
+     lteHelper->SetAttribute ("PathlossModel", StringValue ("CutoffPropagationLossModel"));
+     lteHelper->SetPathlossModelAttribute ("Cutoff", DoubleValue (cutoff));
+     lteHelper->SetPathlossModelAttribute ("Model", StringValue (model));
+     // the channels drop the signals with the cutoff loss instead of delivering them
+     lteHelper->SetSpectrumChannelAttribute ("MaxLossDb", DoubleValue (CutoffPropagationLossModel::CUTOFF_LOSS - 1.0));
+}
+
+bool InterferenceCutoffHelper::isEnabled() const {
+     return m_cutoff > 0.0;
+}
+
+// Function to print the kept transmitter/receiver pairs and the SINR error bound per direction,
+// the bandwidth in resource blocks gives the noise power
+void InterferenceCutoffHelper::report(NetDeviceContainer const& enbDevs, NetDeviceContainer const& ueDevs,
+                                      uint32_t bandwidth) const {
+     if (enbDevs.GetN () == 0) {
+          return;
+     }
+     Ptr<LteEnbNetDevice> firstEnb = enbDevs.Get (0)->GetObject<LteEnbNetDevice> ();
+     UintegerValue dlEarfcn;
+     UintegerValue ulEarfcn;
+     firstEnb->GetAttribute ("DlEarfcn", dlEarfcn);
+     firstEnb->GetAttribute ("UlEarfcn", ulEarfcn);
+     DoubleValue enbNoiseFigure;
+     firstEnb->GetPhy ()->GetAttribute ("NoiseFigure", enbNoiseFigure);
+     double enbPower = firstEnb->GetPhy ()->GetTxPower ();
+     double thermalNoise = -174.0 + 10 * log10 (bandwidth * 180000.0);
+
+     ObjectFactory factory;
+     factory.SetTypeId (m_model);
+     Ptr<PropagationLossModel> models[2];
+     double frequencies[2] = { LteSpectrumValueHelper::GetCarrierFrequency (dlEarfcn.Get ()),
+                               LteSpectrumValueHelper::GetCarrierFrequency (ulEarfcn.Get ()) };
+     for (uint32_t i = 0; i < 2; ++i) {
+          models[i] = factory.Create<PropagationLossModel> ();
+          models[i]->SetAttributeFailSafe ("Frequency", DoubleValue (frequencies[i]));
+     }
+
+     // downlink: every UE receives all eNBs
+     uint64_t dlPairs = 0;
+     double dlMax = 0.0;
+     double dlSum = 0.0;
+     for (uint32_t u = 0; u < ueDevs.GetN (); ++u) {
+          Ptr<LteUeNetDevice> ue = ueDevs.Get (u)->GetObject<LteUeNetDevice> ();
+          Ptr<MobilityModel> ueMobility = ue->GetNode ()->GetObject<MobilityModel> ();
+          DoubleValue noiseFigure;
+          ue->GetPhy ()->GetAttribute ("NoiseFigure", noiseFigure);
+          double neglected = 0.0;
+          for (uint32_t e = 0; e < enbDevs.GetN (); ++e) {
+               Ptr<MobilityModel> enbMobility = enbDevs.Get (e)->GetNode ()->GetObject<MobilityModel> ();
+               if (enbMobility->GetDistanceFrom (ueMobility) <= m_cutoff) {
+                    ++dlPairs;
+               } else {
+                    neglected += pow (10.0, models[0]->CalcRxPower (enbPower, enbMobility, ueMobility) / 10);
+               }
+          }
+          double noise = pow (10.0, (thermalNoise + noiseFigure.Get ()) / 10);
+          double error = 10 * log10 (1 + neglected / noise);
+          dlMax = max(dlMax, error);
+          dlSum += error;
+     }
+
+     // uplink: every eNB receives one full band UE at the site of every other eNB
+     double uePower = ueDevs.GetN () > 0 ? ueDevs.Get (0)->GetObject<LteUeNetDevice> ()->GetPhy ()->GetTxPower () : 0.0;
+     uint64_t ulPairs = 0;
+     double ulMax = 0.0;
+     double ulSum = 0.0;
+     double enbNoise = pow (10.0, (thermalNoise + enbNoiseFigure.Get ()) / 10);
+     for (uint32_t r = 0; r < enbDevs.GetN (); ++r) {
+          Ptr<MobilityModel> rxMobility = enbDevs.Get (r)->GetNode ()->GetObject<MobilityModel> ();
+          double neglected = 0.0;
+          for (uint32_t t = 0; t < enbDevs.GetN (); ++t) {
+               Ptr<MobilityModel> txMobility = enbDevs.Get (t)->GetNode ()->GetObject<MobilityModel> ();
+               if (rxMobility->GetDistanceFrom (txMobility) <= m_cutoff) {
+                    ++ulPairs;
+               } else {
+                    neglected += pow (10.0, models[1]->CalcRxPower (uePower, txMobility, rxMobility) / 10);
+               }
+          }
+          double error = 10 * log10 (1 + neglected / enbNoise);
+          ulMax = max(ulMax, error);
+          ulSum += error;
+     }
+
+     uint64_t dlAll = (uint64_t) ueDevs.GetN () * enbDevs.GetN ();
+     uint64_t ulAll = (uint64_t) enbDevs.GetN () * enbDevs.GetN ();
+     cout << "Interference cutoff: " << m_cutoff << " m" << endl;
+     cout << setw(10) << left << "direction" << right << setw(14) << "pairs kept" << setw(10) << "share"
+          << setw(16) << "max error [dB]" << setw(16) << "mean error [dB]" << endl;
+     cout << fixed << setprecision(3);
+     cout << setw(10) << left << "downlink" << right << setw(14) << dlPairs
+          << setw(10) << (dlAll > 0 ? (double) dlPairs / dlAll : 0.0) << setw(16) << dlMax
+          << setw(16) << (ueDevs.GetN () > 0 ? dlSum / ueDevs.GetN () : 0.0) << endl;
+     cout << setw(10) << left << "uplink" << right << setw(14) << ulPairs
+          << setw(10) << (double) ulPairs / ulAll << setw(16) << ulMax
+          << setw(16) << ulSum / enbDevs.GetN () << endl;
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
@@ -0,0 +1,58 @@
+#ifndef INTERFERENCE_CUTOFF_H_
+#define INTERFERENCE_CUTOFF_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/propagation-module.h"
+#include "ns3/lte-module.h"
+#include <string>
+
+/**
+* Pathloss model which returns the loss of the wrapped model (Model) up to
+* the Cutoff distance and CUTOFF_LOSS dB beyond. Together with a smaller
+* MaxLossDb of the spectrum channels the signals of distant transmitters
+* are never delivered, so a transmission only creates receive and
+* interference events at the nearby PHYs.
+*/
+class CutoffPropagationLossModel : public ns3::PropagationLossModel {
+public:
+     static ns3::TypeId GetTypeId (void);
+     CutoffPropagationLossModel();
+
+     static const double CUTOFF_LOSS;
+
+private:
+     virtual double DoCalcRxPower (double txPowerDbm, ns3::Ptr<ns3::MobilityModel> a,
+                                   ns3::Ptr<ns3::MobilityModel> b) const;
+     virtual int64_t DoAssignStreams (int64_t stream);
+     void setFrequency(double frequency);
+     double getFrequency() const;
+     ns3::Ptr<ns3::PropagationLossModel> getModel() const;
+
+     double m_cutoff;
+     std::string m_modelType;
+     double m_frequency;
+     mutable ns3::Ptr<ns3::PropagationLossModel> m_model;
+};
+
+/**
+* Configures the interference cutoff of an LTE helper and reports an upper
+* bound of the SINR error it causes: the interference of all transmitters
+* beyond the cutoff at full power (every eNB in the downlink, one full band
+* UE at every other eNB site in the uplink) relative to the thermal noise.
+*/
+class InterferenceCutoffHelper {
+public:
+     InterferenceCutoffHelper();
+     void configure(ns3::Ptr<ns3::LteHelper> lteHelper, double cutoff, std::string const& model);
+     bool isEnabled() const;
+     void report(ns3::NetDeviceContainer const& enbDevs, ns3::NetDeviceContainer const& ueDevs,
+                 uint32_t bandwidth) const;
+
+private:
+     double m_cutoff;
+     std::string m_model;
+};
+
+#endif /* INTERFERENCE_CUTOFF_H_ */
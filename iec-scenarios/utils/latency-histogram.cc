@@ -0,0 +1,107 @@
+#include "latency-histogram.h"
+
+#include <cmath>
+
+using namespace ns3;
+using namespace std;
+
+// buckets per decade and decades above 1 us
+static const uint32_t PER_DECADE = 20;
+static const uint32_t DECADES = 8;
+// bucket 0 holds everything up to 1 us, the last bucket everything above 100 s
+static const uint32_t BUCKETS = PER_DECADE * DECADES + 2;
+
+LatencyHistogram::LatencyHistogram() :
+     m_buckets(BUCKETS, 0),
+     m_count(0),
+     m_sum(0),
+     m_min(0),
+     m_max(0) {
+}
+
+// Function to get the bucket of a latency
+uint32_t LatencyHistogram::bucketOf(int64_t nanoSeconds) {
+     if (nanoSeconds <= 1000) {
+          return 0;
+     }
+     double position = log10(nanoSeconds / 1000.0) * PER_DECADE;
+     uint32_t bucket = (uint32_t) ceil(position - 1e-9);
+     return bucket < BUCKETS - 1 ? bucket : BUCKETS - 1;
+}
+
+// Function to get the largest latency of a bucket in ns
+int64_t LatencyHistogram::upperBound(uint32_t bucket) {
+     return (int64_t) llround(1000.0 * pow(10.0, (double) bucket / PER_DECADE));
+}
+
+void LatencyHistogram::add(Time latency) {
+     int64_t value = latency.GetNanoSeconds ();
+     ++m_buckets[bucketOf(value)];
+     if (m_count == 0 || value < m_min) {
+          m_min = value;
+     }
+     if (m_count == 0 || value > m_max) {
+          m_max = value;
+     }
+     m_sum += value;
+     ++m_count;
+}
+
+// Function to add the values of another histogram, e.g. of several subscribers
+void LatencyHistogram::merge(LatencyHistogram const& other) {
+     if (other.m_count == 0) {
+          return;
+     }
+     for (uint32_t i = 0; i < BUCKETS; ++i) {
+          m_buckets[i] += other.m_buckets[i];
+     }
+     if (m_count == 0 || other.m_min < m_min) {
+          m_min = other.m_min;
+     }
+     if (m_count == 0 || other.m_max > m_max) {
+          m_max = other.m_max;
+     }
+     m_sum += other.m_sum;
+     m_count += other.m_count;
+}
+
+uint64_t LatencyHistogram::getCount() const {
+     return m_count;
+}
+
+Time LatencyHistogram::getMin() const {
+     return NanoSeconds (m_min);
+}
+
+Time LatencyHistogram::getMax() const {
+     return NanoSeconds (m_max);
+}
+
+Time LatencyHistogram::getMean() const {
+     return NanoSeconds (m_count > 0 ? m_sum / (int64_t) m_count : 0);
+}
+
+// Function to get the quantile (0..1), limited by the exact maximum
+Time LatencyHistogram::getQuantile(double quantile) const {
+     if (m_count == 0) {
+          return Time ();
+     }
+     uint64_t rank = (uint64_t) ceil(quantile * m_count);
+     uint64_t seen = 0;
+     for (uint32_t i = 0; i < BUCKETS; ++i) {
+          seen += m_buckets[i];
+          if (seen >= rank && seen > 0) {
+               return NanoSeconds (min(upperBound(i), m_max));
+          }
+     }
+     return NanoSeconds (m_max);
+}
+
+// Function to write the non-empty buckets as "prefix,upper bound in us,count" lines
+void LatencyHistogram::writeCsv(ostream& out, string const& prefix) const {
+     for (uint32_t i = 0; i < BUCKETS; ++i) {
+          if (m_buckets[i] > 0) {
+               out << prefix << "," << upperBound(i) / 1000.0 << "," << m_buckets[i] << endl;
+          }
+     }
+}
@@ -0,0 +1,39 @@
+#ifndef LATENCY_HISTOGRAM_H_
+#define LATENCY_HISTOGRAM_H_
+
+#include "ns3/core-module.h"
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+* Histogram of latencies with logarithmic buckets, 20 per decade from 1 us
+* to 100 s (about 12 % resolution). Adding a value is O(1) and the memory
+* does not depend on the number of values, quantiles are the upper bound of
+* their bucket, minimum, maximum and mean are exact.
+*/
+class LatencyHistogram {
+public:
+     LatencyHistogram();
+     void add(ns3::Time latency);
+     void merge(LatencyHistogram const& other);
+
+     uint64_t getCount() const;
+     ns3::Time getMin() const;
+     ns3::Time getMax() const;
+     ns3::Time getMean() const;
+     ns3::Time getQuantile(double quantile) const;
+     void writeCsv(std::ostream& out, std::string const& prefix) const;
+
+private:
+     static uint32_t bucketOf(int64_t nanoSeconds);
+     static int64_t upperBound(uint32_t bucket);
+
+     std::vector<uint64_t> m_buckets;
+     uint64_t m_count;
+     int64_t m_sum;
+     int64_t m_min;
+     int64_t m_max;
+};
+
+#endif /* LATENCY_HISTOGRAM_H_ */
@@ -0,0 +1,70 @@
+#include "link-load-helper.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("LinkLoadHelper");
+
+const int64_t LinkLoadHelper::WINDOW_MS = 100;
+
+LinkLoadHelper::Direction::Direction() :
+     packets(0),
+     bytes(0),
+     window(-1),
+     windowBytes(0),
+     peakBytes(0) {
+}
+
+LinkLoadHelper::LinkLoadHelper() {
+}
+
+// Function to monitor a device, the data rate is taken from its DataRate attribute if it has one
+void LinkLoadHelper::add(string const& label, Ptr<NetDevice> device) {
+     m_links.push_back(Link());
+     Link& link = m_links.back();
+     link.label = label;
+     DataRateValue rate;
+     link.rate = device->GetAttributeFailSafe ("DataRate", rate) ? rate.Get ().GetBitRate () : 0;
+     device->TraceConnectWithoutContext ("MacTx", MakeBoundCallback (&LinkLoadHelper::transmit, &link.tx));
+     device->TraceConnectWithoutContext ("MacRx", MakeBoundCallback (&LinkLoadHelper::transmit, &link.rx));
+}
+
+// Function to add a packet to the totals and to the current window
+void LinkLoadHelper::transmit(Direction* direction, Ptr<Packet const> packet) {
+     uint32_t bytes = packet->GetSize ();
+     int64_t window = Simulator::Now ().GetMilliSeconds () / WINDOW_MS;
+     if (window != direction->window) {
+          direction->window = window;
+          direction->windowBytes = 0;
+     }
+     direction->windowBytes += bytes;
+     direction->peakBytes = max(direction->peakBytes, direction->windowBytes);
+     ++direction->packets;
+     direction->bytes += bytes;
+}
+
+// Function to print the load of every link, tx and rx from the view of the monitored device
+void LinkLoadHelper::report() const {
+     double seconds = Simulator::Now ().GetSeconds ();
+     cout << "Link load:" << endl;
+     cout << setw(12) << left << "link" << right << setw(12) << "tx packets" << setw(14) << "tx mean [kbps]"
+          << setw(14) << "tx peak [kbps]" << setw(12) << "rx packets" << setw(14) << "rx mean [kbps]"
+          << setw(14) << "rx peak [kbps]" << setw(12) << "utilization" << endl;
+     cout << fixed << setprecision(3);
+     for (list<Link>::const_iterator it = m_links.begin(); it != m_links.end(); ++it) {
+          double txMean = seconds > 0 ? it->tx.bytes * 8 / seconds : 0.0;
+          double rxMean = seconds > 0 ? it->rx.bytes * 8 / seconds : 0.0;
+          cout << setw(12) << left << it->label << right
+               << setw(12) << it->tx.packets << setw(14) << txMean / 1000
+               << setw(14) << it->tx.peakBytes * 8.0 / WINDOW_MS
+               << setw(12) << it->rx.packets << setw(14) << rxMean / 1000
+               << setw(14) << it->rx.peakBytes * 8.0 / WINDOW_MS
+               << setw(12) << (it->rate > 0 ? max(txMean, rxMean) / it->rate : 0.0) << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
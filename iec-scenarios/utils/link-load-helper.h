@@ -0,0 +1,45 @@
+#ifndef LINK_LOAD_HELPER_H_
+#define LINK_LOAD_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <string>
+#include <list>
+
+/**
+* Counts the packets and bytes a set of devices send and receive, e.g. the
+* gateway side of the links to the control centers, and reports the mean
+* and the peak rate (over windows of 100 ms) per direction and the mean
+* utilization of the data rate of the device.
+*/
+class LinkLoadHelper {
+public:
+     LinkLoadHelper();
+     void add(std::string const& label, ns3::Ptr<ns3::NetDevice> device);
+     void report() const;
+
+private:
+     struct Direction {
+          Direction();
+          uint64_t packets;
+          uint64_t bytes;
+          int64_t window;
+          uint64_t windowBytes;
+          uint64_t peakBytes;
+     };
+
+     struct Link {
+          std::string label;
+          uint64_t rate;
+          Direction tx;
+          Direction rx;
+     };
+
+     static void transmit(Direction* direction, ns3::Ptr<ns3::Packet const> packet);
+
+     static const int64_t WINDOW_MS;
+     // the callbacks are bound to the links, which must not move
+     std::list<Link> m_links;
+};
+
+#endif /* LINK_LOAD_HELPER_H_ */
@@ -0,0 +1,362 @@
+#include "link-queue-helper.h"
+#include "qos-helper.h"
+
+#include "ns3/point-to-point-module.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("LinkQueueHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (ClassQueueDisc);
+
+const uint32_t ClassQueueDisc::BANDS = 4;
+const uint32_t ClassQueueDisc::QUANTUM = 1500;
+
+ClassQueueDisc::TrafficClass::TrafficClass() :
+     dscp(0),
+     packets(0),
+     drops(0),
+     marked(0) {
+}
+
+TypeId ClassQueueDisc::GetTypeId (void) {
+     static TypeId tid = TypeId ("ClassQueueDisc")
+          .SetParent<QueueDisc> ()
+          .AddConstructor<ClassQueueDisc> ()
+          .AddAttribute ("Mode", "fifo, prio or wrr",
+                         StringValue ("prio"),
+                         MakeStringAccessor (&ClassQueueDisc::m_mode),
+                         MakeStringChecker ())
+          .AddAttribute ("Weights", "Weights of the bands in wrr mode, separated by commas",
+                         StringValue ("8,4,2,1"),
+                         MakeStringAccessor (&ClassQueueDisc::m_weights),
+                         MakeStringChecker ())
+          .AddAttribute ("MaxPackets", "Packets of a band",
+                         UintegerValue (1000),
+                         MakeUintegerAccessor (&ClassQueueDisc::m_maxPackets),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+ClassQueueDisc::ClassQueueDisc() :
+     QueueDisc (QueueDiscSizePolicy::MULTIPLE_QUEUES),
+     m_mode("prio"),
+     m_weights("8,4,2,1"),
+     m_maxPackets(1000),
+     m_current(0),
+     m_visited(false) {
+}
+
+// Function to set the classes, the last one takes the packets of no other class
+void ClassQueueDisc::setClasses(vector<TrafficClass> const& classes) {
+     m_classes = classes;
+}
+
+vector<ClassQueueDisc::TrafficClass> const& ClassQueueDisc::getClasses() const {
+     return m_classes;
+}
+
+// Function to get the band of a DSCP by its class selector
+uint32_t ClassQueueDisc::getBand(uint8_t dscp) {
+     static const uint32_t bands[8] = { 3, 3, 2, 2, 1, 0, 0, 0 };
+     return bands[(dscp >> 3) & 7];
+}
+
+// Function to get the class of a packet by its ports, the IP header is not part of the packet yet
+uint8_t ClassQueueDisc::classify(Ptr<Ipv4QueueDiscItem> item) const {
+     uint8_t other = m_classes.size() - 1;
+     Ipv4Header const& header = item->GetHeader ();
+     if (header.GetFragmentOffset () != 0) {
+          return other;
+     }
+     uint16_t ports[2];
+     if (header.GetProtocol () == TcpL4Protocol::PROT_NUMBER) {
+          TcpHeader tcpHeader;
+          item->GetPacket ()->PeekHeader (tcpHeader);
+          ports[0] = tcpHeader.GetSourcePort ();
+          ports[1] = tcpHeader.GetDestinationPort ();
+     } else if (header.GetProtocol () == UdpL4Protocol::PROT_NUMBER) {
+          UdpHeader udpHeader;
+          item->GetPacket ()->PeekHeader (udpHeader);
+          ports[0] = udpHeader.GetSourcePort ();
+          ports[1] = udpHeader.GetDestinationPort ();
+     } else {
+          return other;
+     }
+     for (uint8_t c = 0; c < other; ++c) {
+          vector<uint16_t> const& classPorts = m_classes[c].ports;
+          if (find(classPorts.begin(), classPorts.end(), ports[0]) != classPorts.end()
+              || find(classPorts.begin(), classPorts.end(), ports[1]) != classPorts.end()) {
+               return c;
+          }
+     }
+     return other;
+}
+
+// Function to mark unmarked packets with the DSCP of their class and to add them to the band of their DSCP
+bool ClassQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item) {
+     uint8_t trafficClass = m_classes.size() - 1;
+     uint8_t dscp = 0;
+     Ptr<Ipv4QueueDiscItem> ipItem = DynamicCast<Ipv4QueueDiscItem> (item);
+     if (ipItem != 0) {
+          trafficClass = classify(ipItem);
+          Ipv4Header header = ipItem->GetHeader ();
+          dscp = header.GetDscp ();
+          if (dscp == 0 && m_classes[trafficClass].dscp != 0) {
+               // the header of the item is constant, the marked one replaces it
+               dscp = m_classes[trafficClass].dscp;
+               header.SetDscp ((Ipv4Header::DscpType) dscp);
+               item = Create<Ipv4QueueDiscItem> (ipItem->GetPacket (), ipItem->GetAddress (), ipItem->GetProtocol (), header);
+               item->SetTxQueueIndex (ipItem->GetTxQueueIndex ());
+               ++m_classes[trafficClass].marked;
+          }
+     }
+     uint32_t band = m_mode == "fifo" ? 0 : getBand(dscp);
+     ++m_classes[trafficClass].packets;
+     if (! GetInternalQueue (band)->Enqueue (item)) {
+          ++m_classes[trafficClass].drops;
+          return false;
+     }
+     Entry entry;
+     entry.time = Simulator::Now ().GetNanoSeconds ();
+     entry.trafficClass = trafficClass;
+     m_entries[band].push_back(entry);
+     return true;
+}
+
+// Function to get the band to serve next, -1 if all are empty
+int32_t ClassQueueDisc::nextBand() {
+     uint32_t bands = GetNInternalQueues ();
+     bool empty = true;
+     for (uint32_t i = 0; i < bands && empty; ++i) {
+          if (! GetInternalQueue (i)->IsEmpty ()) {
+               if (m_mode != "wrr") {
+                    return i;
+               }
+               empty = false;
+          }
+     }
+     if (empty) {
+          return -1;
+     }
+     // deficit round robin, a band gets its quantum when its turn starts and keeps the rest while it has packets
+     while (true) {
+          Ptr<InternalQueue> queue = GetInternalQueue (m_current);
+          if (queue->IsEmpty ()) {
+               m_deficits[m_current] = 0;
+          } else {
+               if (! m_visited) {
+                    m_deficits[m_current] += m_quanta[m_current];
+                    m_visited = true;
+               }
+               uint32_t size = queue->Peek ()->GetSize ();
+               if (size <= m_deficits[m_current]) {
+                    m_deficits[m_current] -= size;
+                    return m_current;
+               }
+          }
+          m_current = (m_current + 1) % bands;
+          m_visited = false;
+     }
+}
+
+// Function to dequeue the next packet and to record its sojourn time
+Ptr<QueueDiscItem> ClassQueueDisc::DoDequeue (void) {
+     int32_t band = nextBand();
+     if (band < 0) {
+          return 0;
+     }
+     Ptr<QueueDiscItem> item = GetInternalQueue (band)->Dequeue ();
+     Entry entry = m_entries[band].front();
+     m_entries[band].pop_front();
+     m_classes[entry.trafficClass].delays.add(NanoSeconds (Simulator::Now ().GetNanoSeconds () - entry.time));
+     return item;
+}
+
+// Function to create the internal queues of the bands
+bool ClassQueueDisc::CheckConfig (void) {
+     if (GetNQueueDiscClasses () > 0 || GetNPacketFilters () > 0) {
+          NS_LOG_ERROR ("ClassQueueDisc needs no queue disc classes and no packet filters");
+          return false;
+     }
+     if (m_mode != "fifo" && m_mode != "prio" && m_mode != "wrr") {
+          NS_LOG_ERROR ("Unknown mode " << m_mode << " of ClassQueueDisc (fifo, prio, wrr)");
+          return false;
+     }
+     if (m_classes.empty()) {
+          NS_LOG_ERROR ("ClassQueueDisc needs the traffic classes");
+          return false;
+     }
+     uint32_t bands = m_mode == "fifo" ? 1 : BANDS;
+     if (GetNInternalQueues () == 0) {
+          for (uint32_t i = 0; i < bands; ++i) {
+               AddInternalQueue (CreateObjectWithAttributes<DropTailQueue<QueueDiscItem> >
+                    ("MaxSize", QueueSizeValue (QueueSize (QueueSizeUnit::PACKETS, m_maxPackets))));
+          }
+     }
+     if (GetNInternalQueues () != bands) {
+          NS_LOG_ERROR ("ClassQueueDisc needs " << bands << " internal queues");
+          return false;
+     }
+     return true;
+}
+
+// Function to read the weights into the quanta of the bands
+void ClassQueueDisc::InitializeParams (void) {
+     m_entries.assign(GetNInternalQueues (), deque<Entry>());
+     m_quanta.assign(GetNInternalQueues (), QUANTUM);
+     istringstream weights(m_weights);
+     string weight;
+     for (uint32_t band = 0; band < m_quanta.size() && getline(weights, weight, ','); ++band) {
+          m_quanta[band] = max(atoi(weight.c_str()), 1) * QUANTUM;
+     }
+     m_deficits.assign(m_quanta.size(), 0);
+     m_current = 0;
+     m_visited = false;
+}
+
+LinkQueueHelper::LinkQueueHelper() {
+}
+
+// Function to read the mode, the DSCP of the classes as "class=dscp,..." and the weights of the bands
+void LinkQueueHelper::configure(string const& mode, string const& dscps, string const& weights) {
+     m_mode = mode;
+     m_weights = weights;
+     m_classes.clear();
+     if (mode.empty()) {
+          return;
+     }
+     NS_ABORT_MSG_UNLESS (mode == "fifo" || mode == "prio" || mode == "wrr", "Unknown link queue " << mode << " (fifo, prio, wrr)");
+     vector<QosHelper::TrafficClass> classes = QosHelper::getClasses();
+     for (size_t i = 0; i < classes.size(); ++i) {
+          ClassQueueDisc::TrafficClass trafficClass;
+          trafficClass.name = classes[i].name;
+          trafficClass.ports = classes[i].ports;
+          m_classes.push_back(trafficClass);
+     }
+     ClassQueueDisc::TrafficClass other;
+     other.name = "other";
+     m_classes.push_back(other);
+
+     istringstream entries(dscps);
+     string entry;
+     while (getline(entries, entry, ',')) {
+          size_t equal = entry.find('=');
+          NS_ABORT_MSG_IF (equal == string::npos, "Invalid DSCP " << entry << ", expected class=dscp");
+          string name = entry.substr(0, equal);
+          int dscp = atoi(entry.substr(equal + 1).c_str());
+          NS_ABORT_MSG_UNLESS (dscp >= 0 && dscp < 64, "Invalid DSCP in " << entry);
+          bool known = false;
+          for (size_t i = 0; i < m_classes.size(); ++i) {
+               if (m_classes[i].name == name) {
+                    m_classes[i].dscp = dscp;
+                    known = true;
+               }
+          }
+          NS_ABORT_MSG_UNLESS (known, "Unknown traffic class " << name << " (mms, reports, goose, file, other)");
+     }
+     istringstream values(weights);
+     string weight;
+     while (getline(values, weight, ',')) {
+          NS_ABORT_MSG_UNLESS (atoi(weight.c_str()) > 0, "Invalid link queue weight " << weight);
+     }
+}
+
+bool LinkQueueHelper::isEnabled() const {
+     return ! m_mode.empty();
+}
+
+// Function to replace the root queue disc of every point-to-point device of the nodes
+void LinkQueueHelper::install(NodeContainer const& nodes) {
+     if (! isEnabled()) {
+          return;
+     }
+     TrafficControlHelper trafficControl;
+     trafficControl.SetRootQueueDisc ("ClassQueueDisc", "Mode", StringValue (m_mode), "Weights", StringValue (m_weights));
+     uint32_t devices = 0;
+     for (uint32_t i = 0; i < nodes.GetN (); ++i) {
+          Ptr<Node> node = nodes.Get (i);
+          Ptr<TrafficControlLayer> layer = node->GetObject<TrafficControlLayer> ();
+          for (uint32_t j = 0; j < node->GetNDevices (); ++j) {
+               Ptr<NetDevice> device = node->GetDevice (j);
+               if (DynamicCast<PointToPointNetDevice> (device) == 0 || layer == 0) {
+                    continue;
+               }
+               if (layer->GetRootQueueDiscOnDevice (device) != 0) {
+                    trafficControl.Uninstall (device);
+               }
+               QueueDiscContainer queueDiscs = trafficControl.Install (device);
+               Ptr<ClassQueueDisc> queueDisc = DynamicCast<ClassQueueDisc> (queueDiscs.Get (0));
+               queueDisc->setClasses(m_classes);
+               m_queueDiscs.push_back(queueDisc);
+               ++devices;
+          }
+     }
+     NS_LOG_INFO ("Installed " << m_mode << " link queues on " << devices << " devices.");
+}
+
+// Function to sum the counters and the sojourn times of all queue discs per class
+vector<ClassQueueDisc::TrafficClass> LinkQueueHelper::getTotals() const {
+     vector<ClassQueueDisc::TrafficClass> totals = m_classes;
+     for (size_t i = 0; i < m_queueDiscs.size(); ++i) {
+          vector<ClassQueueDisc::TrafficClass> const& classes = m_queueDiscs[i]->getClasses();
+          for (size_t c = 0; c < classes.size() && c < totals.size(); ++c) {
+               totals[c].packets += classes[c].packets;
+               totals[c].drops += classes[c].drops;
+               totals[c].marked += classes[c].marked;
+               totals[c].delays.merge(classes[c].delays);
+          }
+     }
+     return totals;
+}
+
+// Function to print the queueing delay and the drops per class over all links, every hop counts
+void LinkQueueHelper::report() const {
+     vector<ClassQueueDisc::TrafficClass> totals = getTotals();
+     cout << "Link queues (" << m_mode << ", " << m_queueDiscs.size() << " devices):" << endl;
+     cout << setw(10) << left << "class" << right << setw(6) << "dscp" << setw(12) << "packets" << setw(10) << "drops"
+          << setw(10) << "marked" << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << endl;
+     cout << fixed << setprecision(3);
+     for (size_t c = 0; c < totals.size(); ++c) {
+          if (totals[c].packets == 0) {
+               continue;
+          }
+          LatencyHistogram const& delays = totals[c].delays;
+          cout << setw(10) << left << totals[c].name << right << setw(6) << (uint32_t) totals[c].dscp
+               << setw(12) << totals[c].packets << setw(10) << totals[c].drops << setw(10) << totals[c].marked
+               << setw(10) << delays.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << delays.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the queueing KPIs per class as "class_name=value" lines
+bool LinkQueueHelper::writeKpi(string const& fileName) const {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write link queue KPI file " << fileName);
+          return false;
+     }
+     vector<ClassQueueDisc::TrafficClass> totals = getTotals();
+     for (size_t c = 0; c < totals.size(); ++c) {
+          LatencyHistogram const& delays = totals[c].delays;
+          string prefix = totals[c].name + "_";
+          out << prefix << "packets=" << totals[c].packets << endl;
+          out << prefix << "drops=" << totals[c].drops << endl;
+          out << prefix << "marked=" << totals[c].marked << endl;
+          out << prefix << "p50_ms=" << delays.getQuantile(0.5).GetSeconds () * 1000 << endl;
+          out << prefix << "p99_ms=" << delays.getQuantile(0.99).GetSeconds () * 1000 << endl;
+          out << prefix << "max_ms=" << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     return true;
+}
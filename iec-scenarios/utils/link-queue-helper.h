@@ -0,0 +1,98 @@
+#ifndef LINK_QUEUE_HELPER_H_
+#define LINK_QUEUE_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/traffic-control-module.h"
+#include "latency-histogram.h"
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+* Root queue disc of a station link which marks and schedules the IEC
+* traffic classes. Packets are assigned to the classes by their TCP or UDP
+* ports; unmarked packets (DSCP 0) get the DSCP of their class, so the first
+* hop marks and the routers keep the marking.
+*
+* The band of a packet follows the class selector of its DSCP: 5-7 (EF,
+* network control) band 0, 4 band 1, 2-3 band 2, 0-1 band 3. Mode "prio"
+* always serves the lowest non-empty band, "wrr" serves the bands by deficit
+* round robin with Weights times 1500 bytes per round, "fifo" has one band.
+* Every band holds MaxPackets packets.
+*
+* The sojourn time in the queue disc is recorded per class.
+*/
+class ClassQueueDisc : public ns3::QueueDisc {
+public:
+     struct TrafficClass {
+          TrafficClass();
+          std::string name;
+          std::vector<uint16_t> ports;
+          uint8_t dscp;
+          uint64_t packets;
+          uint64_t drops;
+          uint64_t marked;
+          LatencyHistogram delays;
+     };
+
+     static ns3::TypeId GetTypeId (void);
+     ClassQueueDisc();
+     void setClasses(std::vector<TrafficClass> const& classes);
+     std::vector<TrafficClass> const& getClasses() const;
+     static uint32_t getBand(uint8_t dscp);
+
+private:
+     struct Entry {
+          int64_t time;
+          uint8_t trafficClass;
+     };
+
+     virtual bool DoEnqueue (ns3::Ptr<ns3::QueueDiscItem> item);
+     virtual ns3::Ptr<ns3::QueueDiscItem> DoDequeue (void);
+     virtual bool CheckConfig (void);
+     virtual void InitializeParams (void);
+     uint8_t classify(ns3::Ptr<ns3::Ipv4QueueDiscItem> item) const;
+     int32_t nextBand();
+
+     static const uint32_t BANDS;
+     static const uint32_t QUANTUM;
+
+     std::string m_mode;
+     std::string m_weights;
+     uint32_t m_maxPackets;
+     std::vector<TrafficClass> m_classes;
+     // enqueue time and class of the packets of every band, in the order of the internal queues
+     std::vector<std::deque<Entry> > m_entries;
+     std::vector<uint32_t> m_quanta;
+     std::vector<uint32_t> m_deficits;
+     uint32_t m_current;
+     bool m_visited;
+};
+
+/**
+* Installs a ClassQueueDisc on the point-to-point devices of the station
+* links and reports the queueing delay per class over all of them. The
+* DSCP of the classes are configured as "class=dscp,..." (mms, reports,
+* goose, file), the unlisted classes and other traffic stay best effort.
+*/
+class LinkQueueHelper {
+public:
+     LinkQueueHelper();
+     void configure(std::string const& mode, std::string const& dscps, std::string const& weights);
+     bool isEnabled() const;
+     void install(ns3::NodeContainer const& nodes);
+     void report() const;
+     bool writeKpi(std::string const& fileName) const;
+
+private:
+     std::vector<ClassQueueDisc::TrafficClass> getTotals() const;
+
+     std::string m_mode;
+     std::string m_weights;
+     std::vector<ClassQueueDisc::TrafficClass> m_classes;
+     std::vector<ns3::Ptr<ClassQueueDisc> > m_queueDiscs;
+};
+
+#endif /* LINK_QUEUE_HELPER_H_ */
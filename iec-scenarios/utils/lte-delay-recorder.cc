@@ -0,0 +1,264 @@
+#include "lte-delay-recorder.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("LteDelayRecorder");
+
+// Function to order the packet keys, the fields are compared one after the other
+bool LteDelayRecorder::PacketKey::operator<(PacketKey const& other) const {
+     if (source != other.source) {
+          return source < other.source;
+     }
+     if (destination != other.destination) {
+          return destination < other.destination;
+     }
+     if (identification != other.identification) {
+          return identification < other.identification;
+     }
+     if (ports != other.ports) {
+          return ports < other.ports;
+     }
+     if (fragmentOffset != other.fragmentOffset) {
+          return fragmentOffset < other.fragmentOffset;
+     }
+     return protocol < other.protocol;
+}
+
+LteDelayRecorder::LteDelayRecorder() :
+     m_pgw(0) {
+}
+
+// Function to add a traffic class with the ports of its applications, before the installation
+void LteDelayRecorder::addClass(string const& name, vector<uint16_t> const& ports) {
+     TrafficClass trafficClass;
+     trafficClass.name = name;
+     trafficClass.ports = ports;
+     for (uint32_t d = 0; d < 2; ++d) {
+          trafficClass.sent[d] = 0;
+          trafficClass.bytes[d] = 0;
+     }
+     m_classes.push_back(trafficClass);
+}
+
+// Function to connect to the IP traces of the PGW and the UEs
+void LteDelayRecorder::install(Ptr<Node> pgw, NodeContainer const& ues) {
+     addClass("other", vector<uint16_t>());
+     m_pgw = pgw->GetId ();
+     NodeContainer nodes (pgw);
+     nodes.Add (ues);
+     for (uint32_t i = 0; i < nodes.GetN (); ++i) {
+          Ptr<Ipv4L3Protocol> ipv4 = nodes.Get (i)->GetObject<Ipv4L3Protocol> ();
+          ipv4->TraceConnectWithoutContext ("Tx", MakeCallback (&LteDelayRecorder::transmit, this));
+          ipv4->TraceConnectWithoutContext ("Rx", MakeCallback (&LteDelayRecorder::receive, this));
+     }
+     for (uint32_t i = 0; i < ues.GetN (); ++i) {
+          Ptr<Ipv4> ipv4 = ues.Get (i)->GetObject<Ipv4> ();
+          for (uint32_t j = 1; j < ipv4->GetNInterfaces (); ++j) {
+               m_ueAddresses[ipv4->GetAddress (j, 0).GetLocal ().Get ()] = ues.Get (i)->GetId ();
+          }
+     }
+}
+
+// Function to check for the tun device of the PGW, which carries the inner packets
+bool LteDelayRecorder::isTun(Ptr<Ipv4> ipv4, uint32_t interface) const {
+     return ipv4->GetNetDevice (interface)->GetInstanceTypeId ().GetName () == "ns3::VirtualNetDevice";
+}
+
+// Function to get the class of an IP packet by its source or destination port, the last class ("other")
+// if no port matches, and the key identifying the packet at the receiver
+uint8_t LteDelayRecorder::classify(Ptr<Packet const> packet, PacketKey& key) const {
+     uint8_t other = m_classes.size() - 1;
+     Ptr<Packet> copy = packet->Copy ();
+     Ipv4Header header;
+     copy->RemoveHeader (header);
+     key.source = header.GetSource ().Get ();
+     key.destination = header.GetDestination ().Get ();
+     key.ports = 0;
+     key.identification = header.GetIdentification ();
+     key.fragmentOffset = header.GetFragmentOffset ();
+     key.protocol = header.GetProtocol ();
+     if (header.GetFragmentOffset () != 0) {
+          return other;
+     }
+     uint16_t ports[2];
+     if (header.GetProtocol () == TcpL4Protocol::PROT_NUMBER) {
+          TcpHeader tcpHeader;
+          copy->PeekHeader (tcpHeader);
+          ports[0] = tcpHeader.GetSourcePort ();
+          ports[1] = tcpHeader.GetDestinationPort ();
+     } else if (header.GetProtocol () == UdpL4Protocol::PROT_NUMBER) {
+          UdpHeader udpHeader;
+          copy->PeekHeader (udpHeader);
+          ports[0] = udpHeader.GetSourcePort ();
+          ports[1] = udpHeader.GetDestinationPort ();
+     } else {
+          return other;
+     }
+     key.ports = ((uint32_t) ports[0] << 16) | ports[1];
+     for (uint8_t c = 0; c < other; ++c) {
+          vector<uint16_t> const& classPorts = m_classes[c].ports;
+          if (find(classPorts.begin(), classPorts.end(), ports[0]) != classPorts.end()
+              || find(classPorts.begin(), classPorts.end(), ports[1]) != classPorts.end()) {
+               return c;
+          }
+     }
+     return other;
+}
+
+void LteDelayRecorder::transmit(Ptr<Packet const> packet, Ptr<Ipv4> ipv4, uint32_t interface) {
+     uint32_t node = ipv4->GetObject<Node> ()->GetId ();
+     Direction direction;
+     uint32_t ue;
+     if (node == m_pgw) {
+          if (! isTun(ipv4, interface)) {
+               return;
+          }
+          Ipv4Header header;
+          packet->PeekHeader (header);
+          map<uint32_t, uint32_t>::const_iterator it = m_ueAddresses.find(header.GetDestination ().Get ());
+          if (it == m_ueAddresses.end()) {
+               return;
+          }
+          direction = DOWNLINK;
+          ue = it->second;
+     } else if (interface == 0) {
+          // local packets of the UE over the loopback device
+          return;
+     } else {
+          direction = UPLINK;
+          ue = node;
+     }
+     PacketKey key;
+     Pending pending;
+     pending.sendTime = Simulator::Now ().GetNanoSeconds ();
+     pending.trafficClass = classify(packet, key);
+     // a lost packet with the same key, e.g. after the identification wrapped, is replaced
+     m_pending[direction][key] = pending;
+     ++m_sent[direction][ue];
+     ++m_classes[pending.trafficClass].sent[direction];
+}
+
+void LteDelayRecorder::receive(Ptr<Packet const> packet, Ptr<Ipv4> ipv4, uint32_t interface) {
+     uint32_t node = ipv4->GetObject<Node> ()->GetId ();
+     Direction direction = node == m_pgw ? UPLINK : DOWNLINK;
+     if (direction == UPLINK && ! isTun(ipv4, interface)) {
+          return;
+     }
+     PacketKey key;
+     classify(packet, key);
+     map<PacketKey, Pending>::iterator pending = m_pending[direction].find(key);
+     if (pending == m_pending[direction].end()) {
+          return;
+     }
+     int64_t sendTime = pending->second.sendTime;
+     uint8_t trafficClassIndex = pending->second.trafficClass;
+     m_pending[direction].erase(pending);
+     uint32_t ue = node;
+     if (direction == UPLINK) {
+          Ipv4Header header;
+          packet->PeekHeader (header);
+          map<uint32_t, uint32_t>::const_iterator it = m_ueAddresses.find(header.GetSource ().Get ());
+          if (it == m_ueAddresses.end()) {
+               return;
+          }
+          ue = it->second;
+     }
+     Record record;
+     record.ue = ue;
+     record.direction = direction;
+     record.trafficClass = trafficClassIndex;
+     record.delay = Simulator::Now ().GetNanoSeconds () - sendTime;
+     m_records.push_back(record);
+
+     TrafficClass& trafficClass = m_classes[trafficClassIndex];
+     if (trafficClass.delays[direction].getCount() == 0) {
+          trafficClass.first[direction] = Simulator::Now ();
+     }
+     trafficClass.last[direction] = Simulator::Now ();
+     trafficClass.bytes[direction] += packet->GetSize ();
+     trafficClass.delays[direction].add(NanoSeconds (record.delay));
+}
+
+// Function to write "delay,ue,direction,us,class" per received packet and "sent,ue,direction,packets" per UE
+bool LteDelayRecorder::writeCsv(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write LTE delay file " << fileName);
+          return false;
+     }
+     const char* directions[2] = { "ul", "dl" };
+     out << "kind,ue,direction,value,class" << endl;
+     for (uint32_t d = 0; d < 2; ++d) {
+          for (map<uint32_t, uint64_t>::const_iterator it = m_sent[d].begin(); it != m_sent[d].end(); ++it) {
+               out << "sent," << it->first << "," << directions[d] << "," << it->second << "," << endl;
+          }
+     }
+     for (size_t i = 0; i < m_records.size(); ++i) {
+          out << "delay," << m_records[i].ue << "," << directions[m_records[i].direction] << ","
+              << m_records[i].delay / 1000.0 << "," << m_classes[m_records[i].trafficClass].name << endl;
+     }
+     return true;
+}
+
+// Function to get the received bit rate of a class in kbps between its first and last packet
+double LteDelayRecorder::getThroughput(TrafficClass const& trafficClass, uint32_t direction) const {
+     double seconds = (trafficClass.last[direction] - trafficClass.first[direction]).GetSeconds ();
+     return seconds > 0 ? trafficClass.bytes[direction] * 8 / seconds / 1000 : 0.0;
+}
+
+// Function to print the delay, loss and throughput per traffic class and direction
+void LteDelayRecorder::report() {
+     const char* directions[2] = { "ul", "dl" };
+     cout << "LTE traffic classes:" << endl;
+     cout << setw(10) << left << "class" << setw(5) << "dir" << right << setw(10) << "sent" << setw(8) << "loss"
+          << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << setw(12) << "kbps" << endl;
+     cout << fixed << setprecision(3);
+     for (size_t c = 0; c < m_classes.size(); ++c) {
+          for (uint32_t d = 0; d < 2; ++d) {
+               TrafficClass const& trafficClass = m_classes[c];
+               if (trafficClass.sent[d] == 0) {
+                    continue;
+               }
+               LatencyHistogram const& delays = trafficClass.delays[d];
+               cout << setw(10) << left << trafficClass.name << setw(5) << directions[d] << right
+                    << setw(10) << trafficClass.sent[d]
+                    << setw(8) << 1.0 - (double) delays.getCount() / trafficClass.sent[d]
+                    << setw(10) << delays.getQuantile(0.5).GetSeconds () * 1000
+                    << setw(10) << delays.getQuantile(0.99).GetSeconds () * 1000
+                    << setw(10) << delays.getMax().GetSeconds () * 1000
+                    << setw(12) << getThroughput(trafficClass, d) << endl;
+          }
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the KPIs per class and direction as "class_direction_name=value" lines
+bool LteDelayRecorder::writeKpi(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write LTE bearer KPI file " << fileName);
+          return false;
+     }
+     const char* directions[2] = { "ul", "dl" };
+     for (size_t c = 0; c < m_classes.size(); ++c) {
+          for (uint32_t d = 0; d < 2; ++d) {
+               TrafficClass const& trafficClass = m_classes[c];
+               LatencyHistogram const& delays = trafficClass.delays[d];
+               string prefix = trafficClass.name + "_" + directions[d] + "_";
+               out << prefix << "sent=" << trafficClass.sent[d] << endl;
+               out << prefix << "received=" << delays.getCount() << endl;
+               out << prefix << "p50_ms=" << delays.getQuantile(0.5).GetSeconds () * 1000 << endl;
+               out << prefix << "p99_ms=" << delays.getQuantile(0.99).GetSeconds () * 1000 << endl;
+               out << prefix << "max_ms=" << delays.getMax().GetSeconds () * 1000 << endl;
+               out << prefix << "kbps=" << getThroughput(trafficClass, d) << endl;
+          }
+     }
+     return true;
+}
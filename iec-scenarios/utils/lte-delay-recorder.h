@@ -0,0 +1,85 @@
+#ifndef LTE_DELAY_RECORDER_H_
+#define LTE_DELAY_RECORDER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Records the one-way delay of every IP packet between the UEs and the PGW
+* of the full LTE model, i.e. the part the trace links replace. Packets are
+* remembered when the UE sends them (uplink) or the PGW sends them into the
+* tun device (downlink) and measured when the PGW receives them from the tun
+* device or the UE receives them. The IP traces see copies of the packets,
+* so a packet is found again by its addresses, protocol, ports, IP
+* identification and fragment offset instead of a tag. Packets sent but not
+* received are lost.
+*
+* Packets are assigned to the traffic classes by their TCP or UDP ports,
+* the others to the class "other", for the delay, loss and throughput per
+* class and direction, i.e. per bearer if the classes have their own.
+*/
+class LteDelayRecorder {
+public:
+     enum Direction { UPLINK, DOWNLINK };
+
+     LteDelayRecorder();
+     void addClass(std::string const& name, std::vector<uint16_t> const& ports);
+     void install(ns3::Ptr<ns3::Node> pgw, ns3::NodeContainer const& ues);
+     bool writeCsv(std::string const& fileName);
+     void report();
+     bool writeKpi(std::string const& fileName);
+
+private:
+     struct PacketKey {
+          uint32_t source;
+          uint32_t destination;
+          uint32_t ports;
+          uint16_t identification;
+          uint16_t fragmentOffset;
+          uint8_t protocol;
+          bool operator<(PacketKey const& other) const;
+     };
+
+     struct Pending {
+          int64_t sendTime;
+          uint8_t trafficClass;
+     };
+
+     struct Record {
+          uint32_t ue;
+          uint8_t direction;
+          uint8_t trafficClass;
+          int64_t delay;
+     };
+
+     struct TrafficClass {
+          std::string name;
+          std::vector<uint16_t> ports;
+          uint64_t sent[2];
+          uint64_t bytes[2];
+          ns3::Time first[2];
+          ns3::Time last[2];
+          LatencyHistogram delays[2];
+     };
+
+     void transmit(ns3::Ptr<ns3::Packet const> packet, ns3::Ptr<ns3::Ipv4> ipv4, uint32_t interface);
+     void receive(ns3::Ptr<ns3::Packet const> packet, ns3::Ptr<ns3::Ipv4> ipv4, uint32_t interface);
+     bool isTun(ns3::Ptr<ns3::Ipv4> ipv4, uint32_t interface) const;
+     uint8_t classify(ns3::Ptr<ns3::Packet const> packet, PacketKey& key) const;
+     double getThroughput(TrafficClass const& trafficClass, uint32_t direction) const;
+
+     uint32_t m_pgw;
+     std::map<uint32_t, uint32_t> m_ueAddresses;
+     std::map<uint32_t, uint64_t> m_sent[2];
+     // packets sent and not yet received per direction
+     std::map<PacketKey, Pending> m_pending[2];
+     std::vector<Record> m_records;
+     std::vector<TrafficClass> m_classes;
+};
+
+#endif /* LTE_DELAY_RECORDER_H_ */
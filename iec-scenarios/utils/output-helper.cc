@@ -0,0 +1,245 @@
+#include "output-helper.h"
+#include "string-helper.h"
+#include "ns3/dce-module.h"
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <linux/falloc.h>
+#include <errno.h>
+#include <dirent.h>
+#include <ftw.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("OutputHelper");
+
+OutputHelper::OutputHelper() :
+     m_mode("files"),
+     m_ringSize(4096),
+     m_trimInterval(Seconds (10.0)),
+     m_logFile("dce-output.log"),
+     m_memoryDir("/dev/shm") {
+}
+
+// Function to set the mode (files, ring or log)
+void OutputHelper::setMode(string const& mode) {
+     NS_ABORT_MSG_UNLESS (mode == "files" || mode == "ring" || mode == "log",
+          "Unknown output mode " << mode);
+     m_mode = mode;
+}
+
+// Function to set the number of bytes kept per output in ring mode
+void OutputHelper::setRingSize(uint32_t size) {
+     m_ringSize = size;
+}
+
+// Function to set the simulated time between two trims in ring mode, zero trims only at the end
+void OutputHelper::setTrimInterval(Time interval) {
+     NS_ABORT_MSG_IF (interval < Seconds (0.0), "Negative output trim interval " << interval.GetSeconds ());
+     m_trimInterval = interval;
+}
+
+// Function to set the consolidated log file of the log mode
+void OutputHelper::setLogFile(string const& fileName) {
+     m_logFile = fileName;
+}
+
+// Function to set the directory in memory which takes the outputs
+void OutputHelper::setMemoryDir(string const& dir) {
+     m_memoryDir = dir;
+}
+
+// Function to link files-N/var/log of the nodes to the memory directory
+void OutputHelper::prepare(NodeContainer const& nodes) {
+     if (m_mode == "files") {
+          return;
+     }
+     m_base = m_memoryDir + "/dce-output-" + StringHelper::toString((unsigned int) getpid());
+     for (NodeContainer::Iterator it = nodes.Begin (); it != nodes.End (); ++it) {
+          uint32_t id = (*it)->GetId ();
+          string target = m_base + "/" + StringHelper::toString(id);
+          string var = "files-" + StringHelper::toString(id) + "/var";
+          string link = var + "/log";
+          struct stat st;
+          if (lstat(link.c_str(), &st) == 0) {
+               if (!S_ISLNK(st.st_mode)) {
+                    NS_LOG_WARN ("Keeping existing " << link << ", output of node " << id << " stays on disk");
+                    continue;
+               }
+               unlink(link.c_str());
+          }
+          if (!makeDirs(target) || !makeDirs(var) || symlink(target.c_str(), link.c_str()) != 0) {
+               NS_LOG_WARN ("Cannot link " << link << " to " << target);
+               continue;
+          }
+          m_nodes.push_back(id);
+     }
+     if (m_mode == "ring" && ! m_nodes.empty() && ! m_trimInterval.IsZero ()) {
+          Simulator::Schedule (m_trimInterval, &OutputHelper::trim, this);
+     }
+}
+
+// Function to release all but the last ring size bytes of every output, repeated every trim interval
+void OutputHelper::trim() {
+     for (size_t n = 0; n < m_nodes.size(); ++n) {
+          string dir = m_base + "/" + StringHelper::toString(m_nodes[n]);
+          DIR* d = opendir(dir.c_str());
+          if (d == NULL) {
+               continue;
+          }
+          struct dirent* entry;
+          while ((entry = readdir(d)) != NULL) {
+               if (entry->d_name[0] == '.') {
+                    continue;
+               }
+               trimFile(dir + "/" + entry->d_name + "/stdout");
+               trimFile(dir + "/" + entry->d_name + "/stderr");
+          }
+          closedir(d);
+     }
+     Simulator::Schedule (m_trimInterval, &OutputHelper::trim, this);
+}
+
+// Function to punch a hole before the last ring size bytes of a file, its size and the write offsets stay
+void OutputHelper::trimFile(string const& fileName) {
+     struct stat st;
+     if (stat(fileName.c_str(), &st) != 0 || st.st_size <= (off_t) m_ringSize) {
+          return;
+     }
+     off_t& trimmed = m_trimmed[fileName];
+     off_t end = st.st_size - m_ringSize;
+     if (end <= trimmed) {
+          return;
+     }
+     int fd = open(fileName.c_str(), O_WRONLY);
+     if (fd < 0) {
+          return;
+     }
+     if (fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, trimmed, end - trimmed) == 0) {
+          trimmed = end;
+     } else {
+          NS_LOG_WARN ("Cannot release the output " << fileName << ": " << strerror(errno));
+     }
+     close(fd);
+}
+
+// Function to read at most ring size bytes from the end of a file
+string OutputHelper::readTail(string const& fileName) {
+     ifstream in(fileName.c_str(), ios::binary);
+     if (!in.is_open()) {
+          return "";
+     }
+     in.seekg(0, ios::end);
+     streamoff size = in.tellg();
+     streamoff start = size > (streamoff) m_ringSize ? size - m_ringSize : 0;
+     in.seekg(start, ios::beg);
+     string data(size - start, '\0');
+     in.read(&data[0], data.size());
+     return data;
+}
+
+// Function to copy an output line by line with node and pid prefix
+void OutputHelper::append(ostream& out, Output const& output, string const& fileName) {
+     ifstream in(fileName.c_str());
+     string prefix = "[node " + StringHelper::toString(output.node) + " pid "
+          + StringHelper::toString(output.pid) + " " + output.stream + "] ";
+     string line;
+     while (getline(in, line)) {
+          out << prefix << line << '\n';
+     }
+}
+
+// Function to collect the outputs after the run and to remove the files
+void OutputHelper::collect(bool dumpAll) {
+     if (m_mode == "files" || m_nodes.empty()) {
+          return;
+     }
+     // exit codes of the finished processes
+     map<pair<uint32_t, uint32_t>, int> exitCodes;
+     vector<ProcStatus> status = DceManagerHelper::GetProcStatus ();
+     for (size_t i = 0; i < status.size(); ++i) {
+          exitCodes[make_pair(status[i].GetNode (), status[i].GetPid ())] = status[i].GetExitCode ();
+     }
+
+     ofstream log;
+     if (m_mode == "log") {
+          log.open(m_logFile.c_str());
+     }
+     const char* streams[] = { "stdout", "stderr" };
+     uint32_t failed = 0;
+     for (size_t n = 0; n < m_nodes.size(); ++n) {
+          string dir = m_base + "/" + StringHelper::toString(m_nodes[n]);
+          DIR* d = opendir(dir.c_str());
+          if (d == NULL) {
+               continue;
+          }
+          struct dirent* entry;
+          while ((entry = readdir(d)) != NULL) {
+               if (entry->d_name[0] == '.') {
+                    continue;
+               }
+               Output output;
+               output.node = m_nodes[n];
+               output.pid = atoi(entry->d_name);
+               map<pair<uint32_t, uint32_t>, int>::const_iterator code =
+                    exitCodes.find(make_pair(output.node, output.pid));
+               output.exitCode = code != exitCodes.end() ? code->second : 0;
+               if (output.exitCode != 0) {
+                    ++failed;
+               }
+               for (uint32_t s = 0; s < 2; ++s) {
+                    output.stream = streams[s];
+                    string fileName = dir + "/" + entry->d_name + "/" + output.stream;
+                    if (m_mode == "log") {
+                         append(log, output, fileName);
+                    } else if (dumpAll || output.exitCode != 0) {
+                         output.data = readTail(fileName);
+                         if (!output.data.empty()) {
+                              cout << "==== node " << output.node << " pid " << output.pid
+                                   << " exit " << output.exitCode << " " << output.stream
+                                   << " (last " << m_ringSize << " bytes) ====" << endl;
+                              cout << output.data << endl;
+                         }
+                    }
+               }
+          }
+          closedir(d);
+          unlink(("files-" + StringHelper::toString(m_nodes[n]) + "/var/log").c_str());
+     }
+     removeTree(m_base);
+     m_trimmed.clear();
+     if (failed > 0) {
+          cout << "Failed DCE processes: " << failed << endl;
+     }
+     m_nodes.clear();
+}
+
+// Function to create a directory and its parents
+bool OutputHelper::makeDirs(string const& path) {
+     for (size_t pos = path.find('/', 1); ; pos = path.find('/', pos + 1)) {
+          string dir = path.substr(0, pos);
+          if (mkdir(dir.c_str(), 0755) != 0 && errno != EEXIST) {
+               return false;
+          }
+          if (pos == string::npos) {
+               return true;
+          }
+     }
+}
+
+static int removeEntry(const char* path, const struct stat* st, int flag, struct FTW* ftw) {
+     return remove(path);
+}
+
+// Function to remove a directory with all its content
+void OutputHelper::removeTree(string const& path) {
+     nftw(path.c_str(), removeEntry, 16, FTW_DEPTH | FTW_PHYS);
+}
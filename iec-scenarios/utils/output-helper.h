@@ -0,0 +1,63 @@
+#ifndef OUTPUT_HELPER_H_
+#define OUTPUT_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include <sys/types.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+* Captures stdout and stderr of the DCE processes.
+*
+* Modes:
+*  files - DCE writes files-N/var/log/<pid>/ as usual.
+*  ring  - files-N/var/log is linked to a directory in memory (tmpfs). Every
+*          trim interval of simulated time all but the last ring size bytes
+*          of every output are released by punching a hole into the file, so
+*          the memory stays bounded by the ring size and the output of one
+*          interval. After the run the kept bytes are printed for failed
+*          processes or on request, the files are removed.
+*  log   - like ring, but all outputs are merged into one log file with
+*          node and pid prefixes.
+*/
+class OutputHelper {
+public:
+     OutputHelper();
+     void setMode(std::string const& mode);
+     void setRingSize(uint32_t size);
+     void setTrimInterval(ns3::Time interval);
+     void setLogFile(std::string const& fileName);
+     void setMemoryDir(std::string const& dir);
+     void prepare(ns3::NodeContainer const& nodes);
+     void collect(bool dumpAll);
+
+private:
+     struct Output {
+          uint32_t node;
+          uint32_t pid;
+          int exitCode;
+          std::string stream;
+          std::string data;
+     };
+
+     void trim();
+     void trimFile(std::string const& fileName);
+     std::string readTail(std::string const& fileName);
+     void append(std::ostream& out, Output const& output, std::string const& fileName);
+     static bool makeDirs(std::string const& path);
+     static void removeTree(std::string const& path);
+
+     std::string m_mode;
+     uint32_t m_ringSize;
+     ns3::Time m_trimInterval;
+     std::string m_logFile;
+     std::string m_memoryDir;
+     std::string m_base;
+     std::vector<uint32_t> m_nodes;
+     // bytes at the start of every output which are already released
+     std::map<std::string, off_t> m_trimmed;
+};
+
+#endif /* OUTPUT_HELPER_H_ */
@@ -0,0 +1,297 @@
+#include "poll-probe.h"
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("PollProbe");
+
+NS_OBJECT_ENSURE_REGISTERED (PollProbeServer);
+NS_OBJECT_ENSURE_REGISTERED (PollProbeClient);
+
+TypeId PollProbeServer::GetTypeId (void) {
+     static TypeId tid = TypeId ("PollProbeServer")
+          .SetParent<Application> ()
+          .AddConstructor<PollProbeServer> ()
+          .AddAttribute ("Port", "TCP port of the probe",
+                         UintegerValue (10104),
+                         MakeUintegerAccessor (&PollProbeServer::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("RequestSize", "Bytes of a poll request",
+                         UintegerValue (100),
+                         MakeUintegerAccessor (&PollProbeServer::m_requestSize),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ResponseSize", "Bytes of a poll response",
+                         UintegerValue (1000),
+                         MakeUintegerAccessor (&PollProbeServer::m_responseSize),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+PollProbeServer::PollProbeServer() :
+     m_port(10104),
+     m_requestSize(100),
+     m_responseSize(1000) {
+}
+
+void PollProbeServer::DoDispose (void) {
+     m_socket = 0;
+     m_connections.clear();
+     Application::DoDispose ();
+}
+
+void PollProbeServer::StartApplication (void) {
+     m_socket = Socket::CreateSocket (GetNode (), TcpSocketFactory::GetTypeId ());
+     m_socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_port));
+     m_socket->Listen ();
+     m_socket->SetAcceptCallback (
+          MakeCallback (&PollProbeServer::acceptRequest, this),
+          MakeCallback (&PollProbeServer::accept, this));
+}
+
+void PollProbeServer::StopApplication (void) {
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          m_connections[i]->Close ();
+     }
+     m_connections.clear();
+     m_received.clear();
+     if (m_socket != 0) {
+          m_socket->Close ();
+          m_socket = 0;
+     }
+}
+
+bool PollProbeServer::acceptRequest(Ptr<Socket> socket, Address const& from) {
+     return true;
+}
+
+void PollProbeServer::accept(Ptr<Socket> socket, Address const& from) {
+     socket->SetRecvCallback (MakeCallback (&PollProbeServer::receive, this));
+     m_connections.push_back(socket);
+     m_received.push_back(0);
+}
+
+// Function to answer every complete request
+void PollProbeServer::receive(Ptr<Socket> socket) {
+     size_t index = 0;
+     while (index < m_connections.size() && m_connections[index] != socket) {
+          ++index;
+     }
+     if (index == m_connections.size()) {
+          return;
+     }
+     Ptr<Packet> packet;
+     while ((packet = socket->Recv ())) {
+          if (packet->GetSize () == 0) {
+               break;
+          }
+          m_received[index] += packet->GetSize ();
+          while (m_received[index] >= m_requestSize) {
+               m_received[index] -= m_requestSize;
+               socket->Send (Create<Packet> (m_responseSize));
+          }
+     }
+}
+
+TypeId PollProbeClient::GetTypeId (void) {
+     static TypeId tid = TypeId ("PollProbeClient")
+          .SetParent<Application> ()
+          .AddConstructor<PollProbeClient> ()
+          .AddAttribute ("Port", "TCP port of the probe",
+                         UintegerValue (10104),
+                         MakeUintegerAccessor (&PollProbeClient::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("Cycle", "Poll cycle, also the deadline of a poll",
+                         TimeValue (Seconds (1.0)),
+                         MakeTimeAccessor (&PollProbeClient::m_cycle),
+                         MakeTimeChecker ())
+          .AddAttribute ("RequestSize", "Bytes of a poll request",
+                         UintegerValue (100),
+                         MakeUintegerAccessor (&PollProbeClient::m_requestSize),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("ResponseSize", "Bytes of a poll response",
+                         UintegerValue (1000),
+                         MakeUintegerAccessor (&PollProbeClient::m_responseSize),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+PollProbeClient::PollProbeClient() :
+     m_port(10104),
+     m_requestSize(100),
+     m_responseSize(1000),
+     m_polls(0),
+     m_missed(0) {
+}
+
+void PollProbeClient::addServer(Ipv4Address address) {
+     m_servers.push_back(address);
+}
+
+LatencyHistogram const& PollProbeClient::getCompletionTimes() const {
+     return m_completionTimes;
+}
+
+uint64_t PollProbeClient::getPolls() const {
+     return m_polls;
+}
+
+uint64_t PollProbeClient::getMissed() const {
+     return m_missed;
+}
+
+void PollProbeClient::DoDispose (void) {
+     m_connections.clear();
+     Application::DoDispose ();
+}
+
+// Function to connect to all servers, the first poll follows one cycle later
+void PollProbeClient::StartApplication (void) {
+     for (size_t i = 0; i < m_servers.size(); ++i) {
+          Poll poll;
+          poll.socket = Socket::CreateSocket (GetNode (), TcpSocketFactory::GetTypeId ());
+          poll.socket->Bind ();
+          poll.socket->Connect (InetSocketAddress (m_servers[i], m_port));
+          poll.socket->SetRecvCallback (MakeCallback (&PollProbeClient::receive, this));
+          poll.open = false;
+          poll.received = 0;
+          m_connections.push_back(poll);
+     }
+     m_pollEvent = Simulator::Schedule (m_cycle, &PollProbeClient::poll, this);
+}
+
+void PollProbeClient::StopApplication (void) {
+     m_pollEvent.Cancel ();
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          m_connections[i].socket->Close ();
+     }
+     m_connections.clear();
+}
+
+// Function to poll every server, a poll still open has missed its deadline
+void PollProbeClient::poll() {
+     Time now = Simulator::Now ();
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          Poll& poll = m_connections[i];
+          if (poll.open) {
+               ++m_missed;
+               continue;
+          }
+          poll.open = true;
+          poll.sent = now;
+          poll.received = 0;
+          poll.socket->Send (Create<Packet> (m_requestSize));
+          ++m_polls;
+     }
+     m_pollEvent = Simulator::Schedule (m_cycle, &PollProbeClient::poll, this);
+}
+
+void PollProbeClient::receive(Ptr<Socket> socket) {
+     size_t index = 0;
+     while (index < m_connections.size() && m_connections[index].socket != socket) {
+          ++index;
+     }
+     if (index == m_connections.size()) {
+          return;
+     }
+     Poll& poll = m_connections[index];
+     Ptr<Packet> packet;
+     while ((packet = socket->Recv ())) {
+          if (packet->GetSize () == 0) {
+               break;
+          }
+          poll.received += packet->GetSize ();
+     }
+     if (poll.open && poll.received >= m_responseSize) {
+          // a late response completes the missed poll, its time shows in the tail
+          m_completionTimes.add (Simulator::Now () - poll.sent);
+          poll.received -= m_responseSize;
+          poll.open = false;
+     }
+}
+
+PollProbeHelper::PollProbeHelper() :
+     m_servers(0) {
+     m_clientFactory.SetTypeId (PollProbeClient::GetTypeId ());
+     m_serverFactory.SetTypeId (PollProbeServer::GetTypeId ());
+}
+
+// Function to set an attribute (Cycle, RequestSize, ResponseSize, Port), the sizes and the port apply to both sides
+void PollProbeHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_clientFactory.Set (name, value);
+     if (name != "Cycle") {
+          m_serverFactory.Set (name, value);
+     }
+}
+
+void PollProbeHelper::install(NodeContainer const& servers, NodeContainer const& clients, Time start, Time stop) {
+     m_servers = servers.GetN ();
+     for (uint32_t i = 0; i < servers.GetN (); ++i) {
+          Ptr<PollProbeServer> server = m_serverFactory.Create<PollProbeServer> ();
+          servers.Get (i)->AddApplication (server);
+          server->SetStartTime (start);
+          server->SetStopTime (stop);
+     }
+     for (uint32_t i = 0; i < clients.GetN (); ++i) {
+          Ptr<PollProbeClient> client = m_clientFactory.Create<PollProbeClient> ();
+          for (uint32_t j = 0; j < servers.GetN (); ++j) {
+               if (servers.Get (j) != clients.Get (i)) {
+                    client->addServer(servers.Get (j)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+               }
+          }
+          clients.Get (i)->AddApplication (client);
+          client->SetStartTime (start + MilliSeconds (1));
+          client->SetStopTime (stop);
+          m_clients.push_back(client);
+     }
+}
+
+// Function to print the poll completion times per client
+void PollProbeHelper::report() {
+     cout << "Poll probe: " << m_servers << " servers" << endl;
+     cout << setw(8) << left << "node" << right << setw(10) << "polls" << setw(8) << "missed"
+          << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << endl;
+     cout << fixed << setprecision(3);
+     for (size_t i = 0; i < m_clients.size(); ++i) {
+          LatencyHistogram const& times = m_clients[i]->getCompletionTimes();
+          cout << setw(8) << left << m_clients[i]->GetNode ()->GetId () << right
+               << setw(10) << m_clients[i]->getPolls() << setw(8) << m_clients[i]->getMissed()
+               << setw(10) << times.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << times.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << times.getMax().GetSeconds () * 1000 << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the KPIs over all clients as "name=value" lines
+bool PollProbeHelper::writeKpi(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write KPI file " << fileName);
+          return false;
+     }
+     LatencyHistogram times;
+     uint64_t polls = 0;
+     uint64_t missed = 0;
+     for (size_t i = 0; i < m_clients.size(); ++i) {
+          times.merge(m_clients[i]->getCompletionTimes());
+          polls += m_clients[i]->getPolls();
+          missed += m_clients[i]->getMissed();
+     }
+     out << "servers=" << m_servers << endl;
+     out << "clients=" << m_clients.size() << endl;
+     out << "polls=" << polls << endl;
+     out << "completed=" << times.getCount() << endl;
+     out << "missed=" << missed << endl;
+     out << "missed_ratio=" << (polls + missed > 0 ? (double) missed / (polls + missed) : 0.0) << endl;
+     out << "p50_ms=" << times.getQuantile(0.5).GetSeconds () * 1000 << endl;
+     out << "p95_ms=" << times.getQuantile(0.95).GetSeconds () * 1000 << endl;
+     out << "p99_ms=" << times.getQuantile(0.99).GetSeconds () * 1000 << endl;
+     out << "max_ms=" << times.getMax().GetSeconds () * 1000 << endl;
+     out << "mean_ms=" << times.getMean().GetSeconds () * 1000 << endl;
+     return true;
+}
@@ -0,0 +1,103 @@
+#ifndef POLL_PROBE_H_
+#define POLL_PROBE_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <string>
+#include <vector>
+
+/**
+* Server side of the poll probe, answers every request of RequestSize bytes
+* with ResponseSize bytes, like a read of a data set over MMS.
+*/
+class PollProbeServer : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     PollProbeServer();
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     bool acceptRequest(ns3::Ptr<ns3::Socket> socket, ns3::Address const& from);
+     void accept(ns3::Ptr<ns3::Socket> socket, ns3::Address const& from);
+     void receive(ns3::Ptr<ns3::Socket> socket);
+
+     uint16_t m_port;
+     uint32_t m_requestSize;
+     uint32_t m_responseSize;
+     ns3::Ptr<ns3::Socket> m_socket;
+     std::vector<ns3::Ptr<ns3::Socket> > m_connections;
+     std::vector<uint32_t> m_received;
+};
+
+/**
+* Client side of the poll probe, polls all servers every Cycle and measures
+* the completion time of every poll (request sent to response received). A
+* poll still open at the next cycle misses its deadline and the server is
+* skipped in that cycle.
+*/
+class PollProbeClient : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     PollProbeClient();
+     void addServer(ns3::Ipv4Address address);
+
+     LatencyHistogram const& getCompletionTimes() const;
+     uint64_t getPolls() const;
+     uint64_t getMissed() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     struct Poll {
+          ns3::Ptr<ns3::Socket> socket;
+          bool open;
+          ns3::Time sent;
+          uint32_t received;
+     };
+
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void poll();
+     void receive(ns3::Ptr<ns3::Socket> socket);
+
+     uint16_t m_port;
+     ns3::Time m_cycle;
+     uint32_t m_requestSize;
+     uint32_t m_responseSize;
+     std::vector<ns3::Ipv4Address> m_servers;
+     std::vector<Poll> m_connections;
+     ns3::EventId m_pollEvent;
+     LatencyHistogram m_completionTimes;
+     uint64_t m_polls;
+     uint64_t m_missed;
+};
+
+/**
+* Installs a probe server on every server node and a probe client on every
+* client node, which polls all servers. The KPIs of all clients are written
+* as "name=value" lines for the capacity search.
+*/
+class PollProbeHelper {
+public:
+     PollProbeHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     void install(ns3::NodeContainer const& servers, ns3::NodeContainer const& clients,
+                  ns3::Time start, ns3::Time stop);
+     void report();
+     bool writeKpi(std::string const& fileName);
+
+private:
+     ns3::ObjectFactory m_clientFactory;
+     ns3::ObjectFactory m_serverFactory;
+     uint32_t m_servers;
+     std::vector<ns3::Ptr<PollProbeClient> > m_clients;
+};
+
+#endif /* POLL_PROBE_H_ */
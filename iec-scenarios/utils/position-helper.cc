@@ -0,0 +1,159 @@
+#include "position-helper.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("PositionHelper");
+
+// Function to get the IP-Address as string from a node
+void PositionHelper::setPosition(Ptr<Node> node, double x, double y) {
+     Ptr<MobilityModel> mobility = node->GetObject<MobilityModel>();
+     if (mobility != NULL) {
+          mobility->SetPosition(Vector(x, y, 0));
+     }
+}
+
+// Function to get the positions of n sites of a layout (hex, grid), empty for unknown layouts
+vector<Vector> PositionHelper::getLayout(string const& layout, uint32_t n, double distance) {
+     if (layout == "hex") {
+          return getHexLayout(n, distance);
+     } else if (layout == "grid") {
+          return getGridLayout(n, distance);
+     }
+     return vector<Vector>();
+}
+
+// Function to place n sites on hexagonal rings around the origin, ring k has 6k sites
+vector<Vector> PositionHelper::getHexLayout(uint32_t n, double distance) {
+     // axial coordinates of the six neighbours
+     static const int directions[6][2] = { { 1, 0 }, { 1, -1 }, { 0, -1 }, { -1, 0 }, { -1, 1 }, { 0, 1 } };
+     vector<Vector> positions;
+     if (n > 0) {
+          positions.push_back(Vector(0, 0, 0));
+     }
+     for (int ring = 1; positions.size() < n; ++ring) {
+          int q = -ring;
+          int r = ring;
+          for (uint32_t side = 0; side < 6 && positions.size() < n; ++side) {
+               for (int step = 0; step < ring && positions.size() < n; ++step) {
+                    positions.push_back(Vector(distance * (q + r / 2.0), distance * sqrt(3.0) / 2.0 * r, 0));
+                    q += directions[side][0];
+                    r += directions[side][1];
+               }
+          }
+     }
+     return positions;
+}
+
+// Function to place n sites row by row on a square grid around the origin
+vector<Vector> PositionHelper::getGridLayout(uint32_t n, double distance) {
+     uint32_t columns = (uint32_t) ceil(sqrt((double) n));
+     uint32_t rows = columns > 0 ? (n + columns - 1) / columns : 0;
+     vector<Vector> positions;
+     for (uint32_t i = 0; i < n; ++i) {
+          positions.push_back(Vector(distance * ((i % columns) - (columns - 1) / 2.0),
+                                     distance * ((i / columns) - (rows - 1) / 2.0), 0));
+     }
+     return positions;
+}
+
+// Function to place n nodes randomly, "cell" uniformly in a disc around the sites (round robin),
+// "uniform" uniformly in the bounding box of the sites extended by the radius
+vector<Vector> PositionHelper::getPlacement(string const& placement, uint32_t n,
+                                            vector<Vector> const& sites, double radius) {
+     vector<Vector> positions;
+     if (sites.empty()) {
+          return positions;
+     }
+     Ptr<UniformRandomVariable> uniform = CreateObject<UniformRandomVariable> ();
+     if (placement == "cell") {
+          for (uint32_t i = 0; i < n; ++i) {
+               Vector const& site = sites[i % sites.size()];
+               // the square root gives a uniform density over the disc
+               double distance = radius * sqrt(uniform->GetValue (0.0, 1.0));
+               double angle = uniform->GetValue (0.0, 2 * M_PI);
+               positions.push_back(Vector(site.x + distance * cos(angle), site.y + distance * sin(angle), 0));
+          }
+     } else if (placement == "uniform") {
+          double minX = sites[0].x, maxX = sites[0].x, minY = sites[0].y, maxY = sites[0].y;
+          for (size_t i = 1; i < sites.size(); ++i) {
+               minX = min(minX, sites[i].x);
+               maxX = max(maxX, sites[i].x);
+               minY = min(minY, sites[i].y);
+               maxY = max(maxY, sites[i].y);
+          }
+          for (uint32_t i = 0; i < n; ++i) {
+               positions.push_back(Vector(uniform->GetValue (minX - radius, maxX + radius),
+                                          uniform->GetValue (minY - radius, maxY + radius), 0));
+          }
+     }
+     return positions;
+}
+
+// Function to get the region of every position, the sector of its nearest site out of n equal sectors
+// around the center of the sites, a site in the center belongs to the first region
+vector<uint32_t> PositionHelper::getRegions(vector<Vector> const& positions, vector<Vector> const& sites, uint32_t n) {
+     vector<uint32_t> regions(positions.size(), 0);
+     if (sites.empty() || n <= 1) {
+          return regions;
+     }
+     double centerX = 0.0;
+     double centerY = 0.0;
+     for (size_t s = 0; s < sites.size(); ++s) {
+          centerX += sites[s].x / sites.size();
+          centerY += sites[s].y / sites.size();
+     }
+     vector<uint32_t> siteRegions(sites.size(), 0);
+     for (size_t s = 0; s < sites.size(); ++s) {
+          double dx = sites[s].x - centerX;
+          double dy = sites[s].y - centerY;
+          if (dx * dx + dy * dy < 1e-6) {
+               continue;
+          }
+          double angle = atan2(dy, dx);
+          if (angle < 0) {
+               angle += 2 * M_PI;
+          }
+          siteRegions[s] = min((uint32_t) (angle / (2 * M_PI / n)), n - 1);
+     }
+     for (size_t p = 0; p < positions.size(); ++p) {
+          size_t nearest = 0;
+          double nearestDistance = -1.0;
+          for (size_t s = 0; s < sites.size(); ++s) {
+               double dx = positions[p].x - sites[s].x;
+               double dy = positions[p].y - sites[s].y;
+               if (nearestDistance < 0 || dx * dx + dy * dy < nearestDistance) {
+                    nearest = s;
+                    nearestDistance = dx * dx + dy * dy;
+               }
+          }
+          regions[p] = siteRegions[nearest];
+     }
+     return regions;
+}
+
+// Function to read "x y" positions in m, one per line
+bool PositionHelper::readPositions(string const& fileName, vector<Vector>& positions) {
+     ifstream in(fileName.c_str());
+     if (!in.is_open()) {
+          NS_LOG_WARN ("Cannot open position file " << fileName);
+          return false;
+     }
+     string line;
+     while (getline(in, line)) {
+          if (line.empty() || line[0] == '#') {
+               continue;
+          }
+          istringstream fields(line);
+          double x, y;
+          if (fields >> x >> y) {
+               positions.push_back(Vector(x, y, 0));
+          }
+     }
+     return true;
+}
@@ -0,0 +1,30 @@
+#ifndef POSITION_HELPER_H_
+#define POSITION_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include <string>
+#include <vector>
+
+/**
+* Positions of nodes: site layouts of cellular networks (hexagonal rings
+* around the origin or a square grid with the inter site distance), random
+* placements around the sites and coordinates read from a file. Regions
+* split the sites into sectors around their center.
+*/
+class PositionHelper {
+public:
+     static void setPosition(ns3::Ptr<ns3::Node> node, double x, double y);
+     static std::vector<ns3::Vector> getLayout(std::string const& layout, uint32_t n, double distance);
+     static std::vector<ns3::Vector> getHexLayout(uint32_t n, double distance);
+     static std::vector<ns3::Vector> getGridLayout(uint32_t n, double distance);
+     static std::vector<ns3::Vector> getPlacement(std::string const& placement, uint32_t n,
+                                                  std::vector<ns3::Vector> const& sites, double radius);
+     static std::vector<uint32_t> getRegions(std::vector<ns3::Vector> const& positions,
+                                             std::vector<ns3::Vector> const& sites, uint32_t n);
+     static bool readPositions(std::string const& fileName, std::vector<ns3::Vector>& positions);
+};
+
+#endif /* POSITION_HELPER_H_ */
@@ -0,0 +1,93 @@
+#include "qos-helper.h"
+
+#include <cstdlib>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("QosHelper");
+
+QosHelper::QosHelper() {
+}
+
+// Function to get the traffic classes with the ports of their applications
+vector<QosHelper::TrafficClass> QosHelper::getClasses() {
+     vector<TrafficClass> classes(4);
+     classes[0].name = "mms";
+     classes[0].ports.push_back(10102);
+     classes[0].ports.push_back(10104);
+     classes[1].name = "reports";
+     classes[1].ports.push_back(10103);
+     classes[2].name = "goose";
+     classes[2].ports.push_back(102);
+     classes[2].ports.push_back(10107);
+     classes[3].name = "file";
+     classes[3].ports.push_back(10105);
+     return classes;
+}
+
+// Function to read the bearers of the classes, "class=qci[:kbps]" separated by commas
+void QosHelper::configure(string const& text) {
+     m_bearers.clear();
+     vector<TrafficClass> classes = getClasses();
+     istringstream entries(text);
+     string entry;
+     while (getline(entries, entry, ',')) {
+          size_t equal = entry.find('=');
+          NS_ABORT_MSG_IF (equal == string::npos, "Invalid bearer " << entry << ", expected class=qci[:kbps]");
+          string name = entry.substr(0, equal);
+          bool known = false;
+          for (size_t i = 0; i < classes.size(); ++i) {
+               known = known || classes[i].name == name;
+          }
+          NS_ABORT_MSG_UNLESS (known, "Unknown traffic class " << name << " (mms, reports, goose, file)");
+          string value = entry.substr(equal + 1);
+          size_t colon = value.find(':');
+          Bearer bearer;
+          uint32_t qci = atoi(value.substr(0, colon).c_str());
+          NS_ABORT_MSG_UNLESS (qci >= 1 && qci <= 9, "Invalid QCI in bearer " << entry);
+          bearer.qci = qci;
+          bearer.gbr = colon == string::npos ? 0 : (uint64_t) (atof(value.substr(colon + 1).c_str()) * 1000);
+          NS_ABORT_MSG_IF (qci <= 4 && bearer.gbr == 0, "GBR bearer " << entry << " needs a bit rate");
+          m_bearers[name] = bearer;
+     }
+}
+
+bool QosHelper::isEnabled() const {
+     return ! m_bearers.empty();
+}
+
+// Function to activate the dedicated bearers on all UEs, after they are attached
+void QosHelper::activate(Ptr<LteHelper> lteHelper, NetDeviceContainer const& ueDevs) const {
+     vector<TrafficClass> classes = getClasses();
+     for (size_t i = 0; i < classes.size(); ++i) {
+          map<string, Bearer>::const_iterator it = m_bearers.find(classes[i].name);
+          if (it == m_bearers.end()) {
+               continue;
+          }
+          Ptr<EpcTft> tft = Create<EpcTft> ();
+          for (size_t j = 0; j < classes[i].ports.size(); ++j) {
+               // the servers of a class listen on the UEs, the clients on the remote hosts
+               EpcTft::PacketFilter local;
+               local.localPortStart = classes[i].ports[j];
+               local.localPortEnd = classes[i].ports[j];
+               tft->Add (local);
+               EpcTft::PacketFilter remote;
+               remote.remotePortStart = classes[i].ports[j];
+               remote.remotePortEnd = classes[i].ports[j];
+               tft->Add (remote);
+          }
+          EpsBearer::Qci qci = (EpsBearer::Qci) it->second.qci;
+          GbrQosInformation gbr;
+          if (EpsBearer (qci).IsGbr ()) {
+               gbr.gbrUl = it->second.gbr;
+               gbr.gbrDl = it->second.gbr;
+               gbr.mbrUl = it->second.gbr;
+               gbr.mbrDl = it->second.gbr;
+          }
+          NS_LOG_INFO ("Activating " << classes[i].name << " bearer with QCI " << (uint32_t) it->second.qci
+                       << " (GBR " << gbr.gbrUl / 1000 << " kbps) on " << ueDevs.GetN () << " UEs.");
+          lteHelper->ActivateDedicatedEpsBearer (ueDevs, EpsBearer (qci, gbr), tft);
+     }
+}
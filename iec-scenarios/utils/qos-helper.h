@@ -0,0 +1,44 @@
+#ifndef QOS_HELPER_H_
+#define QOS_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/lte-module.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Maps the IEC traffic classes to dedicated EPS bearers of the UEs. A class
+* is identified by the default ports of its applications: mms (MMS and the
+* poll probe, TCP 10102 and 10104), reports (TCP 10103), goose (routable
+* GOOSE, UDP 102, and SV, UDP 10107) and file (file transfers, TCP 10105).
+*
+* The configuration "class=qci[:kbps],..." activates a bearer with the QCI
+* per listed class, whose TFT matches the ports as local or remote port in
+* both directions. GBR bearers (QCI 1-4) guarantee the kbps in uplink and
+* downlink. The other classes stay on the default bearer.
+*/
+class QosHelper {
+public:
+     struct TrafficClass {
+          std::string name;
+          std::vector<uint16_t> ports;
+     };
+
+     QosHelper();
+     void configure(std::string const& text);
+     bool isEnabled() const;
+     void activate(ns3::Ptr<ns3::LteHelper> lteHelper, ns3::NetDeviceContainer const& ueDevs) const;
+     static std::vector<TrafficClass> getClasses();
+
+private:
+     struct Bearer {
+          uint8_t qci;
+          uint64_t gbr;
+     };
+
+     std::map<std::string, Bearer> m_bearers;
+};
+
+#endif /* QOS_HELPER_H_ */
@@ -0,0 +1,491 @@
+#include "redundancy-helper.h"
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("RedundancyHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (RedundancyTrailer);
+NS_OBJECT_ENSURE_REGISTERED (RedundancyTag);
+NS_OBJECT_ENSURE_REGISTERED (DoublyAttachedNode);
+
+const uint16_t RedundancyTrailer::SUFFIX = 0x88FB;
+const uint32_t DuplicateTable::WINDOW = 128;
+
+// 0.0.0.0 is never the source of a node and marks the free slots
+static const uint32_t EMPTY = 0;
+
+TypeId RedundancyTrailer::GetTypeId (void) {
+     static TypeId tid = TypeId ("RedundancyTrailer")
+          .SetParent<Trailer> ()
+          .AddConstructor<RedundancyTrailer> ();
+     return tid;
+}
+
+RedundancyTrailer::RedundancyTrailer() :
+     sequence(0),
+     lan(0xA),
+     size(0),
+     suffix(SUFFIX) {
+}
+
+TypeId RedundancyTrailer::GetInstanceTypeId (void) const {
+     return GetTypeId ();
+}
+
+uint32_t RedundancyTrailer::GetSerializedSize (void) const {
+     return 6;
+}
+
+void RedundancyTrailer::Serialize (Buffer::Iterator start) const {
+     start.Prev (6);
+     start.WriteHtonU16 (sequence);
+     start.WriteHtonU16 ((uint16_t) (((lan & 0xf) << 12) | (size & 0xfff)));
+     start.WriteHtonU16 (suffix);
+}
+
+uint32_t RedundancyTrailer::Deserialize (Buffer::Iterator start) {
+     start.Prev (6);
+     sequence = start.ReadNtohU16 ();
+     uint16_t lanSize = start.ReadNtohU16 ();
+     lan = lanSize >> 12;
+     size = lanSize & 0xfff;
+     suffix = start.ReadNtohU16 ();
+     return 6;
+}
+
+void RedundancyTrailer::Print (ostream &os) const {
+     os << "sequence=" << sequence << " lan=" << hex << (uint32_t) lan << dec << " size=" << size;
+}
+
+TypeId RedundancyTag::GetTypeId (void) {
+     static TypeId tid = TypeId ("RedundancyTag")
+          .SetParent<Tag> ()
+          .AddConstructor<RedundancyTag> ();
+     return tid;
+}
+
+RedundancyTag::RedundancyTag() :
+     sendTime(0),
+     failure(0) {
+}
+
+TypeId RedundancyTag::GetInstanceTypeId (void) const {
+     return GetTypeId ();
+}
+
+uint32_t RedundancyTag::GetSerializedSize (void) const {
+     return 8 + 1;
+}
+
+void RedundancyTag::Serialize (TagBuffer i) const {
+     i.WriteU64 ((uint64_t) sendTime);
+     i.WriteU8 (failure);
+}
+
+void RedundancyTag::Deserialize (TagBuffer i) {
+     sendTime = (int64_t) i.ReadU64 ();
+     failure = i.ReadU8 ();
+}
+
+void RedundancyTag::Print (ostream &os) const {
+     os << "sendTime=" << sendTime << " failure=" << (uint32_t) failure;
+}
+
+DuplicateTable::DuplicateTable() :
+     m_sources(0) {
+     Window empty;
+     empty.source = EMPTY;
+     m_windows.assign(16, empty);
+}
+
+uint32_t DuplicateTable::getSources() const {
+     return m_sources;
+}
+
+// Function to get the slot of a source, the free slot where it belongs if unknown
+uint32_t DuplicateTable::getSlot(uint32_t source) const {
+     uint32_t mask = m_windows.size() - 1;
+     // multiplicative hashing, the table size is a power of two
+     uint32_t slot = (source * 2654435761u) & mask;
+     while (m_windows[slot].source != source && m_windows[slot].source != EMPTY) {
+          slot = (slot + 1) & mask;
+     }
+     return slot;
+}
+
+// Function to check whether a frame was seen before and to remember it otherwise
+bool DuplicateTable::isDuplicate(uint32_t source, uint16_t sequence) {
+     if (source == EMPTY) {
+          return false;
+     }
+     uint32_t slot = getSlot(source);
+     if (m_windows[slot].source == EMPTY) {
+          ++m_sources;
+          if (m_sources * 2 > m_windows.size()) {
+               vector<Window> old;
+               old.swap(m_windows);
+               Window empty;
+               empty.source = EMPTY;
+               m_windows.assign(old.size() * 2, empty);
+               for (size_t i = 0; i < old.size(); ++i) {
+                    if (old[i].source != EMPTY) {
+                         m_windows[getSlot(old[i].source)] = old[i];
+                    }
+               }
+               slot = getSlot(source);
+          }
+          Window& window = m_windows[slot];
+          window.source = source;
+          window.highest = sequence;
+          window.bits[0] = 1;
+          window.bits[1] = 0;
+          return false;
+     }
+     // bit n of the window is the sequence number n below the highest one
+     Window& window = m_windows[slot];
+     int16_t ahead = (int16_t) (sequence - window.highest);
+     if (ahead > 0) {
+          uint32_t shift = ahead;
+          if (shift >= WINDOW) {
+               window.bits[1] = 0;
+               window.bits[0] = 0;
+          } else if (shift >= 64) {
+               window.bits[1] = window.bits[0] << (shift - 64);
+               window.bits[0] = 0;
+          } else {
+               window.bits[1] = (window.bits[1] << shift) | (window.bits[0] >> (64 - shift));
+               window.bits[0] <<= shift;
+          }
+          window.bits[0] |= 1;
+          window.highest = sequence;
+          return false;
+     }
+     uint32_t age = - (int32_t) ahead;
+     if (age >= WINDOW) {
+          return false;
+     }
+     uint64_t bit = (uint64_t) 1 << (age % 64);
+     if (window.bits[age / 64] & bit) {
+          return true;
+     }
+     window.bits[age / 64] |= bit;
+     return false;
+}
+
+DoublyAttachedNode::Counters::Counters() :
+     discarded(0),
+     forwarded(0),
+     removed(0) {
+     sent[0] = sent[1] = 0;
+     received[0] = received[1] = 0;
+}
+
+TypeId DoublyAttachedNode::GetTypeId (void) {
+     static TypeId tid = TypeId ("DoublyAttachedNode")
+          .SetParent<Object> ()
+          .AddConstructor<DoublyAttachedNode> ()
+          .AddAttribute ("Mode", "prp (two LANs) or hsr (ring)",
+                         StringValue ("prp"),
+                         MakeStringAccessor (&DoublyAttachedNode::m_mode),
+                         MakeStringChecker ())
+          .AddAttribute ("Duplicate", "Send every frame over both ports, otherwise only over port A",
+                         BooleanValue (true),
+                         MakeBooleanAccessor (&DoublyAttachedNode::m_duplicate),
+                         MakeBooleanChecker ());
+     return tid;
+}
+
+DoublyAttachedNode::DoublyAttachedNode() :
+     m_mode("prp"),
+     m_duplicate(true),
+     m_failures(0),
+     m_sequence(0) {
+}
+
+void DoublyAttachedNode::DoDispose (void) {
+     m_device = 0;
+     m_ports[0] = 0;
+     m_ports[1] = 0;
+     Object::DoDispose ();
+}
+
+// Function to add the virtual device for the IP stack on top of the two ports of the node
+Ptr<NetDevice> DoublyAttachedNode::install(Ptr<Node> node, Ptr<NetDevice> portA, Ptr<NetDevice> portB) {
+     NS_ABORT_MSG_UNLESS (m_mode == "prp" || m_mode == "hsr", "Unknown redundancy mode " << m_mode << " (prp, hsr)");
+     m_ports[0] = portA;
+     m_ports[1] = portB;
+     m_device = CreateObject<VirtualNetDevice> ();
+     m_device->SetAddress (Mac48Address::Allocate ());
+     m_device->SetNeedsArp (false);
+     // room for the trailer in the MTU of the ports
+     m_device->SetAttribute ("Mtu", UintegerValue (portA->GetMtu () - RedundancyTrailer ().GetSerializedSize ()));
+     m_device->SetSendCallback (MakeCallback (&DoublyAttachedNode::send, this));
+     node->AddDevice (m_device);
+     for (uint32_t i = 0; i < 2; ++i) {
+          node->RegisterProtocolHandler (MakeCallback (&DoublyAttachedNode::receive, this), 0, m_ports[i], false);
+     }
+     return m_device;
+}
+
+// Function to set the address of the node, after the assignment to the virtual device
+void DoublyAttachedNode::setAddress(Ipv4Address address, Ipv4Mask mask) {
+     m_address = address;
+     m_mask = mask;
+}
+
+// Function to set the number of failed links the frames are tagged with
+void DoublyAttachedNode::setFailures(uint32_t const* failures) {
+     m_failures = failures;
+}
+
+DoublyAttachedNode::Counters const& DoublyAttachedNode::getCounters() const {
+     return m_counters;
+}
+
+uint32_t DoublyAttachedNode::getSources() const {
+     return m_duplicates.getSources();
+}
+
+bool DoublyAttachedNode::isUnicast(Ipv4Address address) const {
+     return ! address.IsBroadcast () && ! address.IsMulticast () && ! address.IsSubnetDirectedBroadcast (m_mask);
+}
+
+// Function to send a frame of the IP stack with the trailer over both ports
+bool DoublyAttachedNode::send(Ptr<Packet> packet, Address const& source, Address const& destination, uint16_t protocol) {
+     Ipv4Header header;
+     packet->PeekHeader (header);
+     RedundancyTag tag;
+     tag.sendTime = Simulator::Now ().GetNanoSeconds ();
+     tag.failure = m_failures != 0 && *m_failures > 0;
+     packet->AddByteTag (tag);
+     if (isUnicast(header.GetDestination ())) {
+          ++m_counters.sent[tag.failure];
+     }
+     RedundancyTrailer trailer;
+     trailer.sequence = m_sequence++;
+     trailer.size = packet->GetSize () + trailer.GetSerializedSize ();
+     bool sent = false;
+     for (uint32_t i = 0; i < (m_duplicate ? 2u : 1u); ++i) {
+          Ptr<Packet> copy = packet->Copy ();
+          trailer.lan = i == 0 ? 0xA : 0xB;
+          copy->AddTrailer (trailer);
+          sent = m_ports[i]->Send (copy, m_ports[i]->GetBroadcast (), protocol) || sent;
+     }
+     return sent;
+}
+
+// Function to forward a frame in the ring and to deliver its first copy to the IP stack
+void DoublyAttachedNode::receive(Ptr<NetDevice> device, Ptr<Packet const> packet, uint16_t protocol,
+                                 Address const& from, Address const& to, NetDevice::PacketType type) {
+     Ptr<Packet> copy = packet->Copy ();
+     RedundancyTrailer trailer;
+     copy->RemoveTrailer (trailer);
+     if (trailer.suffix != RedundancyTrailer::SUFFIX || protocol != Ipv4L3Protocol::PROT_NUMBER) {
+          // frame of a singly attached node
+          m_device->Receive (packet->Copy (), protocol, m_device->GetAddress (), m_device->GetAddress (), NetDevice::PACKET_HOST);
+          return;
+     }
+     Ipv4Header header;
+     copy->PeekHeader (header);
+     Ipv4Address destination = header.GetDestination ();
+     if (m_mode == "hsr") {
+          if (header.GetSource () == m_address) {
+               ++m_counters.removed;
+               return;
+          }
+          // a frame is forwarded only once, the copy from the other direction ends here
+          if (destination != m_address && m_forwarded.isDuplicate(header.GetSource ().Get (), trailer.sequence)) {
+               if (isUnicast(destination)) {
+                    ++m_counters.discarded;
+                    return;
+               }
+          } else if (destination != m_address) {
+               Ptr<NetDevice> other = m_ports[device == m_ports[0] ? 1 : 0];
+               other->Send (packet->Copy (), other->GetBroadcast (), protocol);
+               ++m_counters.forwarded;
+          }
+     }
+     // unicast frames of others: forwarded in the ring or flooded by a switch
+     if (destination != m_address && isUnicast(destination)) {
+          return;
+     }
+     if (m_duplicates.isDuplicate(header.GetSource ().Get (), trailer.sequence)) {
+          ++m_counters.discarded;
+          return;
+     }
+     RedundancyTag tag;
+     if (destination == m_address && copy->FindFirstMatchingByteTag (tag)) {
+          ++m_counters.received[tag.failure];
+          m_counters.delays[tag.failure].add(NanoSeconds (Simulator::Now ().GetNanoSeconds () - tag.sendTime));
+     }
+     m_device->Receive (copy, protocol, m_device->GetAddress (), m_device->GetAddress (), NetDevice::PACKET_HOST);
+}
+
+RedundancyHelper::Link::Link() :
+     failures(0) {
+}
+
+RedundancyHelper::RedundancyHelper() :
+     m_failures(0),
+     m_scheduled(0) {
+     m_factory.SetTypeId (DoublyAttachedNode::GetTypeId ());
+}
+
+// Function to set an attribute of the doubly attached nodes
+void RedundancyHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_factory.Set (name, value);
+}
+
+// Function to make a node doubly attached over two ports, returns the device for the IP stack
+Ptr<NetDevice> RedundancyHelper::install(Ptr<Node> node, Ptr<NetDevice> portA, Ptr<NetDevice> portB) {
+     Ptr<DoublyAttachedNode> attached = m_factory.Create<DoublyAttachedNode> ();
+     node->AggregateObject (attached);
+     attached->setFailures(&m_failures);
+     Ptr<NetDevice> device = attached->install(node, portA, portB);
+     m_nodes.push_back(attached);
+     m_devices.Add (device);
+     return device;
+}
+
+// Function to pass the assigned addresses to the nodes
+void RedundancyHelper::setAddresses(Ipv4Mask mask) {
+     for (uint32_t i = 0; i < m_devices.GetN (); ++i) {
+          Ptr<Ipv4> ipv4 = m_devices.Get (i)->GetNode ()->GetObject<Ipv4> ();
+          int32_t interface = ipv4->GetInterfaceForDevice (m_devices.Get (i));
+          NS_ABORT_MSG_IF (interface < 0, "No address on the redundant device of node " << m_devices.Get (i)->GetNode ()->GetId ());
+          m_nodes[i]->setAddress(ipv4->GetAddress (interface, 0).GetLocal (), mask);
+     }
+}
+
+// Function to name a link which can fail
+void RedundancyHelper::addLink(string const& name, NetDeviceContainer const& devices) {
+     m_links[name].devices = devices;
+}
+
+// Function to schedule the failures "link:start:duration" separated by commas
+void RedundancyHelper::scheduleFailures(string const& text) {
+     istringstream entries(text);
+     string entry;
+     while (getline(entries, entry, ',')) {
+          size_t first = entry.find(':');
+          size_t second = first == string::npos ? string::npos : entry.find(':', first + 1);
+          NS_ABORT_MSG_IF (second == string::npos, "Invalid link failure " << entry << ", expected link:start:duration");
+          string name = entry.substr(0, first);
+          map<string, Link>::iterator it = m_links.find(name);
+          NS_ABORT_MSG_IF (it == m_links.end(), "Unknown link " << name << " of the link failure " << entry);
+          double start = atof(entry.substr(first + 1, second - first - 1).c_str());
+          double duration = atof(entry.substr(second + 1).c_str());
+          NS_ABORT_MSG_UNLESS (duration > 0, "Invalid duration of the link failure " << entry);
+          if (it->second.errorModels.empty()) {
+               for (uint32_t i = 0; i < it->second.devices.GetN (); ++i) {
+                    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel> ();
+                    errorModel->SetUnit (RateErrorModel::ERROR_UNIT_PACKET);
+                    errorModel->SetRate (1.0);
+                    errorModel->Disable ();
+                    it->second.devices.Get (i)->SetAttribute ("ReceiveErrorModel", PointerValue (errorModel));
+                    it->second.errorModels.push_back(errorModel);
+               }
+          }
+          Simulator::Schedule (Seconds (start), &RedundancyHelper::setFailed, this, name, true);
+          Simulator::Schedule (Seconds (start + duration), &RedundancyHelper::setFailed, this, name, false);
+          ++m_scheduled;
+     }
+}
+
+// Function to fail or repair a link, every frame on it is dropped while at least one failure is active
+void RedundancyHelper::setFailed(string name, bool failed) {
+     Link& link = m_links[name];
+     if (failed) {
+          if (link.failures++ > 0) {
+               return;
+          }
+          ++m_failures;
+          NS_LOG_INFO ("Link " << name << " failed at " << Simulator::Now ().GetSeconds () << " s.");
+     } else {
+          if (--link.failures > 0) {
+               return;
+          }
+          --m_failures;
+          NS_LOG_INFO ("Link " << name << " repaired at " << Simulator::Now ().GetSeconds () << " s.");
+     }
+     for (size_t i = 0; i < link.errorModels.size(); ++i) {
+          if (failed) {
+               link.errorModels[i]->Enable ();
+          } else {
+               link.errorModels[i]->Disable ();
+          }
+     }
+}
+
+// Function to sum the counters of all nodes
+DoublyAttachedNode::Counters RedundancyHelper::getTotals() const {
+     DoublyAttachedNode::Counters totals;
+     for (size_t i = 0; i < m_nodes.size(); ++i) {
+          DoublyAttachedNode::Counters const& counters = m_nodes[i]->getCounters();
+          for (uint32_t f = 0; f < 2; ++f) {
+               totals.sent[f] += counters.sent[f];
+               totals.received[f] += counters.received[f];
+               totals.delays[f].merge(counters.delays[f]);
+          }
+          totals.discarded += counters.discarded;
+          totals.forwarded += counters.forwarded;
+          totals.removed += counters.removed;
+     }
+     return totals;
+}
+
+// Function to print the duplicates and the loss and latency of the unicast frames without and during failures
+void RedundancyHelper::report() const {
+     DoublyAttachedNode::Counters totals = getTotals();
+     cout << "Redundancy: " << m_nodes.size() << " nodes, " << m_scheduled << " link failures, "
+          << totals.discarded << " duplicates discarded, " << totals.forwarded << " forwarded, "
+          << totals.removed << " removed at the source" << endl;
+     cout << setw(10) << left << "phase" << right << setw(12) << "sent" << setw(12) << "received" << setw(10) << "loss"
+          << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << endl;
+     cout << fixed << setprecision(3);
+     const char* phases[2] = { "normal", "failure" };
+     for (uint32_t f = 0; f < 2; ++f) {
+          if (totals.sent[f] == 0) {
+               continue;
+          }
+          LatencyHistogram const& delays = totals.delays[f];
+          cout << setw(10) << left << phases[f] << right << setw(12) << totals.sent[f] << setw(12) << totals.received[f]
+               << setw(10) << 1.0 - (double) totals.received[f] / totals.sent[f]
+               << setw(10) << delays.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << delays.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the KPIs per phase as "phase_name=value" lines
+bool RedundancyHelper::writeKpi(string const& fileName) const {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write redundancy KPI file " << fileName);
+          return false;
+     }
+     DoublyAttachedNode::Counters totals = getTotals();
+     const char* phases[2] = { "normal", "failure" };
+     for (uint32_t f = 0; f < 2; ++f) {
+          LatencyHistogram const& delays = totals.delays[f];
+          string prefix = string(phases[f]) + "_";
+          out << prefix << "sent=" << totals.sent[f] << endl;
+          out << prefix << "received=" << totals.received[f] << endl;
+          out << prefix << "loss=" << (totals.sent[f] > 0 ? 1.0 - (double) totals.received[f] / totals.sent[f] : 0.0) << endl;
+          out << prefix << "p50_ms=" << delays.getQuantile(0.5).GetSeconds () * 1000 << endl;
+          out << prefix << "p99_ms=" << delays.getQuantile(0.99).GetSeconds () * 1000 << endl;
+          out << prefix << "max_ms=" << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     out << "duplicates_discarded=" << totals.discarded << endl;
+     out << "forwarded=" << totals.forwarded << endl;
+     return true;
+}
@@ -0,0 +1,175 @@
+#ifndef REDUNDANCY_HELPER_H_
+#define REDUNDANCY_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/virtual-net-device-module.h"
+#include "latency-histogram.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+* Redundancy control trailer (RCT) of PRP, 6 bytes: sequence number, LAN
+* (0xA, 0xB) and LSDU size, PRP suffix 0x88FB. HSR frames carry the same
+* fields in the HSR tag, modeled as trailer as well, so the IPv4 header
+* stays in front for the switches and the ring nodes.
+*/
+class RedundancyTrailer : public ns3::Trailer {
+public:
+     static const uint16_t SUFFIX;
+
+     static ns3::TypeId GetTypeId (void);
+     RedundancyTrailer();
+     virtual ns3::TypeId GetInstanceTypeId (void) const;
+     virtual uint32_t GetSerializedSize (void) const;
+     virtual void Serialize (ns3::Buffer::Iterator start) const;
+     virtual uint32_t Deserialize (ns3::Buffer::Iterator start);
+     virtual void Print (std::ostream &os) const;
+
+     uint16_t sequence;
+     uint8_t lan;
+     uint16_t size;
+     uint16_t suffix;
+};
+
+/**
+* Byte tag with the send time of a frame and whether a link had failed.
+*/
+class RedundancyTag : public ns3::Tag {
+public:
+     static ns3::TypeId GetTypeId (void);
+     RedundancyTag();
+     virtual ns3::TypeId GetInstanceTypeId (void) const;
+     virtual uint32_t GetSerializedSize (void) const;
+     virtual void Serialize (ns3::TagBuffer i) const;
+     virtual void Deserialize (ns3::TagBuffer i);
+     virtual void Print (std::ostream &os) const;
+
+     int64_t sendTime;
+     uint8_t failure;
+};
+
+/**
+* Duplicate discard of a node: per source a window over the last 128
+* sequence numbers as bitmap, found by open addressing. A check is O(1),
+* a few shifts and one bit test, independent of the number of sources.
+* Sequence numbers older than the window count as new (like the drop
+* window of IEC 62439-3, which forgets old entries).
+*/
+class DuplicateTable {
+public:
+     DuplicateTable();
+     bool isDuplicate(uint32_t source, uint16_t sequence);
+     uint32_t getSources() const;
+
+private:
+     struct Window {
+          uint32_t source;
+          uint16_t highest;
+          uint64_t bits[2];
+     };
+
+     static const uint32_t WINDOW;
+     uint32_t getSlot(uint32_t source) const;
+
+     std::vector<Window> m_windows;
+     uint32_t m_sources;
+};
+
+/**
+* Doubly attached node (DANP of PRP, DANH of HSR). The IP stack uses a
+* virtual device, every frame is sent with a trailer over both ports (only
+* port A if Duplicate is false) and the first copy of a frame is delivered,
+* the later ones are discarded. In HSR mode the ports are the links to the
+* neighbors in the ring: frames not only for the node are forwarded once on
+* the other port, a second table per source and sequence number stops the
+* copy coming from the other direction, frames back at their source are
+* removed.
+*
+* The send time of the frames is tagged, unicast frames to the node give
+* the latency and the loss, separately for frames sent while a link is
+* failed.
+*/
+class DoublyAttachedNode : public ns3::Object {
+public:
+     struct Counters {
+          Counters();
+          uint64_t sent[2];
+          uint64_t received[2];
+          LatencyHistogram delays[2];
+          uint64_t discarded;
+          uint64_t forwarded;
+          uint64_t removed;
+     };
+
+     static ns3::TypeId GetTypeId (void);
+     DoublyAttachedNode();
+     ns3::Ptr<ns3::NetDevice> install(ns3::Ptr<ns3::Node> node, ns3::Ptr<ns3::NetDevice> portA, ns3::Ptr<ns3::NetDevice> portB);
+     void setAddress(ns3::Ipv4Address address, ns3::Ipv4Mask mask);
+     void setFailures(uint32_t const* failures);
+     Counters const& getCounters() const;
+     uint32_t getSources() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     bool send(ns3::Ptr<ns3::Packet> packet, ns3::Address const& source, ns3::Address const& destination, uint16_t protocol);
+     void receive(ns3::Ptr<ns3::NetDevice> device, ns3::Ptr<ns3::Packet const> packet, uint16_t protocol,
+                  ns3::Address const& from, ns3::Address const& to, ns3::NetDevice::PacketType type);
+     bool isUnicast(ns3::Ipv4Address address) const;
+
+     std::string m_mode;
+     bool m_duplicate;
+     ns3::Ptr<ns3::VirtualNetDevice> m_device;
+     ns3::Ptr<ns3::NetDevice> m_ports[2];
+     ns3::Ipv4Address m_address;
+     ns3::Ipv4Mask m_mask;
+     uint32_t const* m_failures;
+     uint16_t m_sequence;
+     DuplicateTable m_duplicates;
+     DuplicateTable m_forwarded;
+     Counters m_counters;
+};
+
+/**
+* Installs the doubly attached nodes of a PRP or HSR topology, injects the
+* link failures "link:start:duration,..." (in s) of the named links by
+* error models dropping every frame on both ends, and reports the loss and
+* latency of the unicast frames sent without and during failures.
+*/
+class RedundancyHelper {
+public:
+     RedundancyHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     ns3::Ptr<ns3::NetDevice> install(ns3::Ptr<ns3::Node> node, ns3::Ptr<ns3::NetDevice> portA, ns3::Ptr<ns3::NetDevice> portB);
+     void setAddresses(ns3::Ipv4Mask mask);
+     void addLink(std::string const& name, ns3::NetDeviceContainer const& devices);
+     void scheduleFailures(std::string const& text);
+     void report() const;
+     bool writeKpi(std::string const& fileName) const;
+
+private:
+     struct Link {
+          Link();
+          ns3::NetDeviceContainer devices;
+          // active failures, overlapping intervals repair the link at the end of the last one
+          uint32_t failures;
+          std::vector<ns3::Ptr<ns3::RateErrorModel> > errorModels;
+     };
+
+     void setFailed(std::string name, bool failed);
+     DoublyAttachedNode::Counters getTotals() const;
+
+     ns3::ObjectFactory m_factory;
+     std::vector<ns3::Ptr<DoublyAttachedNode> > m_nodes;
+     ns3::NetDeviceContainer m_devices;
+     std::map<std::string, Link> m_links;
+     // failed links, read by the nodes when they send
+     uint32_t m_failures;
+     uint32_t m_scheduled;
+};
+
+#endif /* REDUNDANCY_HELPER_H_ */
@@ -0,0 +1,520 @@
+#include "report-helper.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("ReportHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (ReportHeader);
+NS_OBJECT_ENSURE_REGISTERED (ReportServer);
+NS_OBJECT_ENSURE_REGISTERED (ReportClient);
+
+TypeId ReportHeader::GetTypeId (void) {
+     static TypeId tid = TypeId ("ReportHeader")
+          .SetParent<Header> ()
+          .AddConstructor<ReportHeader> ();
+     return tid;
+}
+
+ReportHeader::ReportHeader() :
+     length(0),
+     server(0),
+     sqNum(0),
+     entries(0),
+     integrity(0),
+     firstChange(0),
+     sendTime(0) {
+}
+
+TypeId ReportHeader::GetInstanceTypeId (void) const {
+     return GetTypeId ();
+}
+
+uint32_t ReportHeader::GetSerializedSize (void) const {
+     return 4 + 4 + 4 + 2 + 1 + 8 + 8;
+}
+
+void ReportHeader::Serialize (Buffer::Iterator start) const {
+     start.WriteHtonU32 (length);
+     start.WriteHtonU32 (server);
+     start.WriteHtonU32 (sqNum);
+     start.WriteHtonU16 (entries);
+     start.WriteU8 (integrity);
+     start.WriteHtonU64 ((uint64_t) firstChange);
+     start.WriteHtonU64 ((uint64_t) sendTime);
+}
+
+uint32_t ReportHeader::Deserialize (Buffer::Iterator start) {
+     length = start.ReadNtohU32 ();
+     server = start.ReadNtohU32 ();
+     sqNum = start.ReadNtohU32 ();
+     entries = start.ReadNtohU16 ();
+     integrity = start.ReadU8 ();
+     firstChange = (int64_t) start.ReadNtohU64 ();
+     sendTime = (int64_t) start.ReadNtohU64 ();
+     return GetSerializedSize ();
+}
+
+void ReportHeader::Print (ostream &os) const {
+     os << "server=" << server << " sqNum=" << sqNum << " entries=" << entries
+        << (integrity ? " integrity" : "");
+}
+
+TypeId ReportServer::GetTypeId (void) {
+     static TypeId tid = TypeId ("ReportServer")
+          .SetParent<Application> ()
+          .AddConstructor<ReportServer> ()
+          .AddAttribute ("Port", "TCP port of the reports",
+                         UintegerValue (10103),
+                         MakeUintegerAccessor (&ReportServer::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("DataPoints", "Data points in the data set",
+                         UintegerValue (50),
+                         MakeUintegerAccessor (&ReportServer::m_dataPoints),
+                         MakeUintegerChecker<uint32_t> (1, 65535))
+          .AddAttribute ("EntrySize", "Bytes per data point in a report",
+                         UintegerValue (24),
+                         MakeUintegerAccessor (&ReportServer::m_entrySize),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("ChangeRate", "Mean data changes per second of the data set",
+                         DoubleValue (1.0),
+                         MakeDoubleAccessor (&ReportServer::m_changeRate),
+                         MakeDoubleChecker<double> (0.0))
+          .AddAttribute ("BufferTime", "Changes within this time are sent in one report",
+                         TimeValue (MilliSeconds (100)),
+                         MakeTimeAccessor (&ReportServer::m_bufferTime),
+                         MakeTimeChecker ())
+          .AddAttribute ("IntegrityPeriod", "Period of the integrity reports, 0 disables them",
+                         TimeValue (Seconds (10.0)),
+                         MakeTimeAccessor (&ReportServer::m_integrityPeriod),
+                         MakeTimeChecker ())
+          .AddAttribute ("Buffered", "Buffered (BRCB) or unbuffered (URCB) report control block",
+                         BooleanValue (true),
+                         MakeBooleanAccessor (&ReportServer::m_buffered),
+                         MakeBooleanChecker ())
+          .AddAttribute ("BufferSize", "Bytes of reports a BRCB queues per client",
+                         UintegerValue (65536),
+                         MakeUintegerAccessor (&ReportServer::m_bufferSize),
+                         MakeUintegerChecker<uint32_t> ())
+          .AddAttribute ("DisturbanceStart", "Simulation time of the disturbance",
+                         TimeValue (Seconds (0.0)),
+                         MakeTimeAccessor (&ReportServer::m_disturbanceStart),
+                         MakeTimeChecker ())
+          .AddAttribute ("DisturbanceDuration", "Duration of the disturbance, 0 disables it",
+                         TimeValue (Seconds (0.0)),
+                         MakeTimeAccessor (&ReportServer::m_disturbanceDuration),
+                         MakeTimeChecker ())
+          .AddAttribute ("DisturbanceFactor", "Change rate multiplier during the disturbance",
+                         DoubleValue (100.0),
+                         MakeDoubleAccessor (&ReportServer::m_disturbanceFactor),
+                         MakeDoubleChecker<double> (0.0));
+     return tid;
+}
+
+ReportServer::ReportServer() :
+     m_port(10103),
+     m_dataPoints(50),
+     m_entrySize(24),
+     m_changeRate(1.0),
+     m_buffered(true),
+     m_bufferSize(65536),
+     m_disturbanceFactor(100.0),
+     m_pending(0),
+     m_changes(0),
+     m_reports(0),
+     m_dropped(0) {
+     m_changeDelay = CreateObject<ExponentialRandomVariable> ();
+     m_dataPoint = CreateObject<UniformRandomVariable> ();
+}
+
+uint64_t ReportServer::getChanges() const {
+     return m_changes;
+}
+
+uint64_t ReportServer::getReports() const {
+     return m_reports;
+}
+
+uint64_t ReportServer::getDropped() const {
+     return m_dropped;
+}
+
+void ReportServer::DoDispose (void) {
+     m_socket = 0;
+     m_connections.clear();
+     Application::DoDispose ();
+}
+
+void ReportServer::StartApplication (void) {
+     m_socket = Socket::CreateSocket (GetNode (), TcpSocketFactory::GetTypeId ());
+     m_socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_port));
+     m_socket->Listen ();
+     m_socket->SetAcceptCallback (
+          MakeCallback (&ReportServer::acceptRequest, this),
+          MakeCallback (&ReportServer::accept, this));
+
+     m_changed.assign(m_dataPoints, false);
+     m_pending = 0;
+     scheduleChange();
+     if (! m_integrityPeriod.IsZero ()) {
+          m_integrityEvent = Simulator::Schedule (m_integrityPeriod, &ReportServer::sendIntegrity, this);
+     }
+     // the change rate switches at the start and the end of the disturbance
+     Time now = Simulator::Now ();
+     if (! m_disturbanceDuration.IsZero () && m_disturbanceStart >= now) {
+          Simulator::Schedule (m_disturbanceStart - now, &ReportServer::scheduleChange, this);
+          Simulator::Schedule (m_disturbanceStart + m_disturbanceDuration - now, &ReportServer::scheduleChange, this);
+     }
+}
+
+void ReportServer::StopApplication (void) {
+     m_changeEvent.Cancel ();
+     m_flushEvent.Cancel ();
+     m_integrityEvent.Cancel ();
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          m_connections[i].socket->Close ();
+     }
+     m_connections.clear();
+     if (m_socket != 0) {
+          m_socket->Close ();
+          m_socket = 0;
+     }
+}
+
+bool ReportServer::acceptRequest(Ptr<Socket> socket, Address const& from) {
+     return true;
+}
+
+// Function to enable the reports for a new client
+void ReportServer::accept(Ptr<Socket> socket, Address const& from) {
+     Connection connection;
+     connection.socket = socket;
+     connection.queued = 0;
+     connection.sqNum = 0;
+     m_connections.push_back(connection);
+     socket->SetSendCallback (MakeCallback (&ReportServer::drain, this));
+     socket->SetCloseCallbacks (
+          MakeCallback (&ReportServer::close, this),
+          MakeCallback (&ReportServer::close, this));
+}
+
+void ReportServer::close(Ptr<Socket> socket) {
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          if (m_connections[i].socket == socket) {
+               m_connections.erase(m_connections.begin() + i);
+               return;
+          }
+     }
+}
+
+// Function to send the queued reports of a BRCB when TCP accepts more data
+void ReportServer::drain(Ptr<Socket> socket, uint32_t available) {
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          if (m_connections[i].socket == socket) {
+               transmit(m_connections[i]);
+               return;
+          }
+     }
+}
+
+// Function to schedule the next data change with the rate of the current phase
+void ReportServer::scheduleChange() {
+     m_changeEvent.Cancel ();
+     Time now = Simulator::Now ();
+     double rate = m_changeRate;
+     if (! m_disturbanceDuration.IsZero () && now >= m_disturbanceStart
+         && now < m_disturbanceStart + m_disturbanceDuration) {
+          rate *= m_disturbanceFactor;
+     }
+     if (rate > 0.0) {
+          m_changeEvent = Simulator::Schedule (Seconds (m_changeDelay->GetValue (1.0 / rate, 0)),
+                                               &ReportServer::changeData, this);
+     }
+}
+
+// Function to change a random data point, the first change starts the buffer time
+void ReportServer::changeData() {
+     ++m_changes;
+     uint32_t index = m_dataPoint->GetInteger (0, m_dataPoints - 1);
+     bool first = m_pending == 0;
+     if (! m_changed[index]) {
+          m_changed[index] = true;
+          ++m_pending;
+     }
+     if (first) {
+          m_firstChange = Simulator::Now ();
+          m_flushEvent = Simulator::Schedule (m_bufferTime, &ReportServer::flush, this);
+     }
+     scheduleChange();
+}
+
+// Function to send the changes of the buffer time as one report
+void ReportServer::flush() {
+     send(m_pending, false, m_firstChange);
+     m_changed.assign(m_dataPoints, false);
+     m_pending = 0;
+}
+
+void ReportServer::sendIntegrity() {
+     send(m_dataPoints, true, Simulator::Now ());
+     m_integrityEvent = Simulator::Schedule (m_integrityPeriod, &ReportServer::sendIntegrity, this);
+}
+
+// Function to send a report to every client, every client has its own sqNum
+void ReportServer::send(uint16_t entries, bool integrity, Time firstChange) {
+     ++m_reports;
+     ReportHeader header;
+     header.server = GetNode ()->GetId ();
+     header.entries = entries;
+     header.integrity = integrity ? 1 : 0;
+     header.firstChange = firstChange.GetNanoSeconds ();
+     header.sendTime = Simulator::Now ().GetNanoSeconds ();
+     header.length = header.GetSerializedSize () + entries * m_entrySize;
+     for (size_t i = 0; i < m_connections.size(); ++i) {
+          Connection& connection = m_connections[i];
+          header.sqNum = ++connection.sqNum;
+          Ptr<Packet> packet = Create<Packet> (entries * m_entrySize);
+          packet->AddHeader (header);
+          if (m_buffered) {
+               connection.queue.push_back(packet);
+               connection.queued += packet->GetSize ();
+               while (connection.queued > m_bufferSize) {
+                    connection.queued -= connection.queue.front()->GetSize ();
+                    connection.queue.pop_front();
+                    ++m_dropped;
+               }
+               transmit(connection);
+          } else if (connection.socket->GetTxAvailable () >= packet->GetSize ()) {
+               connection.socket->Send (packet);
+          } else {
+               ++m_dropped;
+          }
+     }
+}
+
+// Function to hand the queued reports to TCP as long as they fit into the send buffer
+void ReportServer::transmit(Connection& connection) {
+     while (! connection.queue.empty()
+            && connection.socket->GetTxAvailable () >= connection.queue.front()->GetSize ()) {
+          Ptr<Packet> packet = connection.queue.front();
+          connection.queue.pop_front();
+          connection.queued -= packet->GetSize ();
+          connection.socket->Send (packet);
+     }
+}
+
+TypeId ReportClient::GetTypeId (void) {
+     static TypeId tid = TypeId ("ReportClient")
+          .SetParent<Application> ()
+          .AddConstructor<ReportClient> ()
+          .AddAttribute ("Port", "TCP port of the reports",
+                         UintegerValue (10103),
+                         MakeUintegerAccessor (&ReportClient::m_port),
+                         MakeUintegerChecker<uint16_t> ());
+     return tid;
+}
+
+ReportClient::ReportClient() :
+     m_port(10103),
+     m_reports(0),
+     m_integrityReports(0),
+     m_entries(0),
+     m_bytes(0),
+     m_second(-1),
+     m_secondBytes(0),
+     m_peakBytes(0),
+     m_lost(0) {
+}
+
+void ReportClient::addServer(Ipv4Address address) {
+     m_servers.push_back(address);
+}
+
+LatencyHistogram const& ReportClient::getDelays() const {
+     return m_delays;
+}
+
+uint64_t ReportClient::getReports() const {
+     return m_reports;
+}
+
+uint64_t ReportClient::getIntegrityReports() const {
+     return m_integrityReports;
+}
+
+uint64_t ReportClient::getEntries() const {
+     return m_entries;
+}
+
+uint64_t ReportClient::getBytes() const {
+     return m_bytes;
+}
+
+uint64_t ReportClient::getPeakBytes() const {
+     return m_peakBytes;
+}
+
+uint64_t ReportClient::getLost() const {
+     return m_lost;
+}
+
+void ReportClient::DoDispose (void) {
+     m_sockets.clear();
+     m_pending.clear();
+     Application::DoDispose ();
+}
+
+// Function to connect to every server, the connection enables its reports
+void ReportClient::StartApplication (void) {
+     for (size_t i = 0; i < m_servers.size(); ++i) {
+          Ptr<Socket> socket = Socket::CreateSocket (GetNode (), TcpSocketFactory::GetTypeId ());
+          socket->Bind ();
+          socket->Connect (InetSocketAddress (m_servers[i], m_port));
+          socket->SetRecvCallback (MakeCallback (&ReportClient::receive, this));
+          m_sockets.push_back(socket);
+          m_pending[socket] = Create<Packet> ();
+     }
+}
+
+void ReportClient::StopApplication (void) {
+     for (size_t i = 0; i < m_sockets.size(); ++i) {
+          m_sockets[i]->Close ();
+     }
+     m_sockets.clear();
+     m_pending.clear();
+}
+
+// Function to split the TCP stream into reports
+void ReportClient::receive(Ptr<Socket> socket) {
+     Ptr<Packet>& pending = m_pending[socket];
+     Ptr<Packet> packet;
+     while ((packet = socket->Recv ())) {
+          if (packet->GetSize () == 0) {
+               break;
+          }
+          pending->AddAtEnd (packet);
+     }
+     ReportHeader header;
+     while (pending->GetSize () >= header.GetSerializedSize ()) {
+          pending->PeekHeader (header);
+          if (pending->GetSize () < header.length) {
+               break;
+          }
+          pending->RemoveAtStart (header.length);
+          handleReport(header);
+     }
+}
+
+void ReportClient::handleReport(ReportHeader const& header) {
+     Time now = Simulator::Now ();
+     ++m_reports;
+     m_entries += header.entries;
+     m_bytes += header.length;
+     int64_t second = (int64_t) now.GetSeconds ();
+     if (second != m_second) {
+          m_second = second;
+          m_secondBytes = 0;
+     }
+     m_secondBytes += header.length;
+     m_peakBytes = max(m_peakBytes, m_secondBytes);
+
+     if (header.integrity) {
+          ++m_integrityReports;
+     } else {
+          m_delays.add (now - NanoSeconds (header.firstChange));
+     }
+     map<uint32_t, uint32_t>::iterator last = m_lastSqNum.find(header.server);
+     if (last != m_lastSqNum.end() && header.sqNum > last->second + 1) {
+          m_lost += header.sqNum - last->second - 1;
+     }
+     m_lastSqNum[header.server] = header.sqNum;
+}
+
+ReportHelper::ReportHelper() {
+     m_serverFactory.SetTypeId (ReportServer::GetTypeId ());
+}
+
+// Function to set an attribute of the servers (ChangeRate, BufferTime, IntegrityPeriod, Buffered, ...)
+void ReportHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_serverFactory.Set (name, value);
+}
+
+// Function to install the servers and the clients, the servers start listening first
+void ReportHelper::install(NodeContainer const& servers, NodeContainer const& clients, Time start, Time stop) {
+     m_start = start;
+     m_stop = stop;
+     for (uint32_t i = 0; i < servers.GetN (); ++i) {
+          Ptr<ReportServer> server = m_serverFactory.Create<ReportServer> ();
+          servers.Get (i)->AddApplication (server);
+          server->SetStartTime (start);
+          server->SetStopTime (stop);
+          m_servers.push_back(server);
+     }
+     for (uint32_t i = 0; i < clients.GetN (); ++i) {
+          Ptr<ReportClient> client = CreateObject<ReportClient> ();
+          for (uint32_t j = 0; j < servers.GetN (); ++j) {
+               if (servers.Get (j) != clients.Get (i)) {
+                    client->addServer(servers.Get (j)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+               }
+          }
+          clients.Get (i)->AddApplication (client);
+          client->SetStartTime (start + MilliSeconds (1));
+          client->SetStopTime (stop);
+          m_clients.push_back(client);
+     }
+}
+
+// Function to print the report delays and the throughput per client
+void ReportHelper::report() {
+     uint64_t changes = 0;
+     uint64_t reports = 0;
+     uint64_t dropped = 0;
+     for (size_t i = 0; i < m_servers.size(); ++i) {
+          changes += m_servers[i]->getChanges();
+          reports += m_servers[i]->getReports();
+          dropped += m_servers[i]->getDropped();
+     }
+     double seconds = (m_stop - m_start).GetSeconds ();
+     cout << "Reports: " << m_servers.size() << " servers, " << changes << " data changes, "
+          << reports << " reports, " << dropped << " dropped" << endl;
+     cout << setw(8) << left << "node" << right << setw(10) << "reports" << setw(10) << "integrity"
+          << setw(10) << "entries" << setw(6) << "lost" << setw(12) << "avg [kb/s]" << setw(12) << "peak [kb/s]"
+          << setw(10) << "p50 [ms]" << setw(10) << "p99 [ms]" << setw(10) << "max [ms]" << endl;
+     cout << fixed;
+     for (size_t i = 0; i < m_clients.size(); ++i) {
+          Ptr<ReportClient> client = m_clients[i];
+          LatencyHistogram const& delays = client->getDelays();
+          cout << setw(8) << left << client->GetNode ()->GetId () << right
+               << setw(10) << client->getReports() << setw(10) << client->getIntegrityReports()
+               << setw(10) << client->getEntries() << setw(6) << client->getLost() << setprecision(1)
+               << setw(12) << (seconds > 0 ? client->getBytes() * 8 / seconds / 1000 : 0)
+               << setw(12) << client->getPeakBytes() * 8 / 1000.0 << setprecision(3)
+               << setw(10) << delays.getQuantile(0.5).GetSeconds () * 1000
+               << setw(10) << delays.getQuantile(0.99).GetSeconds () * 1000
+               << setw(10) << delays.getMax().GetSeconds () * 1000 << endl;
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the report delay histograms of all clients as CSV
+bool ReportHelper::writeCsv(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write report file " << fileName);
+          return false;
+     }
+     out << "node,upper_us,count" << endl;
+     for (size_t i = 0; i < m_clients.size(); ++i) {
+          ostringstream node;
+          node << m_clients[i]->GetNode ()->GetId ();
+          m_clients[i]->getDelays().writeCsv(out, node.str());
+     }
+     return true;
+}
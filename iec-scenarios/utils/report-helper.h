@@ -0,0 +1,173 @@
+#ifndef REPORT_HELPER_H_
+#define REPORT_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+
+/**
+* Header of a report on the TCP stream. length is the size of the report
+* including the header, the entries follow as payload. firstChange is the
+* time of the oldest data change in the report (the send time for integrity
+* reports).
+*/
+class ReportHeader : public ns3::Header {
+public:
+     static ns3::TypeId GetTypeId (void);
+     ReportHeader();
+     virtual ns3::TypeId GetInstanceTypeId (void) const;
+     virtual uint32_t GetSerializedSize (void) const;
+     virtual void Serialize (ns3::Buffer::Iterator start) const;
+     virtual uint32_t Deserialize (ns3::Buffer::Iterator start);
+     virtual void Print (std::ostream &os) const;
+
+     uint32_t length;
+     uint32_t server;
+     uint32_t sqNum;
+     uint16_t entries;
+     uint8_t integrity;
+     int64_t firstChange;
+     int64_t sendTime;
+};
+
+/**
+* Report control block of a server. Every data point of the data set changes
+* as Poisson process, the changes within BufferTime are sent as one report
+* with an entry per changed data point. An integrity report with all data
+* points is sent every IntegrityPeriod. During the disturbance the change
+* rate is multiplied by DisturbanceFactor.
+*
+* A buffered control block (BRCB) queues the reports per client while TCP
+* does not accept them, up to BufferSize bytes, dropping the oldest. An
+* unbuffered one (URCB) drops the reports which do not fit.
+*/
+class ReportServer : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     ReportServer();
+     uint64_t getChanges() const;
+     uint64_t getReports() const;
+     uint64_t getDropped() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     struct Connection {
+          ns3::Ptr<ns3::Socket> socket;
+          std::deque<ns3::Ptr<ns3::Packet> > queue;
+          uint32_t queued;
+          uint32_t sqNum;
+     };
+
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     bool acceptRequest(ns3::Ptr<ns3::Socket> socket, ns3::Address const& from);
+     void accept(ns3::Ptr<ns3::Socket> socket, ns3::Address const& from);
+     void close(ns3::Ptr<ns3::Socket> socket);
+     void drain(ns3::Ptr<ns3::Socket> socket, uint32_t available);
+     void scheduleChange();
+     void changeData();
+     void flush();
+     void sendIntegrity();
+     void send(uint16_t entries, bool integrity, ns3::Time firstChange);
+     void transmit(Connection& connection);
+
+     uint16_t m_port;
+     uint32_t m_dataPoints;
+     uint32_t m_entrySize;
+     double m_changeRate;
+     ns3::Time m_bufferTime;
+     ns3::Time m_integrityPeriod;
+     bool m_buffered;
+     uint32_t m_bufferSize;
+     ns3::Time m_disturbanceStart;
+     ns3::Time m_disturbanceDuration;
+     double m_disturbanceFactor;
+     ns3::Ptr<ns3::ExponentialRandomVariable> m_changeDelay;
+     ns3::Ptr<ns3::UniformRandomVariable> m_dataPoint;
+
+     ns3::Ptr<ns3::Socket> m_socket;
+     std::vector<Connection> m_connections;
+     std::vector<bool> m_changed;
+     uint16_t m_pending;
+     ns3::Time m_firstChange;
+     ns3::EventId m_changeEvent;
+     ns3::EventId m_flushEvent;
+     ns3::EventId m_integrityEvent;
+     uint64_t m_changes;
+     uint64_t m_reports;
+     uint64_t m_dropped;
+};
+
+/**
+* SCADA client enabling the reports of its servers, measures the delay from
+* the data change to the reception, the lost reports (gaps of sqNum) and
+* the throughput, including the peak of one second.
+*/
+class ReportClient : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     ReportClient();
+     void addServer(ns3::Ipv4Address address);
+
+     LatencyHistogram const& getDelays() const;
+     uint64_t getReports() const;
+     uint64_t getIntegrityReports() const;
+     uint64_t getEntries() const;
+     uint64_t getBytes() const;
+     uint64_t getPeakBytes() const;
+     uint64_t getLost() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void receive(ns3::Ptr<ns3::Socket> socket);
+     void handleReport(ReportHeader const& header);
+
+     uint16_t m_port;
+     std::vector<ns3::Ipv4Address> m_servers;
+     std::vector<ns3::Ptr<ns3::Socket> > m_sockets;
+     std::map<ns3::Ptr<ns3::Socket>, ns3::Ptr<ns3::Packet> > m_pending;
+     std::map<uint32_t, uint32_t> m_lastSqNum;
+     LatencyHistogram m_delays;
+     uint64_t m_reports;
+     uint64_t m_integrityReports;
+     uint64_t m_entries;
+     uint64_t m_bytes;
+     int64_t m_second;
+     uint64_t m_secondBytes;
+     uint64_t m_peakBytes;
+     uint64_t m_lost;
+};
+
+/**
+* Installs a report server on every server node and a client on every
+* client node, which enables the reports of all servers.
+*/
+class ReportHelper {
+public:
+     ReportHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     void install(ns3::NodeContainer const& servers, ns3::NodeContainer const& clients,
+                  ns3::Time start, ns3::Time stop);
+     void report();
+     bool writeCsv(std::string const& fileName);
+
+private:
+     ns3::ObjectFactory m_serverFactory;
+     ns3::Time m_start;
+     ns3::Time m_stop;
+     std::vector<ns3::Ptr<ReportServer> > m_servers;
+     std::vector<ns3::Ptr<ReportClient> > m_clients;
+};
+
+#endif /* REPORT_HELPER_H_ */
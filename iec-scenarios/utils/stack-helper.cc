@@ -0,0 +1,205 @@
+#include "stack-helper.h"
+
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("StackHelper");
+
+// Distance between the tag sizes of two binaries in pages
+static const uint32_t TAG_PAGES = 4;
+// Minimum stack size in pages recommended by a profile
+static const uint32_t MIN_PAGES = 16;
+
+StackHelper::StackHelper() :
+     m_mode("fixed"),
+     m_defaultStackSize(1<<20),
+     m_pageSize(sysconf(_SC_PAGESIZE)) {
+}
+
+// Function to set the mode (fixed, measure or profile)
+void StackHelper::setMode(string const& mode) {
+     NS_ABORT_MSG_UNLESS (mode == "fixed" || mode == "measure" || mode == "profile",
+          "Unknown stack mode " << mode);
+     m_mode = mode;
+}
+
+// Function to set the stack size used for unknown binaries
+void StackHelper::setDefaultStackSize(uint32_t size) {
+     m_defaultStackSize = size;
+}
+
+// Function to read a profile with lines of the form "<binary> <bytes>"
+bool StackHelper::loadProfile(string const& fileName) {
+     ifstream in(fileName.c_str());
+     if (!in.is_open()) {
+          NS_LOG_WARN ("Cannot open stack profile " << fileName);
+          return false;
+     }
+     string line;
+     while (getline(in, line)) {
+          if (line.empty() || line[0] == '#') {
+               continue;
+          }
+          istringstream fields(line);
+          string binary;
+          uint32_t size;
+          if (fields >> binary >> size) {
+               m_profile[binary] = size;
+          }
+     }
+     return true;
+}
+
+// Function to write the recommended stack sizes of the measured binaries
+bool StackHelper::saveProfile(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write stack profile " << fileName);
+          return false;
+     }
+     out << "# binary stack-size-in-bytes" << endl;
+     for (map<string, Usage>::const_iterator it = m_usage.begin(); it != m_usage.end(); ++it) {
+          if (it->second.highWater == 0) {
+               // without a sample the binary keeps the default stack size in profile mode
+               NS_LOG_WARN ("No stack samples of " << it->first << ", it is left out of the profile");
+               continue;
+          }
+          uint64_t size = it->second.highWater * 2;
+          uint64_t pages = (size + m_pageSize - 1) / m_pageSize;
+          if (pages < MIN_PAGES) {
+               pages = MIN_PAGES;
+          }
+          out << it->first << " " << pages * m_pageSize << endl;
+     }
+     return true;
+}
+
+// Function to get the stack size of a binary for the current mode
+uint32_t StackHelper::getStackSize(string const& binary) {
+     if (m_mode == "measure") {
+          return tagSize(binary);
+     }
+     if (m_mode == "profile") {
+          map<string, uint32_t>::const_iterator it = m_profile.find(binary);
+          if (it != m_profile.end()) {
+               return it->second;
+          }
+     }
+     return m_defaultStackSize;
+}
+
+// Function to set the stack size of a binary on the application helper
+void StackHelper::apply(DceApplicationHelper& dce, string const& binary) {
+     uint32_t size = getStackSize(binary);
+     if (m_usage.find(binary) == m_usage.end()) {
+          Usage usage = { size, 0, 0 };
+          m_usage[binary] = usage;
+     }
+     dce.SetStackSize (size);
+}
+
+// Function to sample the stacks periodically until the given time
+void StackHelper::scheduleSampling(Time interval, Time stop) {
+     if (m_mode != "measure") {
+          return;
+     }
+     Simulator::Schedule (interval, &StackHelper::sampleAndReschedule, this, interval, stop);
+}
+
+void StackHelper::sampleAndReschedule(Time interval, Time stop) {
+     sample();
+     if (Simulator::Now () + interval < stop) {
+          Simulator::Schedule (interval, &StackHelper::sampleAndReschedule, this, interval, stop);
+     }
+}
+
+// Function to update the high-water marks from the resident stack pages
+void StackHelper::sample() {
+     if (m_mode != "measure") {
+          return;
+     }
+     ifstream smaps("/proc/self/smaps");
+     if (!smaps.is_open()) {
+          NS_LOG_WARN ("Cannot open /proc/self/smaps, stack usage is not measured");
+          return;
+     }
+     map<string, uint32_t> stacks;
+     uint64_t mappingSize = 0;
+     bool anonymous = false;
+     string line;
+     while (getline(smaps, line)) {
+          istringstream fields(line);
+          string first;
+          fields >> first;
+          size_t dash = first.find('-');
+          if (dash != string::npos && first[first.size()-1] != ':') {
+               // header line of a mapping: "start-end perms offset dev inode [path]"
+               uint64_t start = strtoull(first.substr(0, dash).c_str(), NULL, 16);
+               uint64_t end = strtoull(first.substr(dash + 1).c_str(), NULL, 16);
+               string perms, offset, dev, inode, path;
+               fields >> perms >> offset >> dev >> inode >> path;
+               mappingSize = end - start;
+               anonymous = path.empty() && perms.compare(0, 2, "rw") == 0;
+               continue;
+          }
+          if (first != "Rss:" || !anonymous) {
+               continue;
+          }
+          uint64_t rss;
+          fields >> rss;
+          rss *= 1024;
+          for (map<string, Usage>::iterator it = m_usage.begin(); it != m_usage.end(); ++it) {
+               uint64_t size = it->second.stackSize;
+               // the guard page may or may not be part of the mapping
+               if (mappingSize + m_pageSize >= size && mappingSize <= size + m_pageSize) {
+                    if (rss > it->second.highWater) {
+                         it->second.highWater = rss;
+                    }
+                    ++stacks[it->first];
+                    break;
+               }
+          }
+     }
+     for (map<string, uint32_t>::const_iterator it = stacks.begin(); it != stacks.end(); ++it) {
+          if (it->second > m_usage[it->first].stacks) {
+               m_usage[it->first].stacks = it->second;
+          }
+     }
+}
+
+// Function to print the stack usage of every binary
+void StackHelper::report() {
+     if (m_mode == "fixed") {
+          return;
+     }
+     sample();
+     cout << "Stack usage (" << m_mode << ")" << endl;
+     cout << setw(32) << left << "binary" << setw(12) << right << "stack"
+          << setw(10) << "stacks" << setw(14) << "high-water" << endl;
+     for (map<string, Usage>::const_iterator it = m_usage.begin(); it != m_usage.end(); ++it) {
+          cout << setw(32) << left << it->first << setw(12) << right << it->second.stackSize
+               << setw(10) << it->second.stacks;
+          if (m_mode == "measure") {
+               cout << setw(14) << it->second.highWater;
+          } else {
+               cout << setw(14) << "-";
+          }
+          cout << endl;
+     }
+}
+
+// Function to get a stack size which identifies the binary in the mappings
+uint32_t StackHelper::tagSize(string const& binary) {
+     map<string, Usage>::const_iterator it = m_usage.find(binary);
+     if (it != m_usage.end()) {
+          return it->second.stackSize;
+     }
+     return m_defaultStackSize + m_usage.size() * TAG_PAGES * m_pageSize;
+}
@@ -0,0 +1,52 @@
+#ifndef STACK_HELPER_H_
+#define STACK_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/dce-module.h"
+#include <string>
+#include <map>
+
+/**
+* Sizes the stacks of the DCE processes per binary.
+*
+* Modes:
+*  fixed   - every binary gets the default stack size (old behaviour).
+*  measure - every binary gets the default size plus a small, binary specific
+*            offset. The anonymous mappings in /proc/self/smaps are matched by
+*            this size and their resident pages are taken as high-water mark.
+*            The fiber stacks are mapped lazily, so only touched pages are
+*            resident.
+*  profile - the stack size of a binary is read from a profile file written
+*            by a previous measure run.
+*/
+class StackHelper {
+public:
+     StackHelper();
+     void setMode(std::string const& mode);
+     void setDefaultStackSize(uint32_t size);
+     bool loadProfile(std::string const& fileName);
+     bool saveProfile(std::string const& fileName);
+     uint32_t getStackSize(std::string const& binary);
+     void apply(ns3::DceApplicationHelper& dce, std::string const& binary);
+     void scheduleSampling(ns3::Time interval, ns3::Time stop);
+     void sample();
+     void report();
+
+private:
+     struct Usage {
+          uint32_t stackSize;
+          uint64_t highWater;
+          uint32_t stacks;
+     };
+
+     uint32_t tagSize(std::string const& binary);
+     void sampleAndReschedule(ns3::Time interval, ns3::Time stop);
+
+     std::string m_mode;
+     uint32_t m_defaultStackSize;
+     uint32_t m_pageSize;
+     std::map<std::string, uint32_t> m_profile;
+     std::map<std::string, Usage> m_usage;
+};
+
+#endif /* STACK_HELPER_H_ */
@@ -0,0 +1,564 @@
+#include "sv-helper.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <iostream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("SvHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (SvPublisher);
+NS_OBJECT_ENSURE_REGISTERED (SvSubscriber);
+
+// EtherType of sampled values frames
+static const uint16_t SV_ETHERTYPE = 0x88BA;
+// channels of 9-2 LE: IA, IB, IC, IN, VA, VB, VC, VN, each value and quality
+static const uint32_t CHANNELS = 8;
+
+// Function to append a BER length
+static void appendLength(vector<uint8_t>& out, size_t length) {
+     if (length < 0x80) {
+          out.push_back((uint8_t) length);
+     } else if (length < 0x100) {
+          out.push_back(0x81);
+          out.push_back((uint8_t) length);
+     } else {
+          out.push_back(0x82);
+          out.push_back((uint8_t) (length >> 8));
+          out.push_back((uint8_t) length);
+     }
+}
+
+// Function to read a BER length, returns false if it does not fit into the frame
+static bool readLength(uint8_t const*& p, uint8_t const* end, size_t& length) {
+     if (p >= end) {
+          return false;
+     }
+     uint8_t first = *p++;
+     if (first < 0x80) {
+          length = first;
+     } else {
+          uint32_t bytes = first & 0x7f;
+          if (bytes == 0 || bytes > 2 || end - p < (ptrdiff_t) bytes) {
+               return false;
+          }
+          length = 0;
+          for (uint32_t i = 0; i < bytes; ++i) {
+               length = (length << 8) | *p++;
+          }
+     }
+     return end - p >= (ptrdiff_t) length;
+}
+
+static void writeBigEndian(uint8_t* p, uint64_t value, uint32_t bytes) {
+     for (uint32_t i = 0; i < bytes; ++i) {
+          p[bytes - 1 - i] = (uint8_t) (value >> (8 * i));
+     }
+}
+
+static uint64_t readBigEndian(uint8_t const* p, uint32_t bytes) {
+     uint64_t value = 0;
+     for (uint32_t i = 0; i < bytes; ++i) {
+          value = (value << 8) | p[i];
+     }
+     return value;
+}
+
+TypeId SvPublisher::GetTypeId (void) {
+     static TypeId tid = TypeId ("SvPublisher")
+          .SetParent<Application> ()
+          .AddConstructor<SvPublisher> ()
+          .AddAttribute ("AppId", "APPID of the stream",
+                         UintegerValue (0x4000),
+                         MakeUintegerAccessor (&SvPublisher::m_appId),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("SvId", "svID of the stream",
+                         StringValue ("MU01"),
+                         MakeStringAccessor (&SvPublisher::m_svId),
+                         MakeStringChecker ())
+          .AddAttribute ("Transport", "udp (routable SV) or ethernet (EtherType 0x88BA)",
+                         StringValue ("udp"),
+                         MakeStringAccessor (&SvPublisher::m_transport),
+                         MakeStringChecker ())
+          .AddAttribute ("Port", "UDP port of routable SV",
+                         UintegerValue (10107),
+                         MakeUintegerAccessor (&SvPublisher::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("SampleRate", "Samples per second, smpCnt wraps at this value",
+                         UintegerValue (4000),
+                         MakeUintegerAccessor (&SvPublisher::m_sampleRate),
+                         MakeUintegerChecker<uint32_t> (1))
+          .AddAttribute ("Asdus", "Samples (ASDUs) per frame",
+                         UintegerValue (1),
+                         MakeUintegerAccessor (&SvPublisher::m_asdus),
+                         MakeUintegerChecker<uint32_t> (1, 16))
+          .AddAttribute ("Frequency", "Power system frequency in Hz",
+                         UintegerValue (50),
+                         MakeUintegerAccessor (&SvPublisher::m_frequency),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+SvPublisher::SvPublisher() :
+     m_appId(0x4000),
+     m_svId("MU01"),
+     m_transport("udp"),
+     m_port(10107),
+     m_sampleRate(4000),
+     m_asdus(1),
+     m_frequency(50),
+     m_smpCnt(0),
+     m_frames(0) {
+}
+
+// Function to add a subscriber, used by the udp transport
+void SvPublisher::addSubscriber(Ipv4Address address) {
+     m_subscribers.push_back(address);
+}
+
+uint64_t SvPublisher::getFrames() const {
+     return m_frames;
+}
+
+void SvPublisher::DoDispose (void) {
+     m_sockets.clear();
+     Application::DoDispose ();
+}
+
+// Function to encode the frame once and to compute the samples of one cycle
+void SvPublisher::buildTemplate() {
+     // one ASDU, the offsets are relative to its start
+     vector<uint8_t> content;
+     content.push_back(0x80);
+     appendLength(content, m_svId.size());
+     content.insert(content.end(), m_svId.begin(), m_svId.end());
+     content.push_back(0x82);
+     content.push_back(2);
+     uint32_t smpCntOffset = content.size();
+     content.resize(content.size() + 2, 0);
+     content.push_back(0x83);
+     content.push_back(4);
+     content.push_back(0);
+     content.push_back(0);
+     content.push_back(0);
+     content.push_back(1);
+     content.push_back(0x84);
+     content.push_back(8);
+     uint32_t refrTmOffset = content.size();
+     content.resize(content.size() + 8, 0);
+     // smpSynch global
+     content.push_back(0x85);
+     content.push_back(1);
+     content.push_back(2);
+     content.push_back(0x87);
+     appendLength(content, CHANNELS * 8);
+     uint32_t dataOffset = content.size();
+     content.resize(content.size() + CHANNELS * 8, 0);
+
+     vector<uint8_t> asdu;
+     asdu.push_back(0x30);
+     appendLength(asdu, content.size());
+     uint32_t asduHeader = asdu.size();
+     asdu.insert(asdu.end(), content.begin(), content.end());
+
+     vector<uint8_t> sequence;
+     sequence.push_back(0x80);
+     sequence.push_back(1);
+     sequence.push_back((uint8_t) m_asdus);
+     sequence.push_back(0xA2);
+     appendLength(sequence, asdu.size() * m_asdus);
+     uint32_t firstAsdu = sequence.size();
+     for (uint32_t i = 0; i < m_asdus; ++i) {
+          sequence.insert(sequence.end(), asdu.begin(), asdu.end());
+     }
+
+     m_template.clear();
+     m_template.resize(8, 0);
+     m_template.push_back(0x60);
+     appendLength(m_template, sequence.size());
+     uint32_t base = m_template.size() + firstAsdu + asduHeader;
+     m_template.insert(m_template.end(), sequence.begin(), sequence.end());
+     writeBigEndian(&m_template[0], m_appId, 2);
+     writeBigEndian(&m_template[2], m_template.size(), 2);
+
+     m_smpCntOffsets.clear();
+     m_refrTmOffsets.clear();
+     m_dataOffsets.clear();
+     for (uint32_t i = 0; i < m_asdus; ++i) {
+          m_smpCntOffsets.push_back(base + i * asdu.size() + smpCntOffset);
+          m_refrTmOffsets.push_back(base + i * asdu.size() + refrTmOffset);
+          m_dataOffsets.push_back(base + i * asdu.size() + dataOffset);
+     }
+
+     // currents in mA, voltages in 10 mV of a 20 kV system with 1 kA load
+     uint32_t samples = max(m_sampleRate / m_frequency, 1u);
+     m_cycle.resize(samples * CHANNELS);
+     const double current = 1000.0 * sqrt(2.0) * 1000.0;
+     const double voltage = 20000.0 / sqrt(3.0) * sqrt(2.0) * 100.0;
+     for (uint32_t s = 0; s < samples; ++s) {
+          double angle = 2.0 * M_PI * s / samples;
+          for (uint32_t phase = 0; phase < 3; ++phase) {
+               double shifted = angle - phase * 2.0 * M_PI / 3.0;
+               m_cycle[s * CHANNELS + phase] = (int32_t) lround(current * sin(shifted - 0.3));
+               m_cycle[s * CHANNELS + 4 + phase] = (int32_t) lround(voltage * sin(shifted));
+          }
+          m_cycle[s * CHANNELS + 3] = 0;
+          m_cycle[s * CHANNELS + 7] = 0;
+     }
+}
+
+void SvPublisher::StartApplication (void) {
+     Ptr<Node> node = GetNode ();
+     if (m_transport == "ethernet") {
+          // one packet socket per LAN device, sending to the multicast MAC of the AppId
+          char mac[18];
+          snprintf(mac, sizeof(mac), "01:0c:cd:04:%02x:%02x", m_appId >> 8, m_appId & 0xff);
+          for (uint32_t i = 0; i < node->GetNDevices (); ++i) {
+               Ptr<NetDevice> device = node->GetDevice (i);
+               if (device->IsPointToPoint () || ! device->IsBroadcast ()
+                   || device->GetInstanceTypeId ().GetName () == "ns3::LoopbackNetDevice") {
+                    continue;
+               }
+               Ptr<Socket> socket = Socket::CreateSocket (node, PacketSocketFactory::GetTypeId ());
+               PacketSocketAddress local;
+               local.SetSingleDevice (device->GetIfIndex ());
+               local.SetProtocol (SV_ETHERTYPE);
+               socket->Bind (local);
+               PacketSocketAddress remote;
+               remote.SetSingleDevice (device->GetIfIndex ());
+               remote.SetPhysicalAddress (Mac48Address (mac));
+               remote.SetProtocol (SV_ETHERTYPE);
+               socket->Connect (remote);
+               m_sockets.push_back(socket);
+               m_destinations.push_back(remote);
+          }
+          if (m_sockets.empty()) {
+               NS_LOG_WARN ("No LAN device for sampled values on node " << node->GetId ());
+          }
+     } else {
+          Ptr<Socket> socket = Socket::CreateSocket (node, UdpSocketFactory::GetTypeId ());
+          socket->Bind ();
+          for (size_t i = 0; i < m_subscribers.size(); ++i) {
+               m_sockets.push_back(socket);
+               m_destinations.push_back(InetSocketAddress (m_subscribers[i], m_port));
+          }
+     }
+
+     buildTemplate();
+     m_start = Simulator::Now ();
+     m_smpCnt = 0;
+     m_frames = 0;
+     send();
+}
+
+void SvPublisher::StopApplication (void) {
+     m_sendEvent.Cancel ();
+     // the udp transport uses one socket for all destinations
+     for (size_t i = 0; i < m_sockets.size(); ++i) {
+          if (i == 0 || m_sockets[i] != m_sockets[i - 1]) {
+               m_sockets[i]->Close ();
+          }
+     }
+     m_sockets.clear();
+     m_destinations.clear();
+}
+
+// Function to update the template in place and to send it, the next frame is
+// scheduled from the frame count, so the rounding of the interval does not drift
+void SvPublisher::send() {
+     uint64_t sendTime = (uint64_t) Simulator::Now ().GetNanoSeconds ();
+     uint32_t samples = m_cycle.size() / CHANNELS;
+     for (uint32_t i = 0; i < m_asdus; ++i) {
+          uint32_t smpCnt = (m_smpCnt + i) % m_sampleRate;
+          writeBigEndian(&m_template[m_smpCntOffsets[i]], smpCnt, 2);
+          writeBigEndian(&m_template[m_refrTmOffsets[i]], sendTime, 8);
+          int32_t const* values = &m_cycle[(smpCnt % samples) * CHANNELS];
+          uint8_t* data = &m_template[m_dataOffsets[i]];
+          for (uint32_t channel = 0; channel < CHANNELS; ++channel) {
+               writeBigEndian(data + channel * 8, (uint32_t) values[channel], 4);
+          }
+     }
+     m_smpCnt = (m_smpCnt + m_asdus) % m_sampleRate;
+
+     Ptr<Packet> packet = Create<Packet> (&m_template[0], m_template.size());
+     for (size_t i = 0; i < m_sockets.size(); ++i) {
+          m_sockets[i]->SendTo (i + 1 < m_sockets.size() ? packet->Copy () : packet, 0, m_destinations[i]);
+     }
+     ++m_frames;
+
+     Time next = m_start + NanoSeconds ((int64_t) (1e9 * m_asdus * m_frames / m_sampleRate));
+     m_sendEvent = Simulator::Schedule (next - Simulator::Now (), &SvPublisher::send, this);
+}
+
+TypeId SvSubscriber::GetTypeId (void) {
+     static TypeId tid = TypeId ("SvSubscriber")
+          .SetParent<Application> ()
+          .AddConstructor<SvSubscriber> ()
+          .AddAttribute ("Transport", "udp (routable SV) or ethernet (EtherType 0x88BA)",
+                         StringValue ("udp"),
+                         MakeStringAccessor (&SvSubscriber::m_transport),
+                         MakeStringChecker ())
+          .AddAttribute ("Port", "UDP port of routable SV",
+                         UintegerValue (10107),
+                         MakeUintegerAccessor (&SvSubscriber::m_port),
+                         MakeUintegerChecker<uint16_t> ())
+          .AddAttribute ("SampleRate", "Samples per second, smpCnt wraps at this value",
+                         UintegerValue (4000),
+                         MakeUintegerAccessor (&SvSubscriber::m_sampleRate),
+                         MakeUintegerChecker<uint32_t> (1));
+     return tid;
+}
+
+SvSubscriber::SvSubscriber() :
+     m_transport("udp"),
+     m_port(10107),
+     m_sampleRate(4000) {
+}
+
+SvSubscriber::Stream::Stream() :
+     samples(0),
+     lost(0),
+     lastTransit(0),
+     lastSmpCnt(0),
+     jitter(0),
+     maxDeviation(0) {
+}
+
+map<uint16_t, SvSubscriber::Stream> const& SvSubscriber::getStreams() const {
+     return m_streams;
+}
+
+void SvSubscriber::DoDispose (void) {
+     m_socket = 0;
+     Application::DoDispose ();
+}
+
+void SvSubscriber::StartApplication (void) {
+     if (m_transport == "ethernet") {
+          m_socket = Socket::CreateSocket (GetNode (), PacketSocketFactory::GetTypeId ());
+          PacketSocketAddress local;
+          local.SetAllDevices ();
+          local.SetProtocol (SV_ETHERTYPE);
+          NS_ABORT_MSG_IF (m_socket->Bind (local) != 0,
+                           "Cannot bind the sampled values subscriber of node " << GetNode ()->GetId ());
+     } else {
+          m_socket = Socket::CreateSocket (GetNode (), UdpSocketFactory::GetTypeId ());
+          NS_ABORT_MSG_IF (m_socket->Bind (InetSocketAddress (Ipv4Address::GetAny (), m_port)) != 0,
+                           "Cannot bind the sampled values subscriber of node " << GetNode ()->GetId () << " to UDP port " << m_port);
+     }
+     m_socket->SetRecvCallback (MakeCallback (&SvSubscriber::receive, this));
+}
+
+void SvSubscriber::StopApplication (void) {
+     if (m_socket != 0) {
+          m_socket->Close ();
+          m_socket = 0;
+     }
+}
+
+// Function to decode the frames, only the tags of the measured fields are read
+void SvSubscriber::receive(Ptr<Socket> socket) {
+     Ptr<Packet> packet;
+     while ((packet = socket->Recv ())) {
+          int64_t now = Simulator::Now ().GetNanoSeconds ();
+          uint32_t size = packet->GetSize ();
+          if (m_buffer.size() < size) {
+               m_buffer.resize(size);
+          }
+          if (size < 10) {
+               continue;
+          }
+          packet->CopyData (&m_buffer[0], size);
+          uint8_t const* p = &m_buffer[0];
+          uint8_t const* end = p + size;
+          uint16_t appId = (uint16_t) readBigEndian(p, 2);
+          p += 8;
+          size_t length;
+          if (*p++ != 0x60 || !readLength(p, end, length)) {
+               continue;
+          }
+          end = p + length;
+          Stream& stream = m_streams[appId];
+          while (p + 1 < end) {
+               uint8_t tag = *p++;
+               if (!readLength(p, end, length)) {
+                    break;
+               }
+               if (tag != 0xA2) {
+                    p += length;
+                    continue;
+               }
+               // seqASDU
+               uint8_t const* sequenceEnd = p + length;
+               while (p + 1 < sequenceEnd) {
+                    if (*p++ != 0x30 || !readLength(p, sequenceEnd, length)) {
+                         p = sequenceEnd;
+                         break;
+                    }
+                    uint8_t const* asduEnd = p + length;
+                    uint32_t smpCnt = 0;
+                    int64_t sendTime = 0;
+                    while (p + 1 < asduEnd) {
+                         uint8_t field = *p++;
+                         if (!readLength(p, asduEnd, length)) {
+                              break;
+                         }
+                         if (field == 0x80 && stream.svId.empty()) {
+                              stream.svId.assign((char const*) p, length);
+                         } else if (field == 0x82 && length == 2) {
+                              smpCnt = (uint32_t) readBigEndian(p, 2);
+                         } else if (field == 0x84 && length == 8) {
+                              sendTime = (int64_t) readBigEndian(p, 8);
+                         }
+                         p += length;
+                    }
+                    p = asduEnd;
+                    handleAsdu(stream, smpCnt, sendTime, now);
+               }
+          }
+     }
+}
+
+// Function to count the gaps of smpCnt and to update latency and jitter
+void SvSubscriber::handleAsdu(Stream& stream, uint32_t smpCnt, int64_t sendTime, int64_t now) {
+     int64_t transit = now - sendTime;
+     stream.latency.add (NanoSeconds (transit));
+     if (stream.samples > 0) {
+          uint32_t expected = (stream.lastSmpCnt + 1) % m_sampleRate;
+          uint32_t gap = (smpCnt + m_sampleRate - expected) % m_sampleRate;
+          // a large gap is a late or duplicated sample rather than a loss
+          if (gap < m_sampleRate / 2) {
+               stream.lost += gap;
+          }
+          int64_t deviation = llabs(transit - stream.lastTransit);
+          stream.jitter += (deviation - stream.jitter) / 16.0;
+          stream.maxDeviation = max(stream.maxDeviation, deviation);
+     }
+     ++stream.samples;
+     stream.lastSmpCnt = smpCnt;
+     stream.lastTransit = transit;
+}
+
+SvHelper::SvHelper() :
+     m_transport("udp"),
+     m_sampleRate(4000) {
+     m_publisherFactory.SetTypeId (SvPublisher::GetTypeId ());
+}
+
+// Function to set an attribute of the publishers (Asdus, Frequency, Port)
+void SvHelper::setAttribute(string const& name, AttributeValue const& value) {
+     m_publisherFactory.Set (name, value);
+}
+
+void SvHelper::setTransport(string const& transport) {
+     NS_ABORT_MSG_UNLESS (transport == "udp" || transport == "ethernet", "Unknown SV transport " + transport);
+     m_transport = transport;
+}
+
+// Function to set the sample rate of publishers and subscribers
+void SvHelper::setSampleRate(uint32_t sampleRate) {
+     m_sampleRate = sampleRate;
+     m_publisherFactory.Set ("SampleRate", UintegerValue (sampleRate));
+}
+
+// Function to install the subscribers and the streams, stream i gets the AppId 0x4000 + i
+void SvHelper::install(NodeContainer const& publishers, NodeContainer const& subscribers,
+                       uint32_t streams, Time start, Time stop) {
+     if (publishers.GetN () == 0) {
+          NS_LOG_WARN ("No node to publish sampled values");
+          return;
+     }
+     if (m_transport == "ethernet") {
+          PacketSocketHelper packetSocket;
+          packetSocket.Install (NodeContainer (publishers, subscribers));
+     }
+     for (uint32_t i = 0; i < subscribers.GetN (); ++i) {
+          Ptr<SvSubscriber> subscriber = CreateObject<SvSubscriber> ();
+          subscriber->SetAttribute ("Transport", StringValue (m_transport));
+          subscriber->SetAttribute ("SampleRate", UintegerValue (m_sampleRate));
+          subscribers.Get (i)->AddApplication (subscriber);
+          subscriber->SetStartTime (start);
+          subscriber->SetStopTime (stop);
+          m_subscribers.push_back(subscriber);
+     }
+     if (streams == 0) {
+          streams = publishers.GetN ();
+     }
+     for (uint32_t i = 0; i < streams; ++i) {
+          Ptr<Node> node = publishers.Get (i % publishers.GetN ());
+          ostringstream svId;
+          svId << "MU" << node->GetId () << "_" << i;
+          Ptr<SvPublisher> publisher = m_publisherFactory.Create<SvPublisher> ();
+          publisher->SetAttribute ("Transport", StringValue (m_transport));
+          publisher->SetAttribute ("AppId", UintegerValue (0x4000 + i));
+          publisher->SetAttribute ("SvId", StringValue (svId.str()));
+          for (uint32_t j = 0; j < subscribers.GetN (); ++j) {
+               if (subscribers.Get (j) != node) {
+                    publisher->addSubscriber(subscribers.Get (j)->GetObject<Ipv4> ()->GetAddress (1, 0).GetLocal ());
+               }
+          }
+          node->AddApplication (publisher);
+          publisher->SetStartTime (start);
+          publisher->SetStopTime (stop);
+          m_publishers.push_back(publisher);
+     }
+}
+
+// Function to print loss, latency and jitter per stream and subscriber
+void SvHelper::report() {
+     uint64_t frames = 0;
+     for (size_t i = 0; i < m_publishers.size(); ++i) {
+          frames += m_publishers[i]->getFrames();
+     }
+     cout << "Sampled values (" << m_transport << ", " << m_sampleRate << " samples/s): "
+          << m_publishers.size() << " streams, " << frames << " frames sent" << endl;
+     cout << setw(8) << left << "appId" << setw(12) << "svID" << setw(8) << "node" << right
+          << setw(10) << "samples" << setw(8) << "lost" << setw(8) << "loss"
+          << setw(10) << "p50 [us]" << setw(10) << "p99 [us]" << setw(10) << "max [us]"
+          << setw(12) << "jitter [us]" << endl;
+     cout << fixed;
+     for (size_t i = 0; i < m_subscribers.size(); ++i) {
+          map<uint16_t, SvSubscriber::Stream> const& streams = m_subscribers[i]->getStreams();
+          for (map<uint16_t, SvSubscriber::Stream>::const_iterator it = streams.begin(); it != streams.end(); ++it) {
+               SvSubscriber::Stream const& stream = it->second;
+               uint64_t expected = stream.samples + stream.lost;
+               ostringstream appId;
+               appId << "0x" << hex << it->first;
+               cout << setw(8) << left << appId.str() << setw(12) << stream.svId
+                    << setw(8) << m_subscribers[i]->GetNode ()->GetId () << right
+                    << setw(10) << stream.samples << setw(8) << stream.lost << setprecision(2)
+                    << setw(7) << (expected > 0 ? 100.0 * stream.lost / expected : 0) << "%" << setprecision(1)
+                    << setw(10) << stream.latency.getQuantile(0.5).GetNanoSeconds () / 1000.0
+                    << setw(10) << stream.latency.getQuantile(0.99).GetNanoSeconds () / 1000.0
+                    << setw(10) << stream.latency.getMax().GetNanoSeconds () / 1000.0
+                    << setw(12) << stream.jitter / 1000.0 << endl;
+          }
+     }
+     cout.unsetf(ios::fixed);
+     cout << setprecision(6);
+}
+
+// Function to write the latency histograms of all streams as CSV
+bool SvHelper::writeCsv(string const& fileName) {
+     ofstream out(fileName.c_str());
+     if (!out.is_open()) {
+          NS_LOG_WARN ("Cannot write sampled values file " << fileName);
+          return false;
+     }
+     out << "node,app_id,upper_us,count" << endl;
+     for (size_t i = 0; i < m_subscribers.size(); ++i) {
+          map<uint16_t, SvSubscriber::Stream> const& streams = m_subscribers[i]->getStreams();
+          for (map<uint16_t, SvSubscriber::Stream>::const_iterator it = streams.begin(); it != streams.end(); ++it) {
+               ostringstream prefix;
+               prefix << m_subscribers[i]->GetNode ()->GetId () << "," << it->first;
+               it->second.latency.writeCsv(out, prefix.str());
+          }
+     }
+     return true;
+}
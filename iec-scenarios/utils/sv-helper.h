@@ -0,0 +1,124 @@
+#ifndef SV_HELPER_H_
+#define SV_HELPER_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+#include "latency-histogram.h"
+#include <string>
+#include <vector>
+#include <map>
+
+/**
+* Sampled values publisher (IEC 61850-9-2 LE) of one stream. The frame is
+* encoded once into a template, for every frame only smpCnt, refrTm (the
+* send time) and the samples of the ASDUs are overwritten in place. The
+* samples of one power system cycle (4 currents, 4 voltages) are computed
+* at start, so sending costs one copy of the template into the packet.
+*
+* Transport "udp" sends routable SV (IEC 61850-90-5) to every subscriber,
+* transport "ethernet" sends EtherType 0x88BA to the multicast MAC of the
+* AppId on all broadcast capable devices.
+*/
+class SvPublisher : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     SvPublisher();
+     void addSubscriber(ns3::Ipv4Address address);
+     uint64_t getFrames() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void buildTemplate();
+     void send();
+
+     uint16_t m_appId;
+     std::string m_svId;
+     std::string m_transport;
+     uint16_t m_port;
+     uint32_t m_sampleRate;
+     uint32_t m_asdus;
+     uint32_t m_frequency;
+
+     std::vector<ns3::Ptr<ns3::Socket> > m_sockets;
+     std::vector<ns3::Address> m_destinations;
+     std::vector<ns3::Ipv4Address> m_subscribers;
+     std::vector<uint8_t> m_template;
+     std::vector<uint32_t> m_smpCntOffsets;
+     std::vector<uint32_t> m_refrTmOffsets;
+     std::vector<uint32_t> m_dataOffsets;
+     std::vector<int32_t> m_cycle;
+     ns3::Time m_start;
+     uint32_t m_smpCnt;
+     ns3::EventId m_sendEvent;
+     uint64_t m_frames;
+};
+
+/**
+* Sampled values subscriber, measures per stream (APPID) the lost samples
+* (gaps of smpCnt), the latency from refrTm and the interarrival jitter
+* (RFC 3550 estimator and maximum deviation).
+*/
+class SvSubscriber : public ns3::Application {
+public:
+     static ns3::TypeId GetTypeId (void);
+     SvSubscriber();
+
+     struct Stream {
+          Stream();
+          std::string svId;
+          uint64_t samples;
+          uint64_t lost;
+          LatencyHistogram latency;
+          int64_t lastTransit;
+          uint32_t lastSmpCnt;
+          double jitter;
+          int64_t maxDeviation;
+     };
+     std::map<uint16_t, Stream> const& getStreams() const;
+
+protected:
+     virtual void DoDispose (void);
+
+private:
+     virtual void StartApplication (void);
+     virtual void StopApplication (void);
+     void receive(ns3::Ptr<ns3::Socket> socket);
+     void handleAsdu(Stream& stream, uint32_t smpCnt, int64_t sendTime, int64_t now);
+
+     std::string m_transport;
+     uint16_t m_port;
+     uint32_t m_sampleRate;
+     ns3::Ptr<ns3::Socket> m_socket;
+     std::map<uint16_t, Stream> m_streams;
+     std::vector<uint8_t> m_buffer;
+};
+
+/**
+* Distributes the streams round robin over the publishing nodes, every
+* stream is sent to all subscribers.
+*/
+class SvHelper {
+public:
+     SvHelper();
+     void setAttribute(std::string const& name, ns3::AttributeValue const& value);
+     void setTransport(std::string const& transport);
+     void setSampleRate(uint32_t sampleRate);
+     void install(ns3::NodeContainer const& publishers, ns3::NodeContainer const& subscribers,
+                  uint32_t streams, ns3::Time start, ns3::Time stop);
+     void report();
+     bool writeCsv(std::string const& fileName);
+
+private:
+     ns3::ObjectFactory m_publisherFactory;
+     std::string m_transport;
+     uint32_t m_sampleRate;
+     std::vector<ns3::Ptr<SvPublisher> > m_publishers;
+     std::vector<ns3::Ptr<SvSubscriber> > m_subscribers;
+};
+
+#endif /* SV_HELPER_H_ */
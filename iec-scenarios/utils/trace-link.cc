@@ -0,0 +1,163 @@
+#include "trace-link.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+using namespace ns3;
+using namespace std;
+
+NS_LOG_COMPONENT_DEFINE ("TraceLink");
+
+NS_OBJECT_ENSURE_REGISTERED (TraceLinkChannel);
+
+LteTrace::LteTrace() {
+     m_defaults[UL_DELAY] = 20.0;
+     m_defaults[DL_DELAY] = 10.0;
+     m_defaults[UL_RATE] = 5000.0;
+     m_defaults[DL_RATE] = 20000.0;
+     m_defaults[UL_LOSS] = 0.0;
+     m_defaults[DL_LOSS] = 0.0;
+     m_uniform = CreateObject<UniformRandomVariable> ();
+}
+
+char const* LteTrace::getName(Metric metric) {
+     static char const* names[METRICS] = { "ul_delay_ms", "dl_delay_ms", "ul_rate_kbps",
+                                           "dl_rate_kbps", "ul_loss", "dl_loss" };
+     return names[metric];
+}
+
+// Function to read the samples of the section nearest to the cell load, unknown metrics are ignored
+bool LteTrace::load(string const& fileName, double cellLoad) {
+     ifstream in(fileName.c_str());
+     if (!in.is_open()) {
+          NS_LOG_WARN ("Cannot open LTE trace " << fileName);
+          return false;
+     }
+     // samples per section, -1 holds the samples before the first section
+     map<double, vector<double> > sections[METRICS];
+     double section = -1.0;
+     string line;
+     while (getline(in, line)) {
+          if (line.empty() || line[0] == '#') {
+               continue;
+          }
+          istringstream fields(line);
+          string name;
+          double value;
+          if (! (fields >> name >> value)) {
+               continue;
+          }
+          if (name == "load") {
+               section = value;
+               continue;
+          }
+          for (uint32_t i = 0; i < METRICS; ++i) {
+               if (name == getName((Metric) i)) {
+                    sections[i][section].push_back(value);
+               }
+          }
+     }
+     for (uint32_t i = 0; i < METRICS; ++i) {
+          m_samples[i].clear();
+          double nearest = -1.0;
+          for (map<double, vector<double> >::const_iterator it = sections[i].begin(); it != sections[i].end(); ++it) {
+               if (it->first >= 0.0 && (nearest < 0.0 || fabs(it->first - cellLoad) < fabs(nearest - cellLoad))) {
+                    nearest = it->first;
+               }
+          }
+          if (sections[i].count(-1.0)) {
+               m_samples[i] = sections[i][-1.0];
+          }
+          if (nearest >= 0.0) {
+               m_samples[i].insert(m_samples[i].end(), sections[i][nearest].begin(), sections[i][nearest].end());
+               NS_LOG_INFO (getName((Metric) i) << ": " << m_samples[i].size() << " samples at load " << nearest);
+          } else {
+               NS_LOG_INFO (getName((Metric) i) << ": " << m_samples[i].size() << " samples");
+          }
+     }
+     return true;
+}
+
+// Function to draw a value of the empirical distribution, the default without samples
+double LteTrace::sample(Metric metric) const {
+     vector<double> const& samples = m_samples[metric];
+     if (samples.empty()) {
+          return m_defaults[metric];
+     }
+     return samples[m_uniform->GetInteger (0, samples.size() - 1)];
+}
+
+double LteTrace::getUniform() const {
+     return m_uniform->GetValue (0.0, 1.0);
+}
+
+uint32_t LteTrace::getSamples(Metric metric) const {
+     return m_samples[metric].size();
+}
+
+TypeId TraceLinkChannel::GetTypeId (void) {
+     static TypeId tid = TypeId ("TraceLinkChannel")
+          .SetParent<PointToPointChannel> ()
+          .AddConstructor<TraceLinkChannel> ();
+     return tid;
+}
+
+TraceLinkChannel::TraceLinkChannel() {
+     m_loss[0] = 0.0;
+     m_loss[1] = 0.0;
+}
+
+void TraceLinkChannel::setTrace(Ptr<LteTrace> trace, double ulLoss, double dlLoss) {
+     m_trace = trace;
+     m_loss[0] = ulLoss;
+     m_loss[1] = dlLoss;
+}
+
+// Function to deliver a packet after its serialization and a sampled delay, in order per direction
+bool TraceLinkChannel::TransmitStart (Ptr<const Packet> p, Ptr<PointToPointNetDevice> src, Time txTime) {
+     uint32_t direction = src == GetPointToPointDevice (0) ? 0 : 1;
+     Ptr<PointToPointNetDevice> dst = GetPointToPointDevice (1 - direction);
+     if (m_loss[direction] > 0.0 && m_trace->getUniform () < m_loss[direction]) {
+          return true;
+     }
+     double delay = m_trace->sample(direction == 0 ? LteTrace::UL_DELAY : LteTrace::DL_DELAY);
+     Time now = Simulator::Now ();
+     Time arrival = Max (now + txTime + MicroSeconds ((int64_t) (delay * 1000)), m_lastArrival[direction]);
+     m_lastArrival[direction] = arrival;
+     Simulator::ScheduleWithContext (dst->GetNode ()->GetId (), arrival - now,
+                                     &PointToPointNetDevice::Receive, dst, p->Copy ());
+     return true;
+}
+
+TraceLinkHelper::TraceLinkHelper() {
+     m_trace = Create<LteTrace> ();
+     m_queueFactory.SetTypeId ("ns3::DropTailQueue<Packet>");
+}
+
+bool TraceLinkHelper::load(string const& fileName, double cellLoad) {
+     return m_trace->load(fileName, cellLoad);
+}
+
+// Function to connect a UE to the gateway, the UE device is the first one
+NetDeviceContainer TraceLinkHelper::install(Ptr<Node> ue, Ptr<Node> gateway) {
+     Ptr<TraceLinkChannel> channel = CreateObject<TraceLinkChannel> ();
+     channel->setTrace (m_trace, min(m_trace->sample(LteTrace::UL_LOSS), 1.0),
+                        min(m_trace->sample(LteTrace::DL_LOSS), 1.0));
+     double rates[2] = { m_trace->sample(LteTrace::UL_RATE), m_trace->sample(LteTrace::DL_RATE) };
+     Ptr<Node> nodes[2] = { ue, gateway };
+
+     NetDeviceContainer devices;
+     for (uint32_t i = 0; i < 2; ++i) {
+          Ptr<PointToPointNetDevice> device = CreateObject<PointToPointNetDevice> ();
+          device->SetAddress (Mac48Address::Allocate ());
+          device->SetDataRate (DataRate ((uint64_t) (max(rates[i], 1.0) * 1000)));
+          device->SetQueue (m_queueFactory.Create<Queue<Packet> > ());
+          nodes[i]->AddDevice (device);
+          device->Attach (channel);
+          devices.Add (device);
+     }
+     return devices;
+}
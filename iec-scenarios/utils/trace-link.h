@@ -0,0 +1,75 @@
+#ifndef TRACE_LINK_H_
+#define TRACE_LINK_H_
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include <string>
+#include <vector>
+
+/**
+* Empirical distributions of an LTE link, read from a trace file with lines
+* "<metric> <value>", one sample per line. Metrics are ul_delay_ms and
+* dl_delay_ms (one-way delay without the serialization), ul_rate_kbps and
+* dl_rate_kbps (throughput of a UE) and ul_loss and dl_loss (loss
+* probability of a UE). A missing metric uses a default value.
+*
+* A calibrated trace has sections "load <UEs per cell>" with the samples
+* measured at that load; the section nearest to the load of the scenario is
+* used. Samples before the first section apply to every load.
+*/
+class LteTrace : public ns3::SimpleRefCount<LteTrace> {
+public:
+     enum Metric { UL_DELAY, DL_DELAY, UL_RATE, DL_RATE, UL_LOSS, DL_LOSS, METRICS };
+
+     LteTrace();
+     bool load(std::string const& fileName, double cellLoad);
+     double sample(Metric metric) const;
+     double getUniform() const;
+     uint32_t getSamples(Metric metric) const;
+     static char const* getName(Metric metric);
+
+private:
+     std::vector<double> m_samples[METRICS];
+     double m_defaults[METRICS];
+     ns3::Ptr<ns3::UniformRandomVariable> m_uniform;
+};
+
+/**
+* P2P channel between a UE (device 0) and the gateway (device 1) whose
+* delay is sampled per packet from the trace and which drops packets with
+* the loss probability of the UE. The packets of a direction stay in order,
+* like behind RLC AM.
+*/
+class TraceLinkChannel : public ns3::PointToPointChannel {
+public:
+     static ns3::TypeId GetTypeId (void);
+     TraceLinkChannel();
+     void setTrace(ns3::Ptr<LteTrace> trace, double ulLoss, double dlLoss);
+     virtual bool TransmitStart (ns3::Ptr<const ns3::Packet> p, ns3::Ptr<ns3::PointToPointNetDevice> src,
+                                 ns3::Time txTime);
+
+private:
+     ns3::Ptr<LteTrace> m_trace;
+     double m_loss[2];
+     ns3::Time m_lastArrival[2];
+};
+
+/**
+* Connects UEs to a gateway node with trace driven links instead of the LTE
+* radio and the EPC. Every UE gets its own uplink and downlink rate and
+* loss probability from the trace, the gateway side sends with the
+* downlink rate.
+*/
+class TraceLinkHelper {
+public:
+     TraceLinkHelper();
+     bool load(std::string const& fileName, double cellLoad);
+     ns3::NetDeviceContainer install(ns3::Ptr<ns3::Node> ue, ns3::Ptr<ns3::Node> gateway);
+
+private:
+     ns3::Ptr<LteTrace> m_trace;
+     ns3::ObjectFactory m_queueFactory;
+};
+
+#endif /* TRACE_LINK_H_ */